@@ -0,0 +1,282 @@
+#ifndef _CellularAutomataCheckpoint_H_
+#define _CellularAutomataCheckpoint_H_
+
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+
+#include <QtCore/QString>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+#include <QtCore/QCryptographicHash>
+
+namespace CellularAutomata
+{
+	//everything besides the cell arrays needed to continue a simulation exactly where it left off
+	struct SimulationState
+	{
+		SimulationState() : seed(0), iteration(0), timeStep(1), grainCount(0) {}
+
+		uint64_t seed;//random streams are derived from (seed, iteration, block)
+		uint64_t iteration;//number of steps taken (including those before the first nucleation)
+		uint32_t timeStep;//time step recorded for newly recrystallized cells
+		int32_t grainCount;
+		std::vector<float> history;
+
+		//observables of every state in history (not checkpointed, they are rebuilt from the recrystallization times)
+		std::vector<uint64_t> interfaceFaces;//unrecrystallized / recrystallized faces normal to x, y and z
+		std::vector<int32_t> grainCounts;
+	};
+
+	//bump whenever a change to the simulation alters the result of a given set of parameters + seed (invalidates cached results and checkpoints)
+	static const uint32_t EngineVersion = 4;
+
+	/*
+	 * Checkpoint file layout (native byte order): header, history (float x historyLength), padding to a multiple of 8 bytes,
+	 * grain ids (int32 x cells), recrystallization times (uint32 x cells). The arrays are stored raw so the file can be memory mapped.
+	 */
+	struct CheckpointHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t neighborhood;
+		uint64_t dims[3];
+		float nucleationProbability;
+		uint32_t timeStep;
+		uint64_t seed;
+		uint64_t iteration;
+		int64_t grainCount;
+		uint64_t historyLength;
+		uint32_t engineVersion;
+		uint32_t reserved;
+		uint64_t inputs;//hash of the mask and nucleation weights (0 for a uniform simulation of every cell)
+	};
+
+	static const char CheckpointMagic[8] = {'C', 'A', 'R', 'X', 'C', 'K', 'P', 'T'};
+	static const uint32_t CheckpointVersion = 2;
+
+	//everything a checkpoint has to have been written with to be resumed by a simulation
+	struct CheckpointKey
+	{
+		CheckpointKey(const size_t latticeDims[3], int nb, float pNuc) : neighborhood(nb), nucleationProbability(pNuc), fixedSeed(false), seed(0), inputs(0)
+		{
+			dims[0] = latticeDims[0];
+			dims[1] = latticeDims[1];
+			dims[2] = latticeDims[2];
+		}
+
+		size_t dims[3];
+		int neighborhood;
+		float nucleationProbability;
+		bool fixedSeed;//false takes the seed of the checkpoint (a clock seeded run)
+		uint64_t seed;
+		uint64_t inputs;//CheckpointInputs
+	};
+
+	//hash of the per cell inputs that shape a simulation (either may be NULL), 0 if there are none
+	inline uint64_t CheckpointInputs(const bool* mask, const float* weights, size_t numCells)
+	{
+		if(NULL == mask && NULL == weights)
+			return 0;
+		QCryptographicHash hash(QCryptographicHash::Sha1);
+		const char tags[2] = {NULL != mask ? 'M' : '-', NULL != weights ? 'W' : '-'};
+		hash.addData(tags, 2);
+		if(NULL != mask)
+		{
+			std::vector<char> bytes(mask, mask + numCells);
+			hash.addData(bytes.data(), static_cast<int>(numCells));
+		}
+		if(NULL != weights)
+			hash.addData(reinterpret_cast<const char*>(weights), static_cast<int>(numCells * sizeof(float)));
+		uint64_t inputs = 0;
+		memcpy(&inputs, hash.result().constData(), sizeof(inputs));
+		return 0 == inputs ? 1 : inputs;
+	}
+
+	inline size_t CheckpointPadding(size_t historyLength)
+	{
+		return (8 - (historyLength * sizeof(float)) % 8) % 8;
+	}
+
+	//header for a lattice + parameters (the state fields are filled in when writing)
+	inline CheckpointHeader MakeCheckpointHeader(const CheckpointKey& key)
+	{
+		CheckpointHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, CheckpointMagic, sizeof(CheckpointMagic));
+		header.version = CheckpointVersion;
+		header.neighborhood = key.neighborhood;
+		header.dims[0] = key.dims[0];
+		header.dims[1] = key.dims[1];
+		header.dims[2] = key.dims[2];
+		header.nucleationProbability = key.nucleationProbability;
+		header.seed = key.seed;
+		header.engineVersion = EngineVersion;
+		header.inputs = key.inputs;
+		return header;
+	}
+
+	//checks that a header read from path belongs to a checkpoint with the same key, returns an error message (empty if it does)
+	inline QString CheckCheckpointHeader(const CheckpointHeader& header, const QString& path, const CheckpointKey& key)
+	{
+		if(0 != memcmp(header.magic, CheckpointMagic, sizeof(CheckpointMagic)))
+			return QString("'%1' is not a checkpoint file").arg(path);
+		if(CheckpointVersion != header.version)
+			return QString("Checkpoint file '%1' has unsupported version %2").arg(path).arg(header.version);
+		if(EngineVersion != header.engineVersion)
+			return QString("Checkpoint file '%1' was written by version %2 of the simulation engine (this is version %3)").arg(path).arg(header.engineVersion).arg(EngineVersion);
+		if(header.dims[0] != key.dims[0] || header.dims[1] != key.dims[1] || header.dims[2] != key.dims[2])
+			return QString("Checkpoint file '%1' was written for a %2 x %3 x %4 lattice").arg(path).arg(header.dims[0]).arg(header.dims[1]).arg(header.dims[2]);
+		if(static_cast<int>(header.neighborhood) != key.neighborhood || header.nucleationProbability != key.nucleationProbability)
+			return QString("Checkpoint file '%1' was written with a different neighborhood or nucleation rate").arg(path);
+		if(key.fixedSeed && header.seed != key.seed)
+			return QString("Checkpoint file '%1' was written with random seed %2").arg(path).arg(header.seed);
+		if(header.inputs != key.inputs)
+			return QString("Checkpoint file '%1' was written with a different mask or nucleation weights").arg(path);
+		return QString();
+	}
+
+	//reads a checkpoint written with the same key, returns an error message (empty on success)
+	inline QString ReadCheckpoint(const QString& path, const CheckpointKey& key, SimulationState& state, int32_t* ids, uint32_t* times)
+	{
+		QFile file(path);
+		if(!file.open(QIODevice::ReadOnly))
+			return QString("Unable to open checkpoint file '%1'").arg(path);
+
+		CheckpointHeader header;
+		if(sizeof(header) != file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+			return QString("'%1' is not a checkpoint file").arg(path);
+		QString error = CheckCheckpointHeader(header, path, key);
+		if(!error.isEmpty())
+			return error;
+
+		qint64 numCells = static_cast<qint64>(key.dims[0] * key.dims[1] * key.dims[2]);
+		state.seed = header.seed;
+		state.iteration = header.iteration;
+		state.timeStep = header.timeStep;
+		state.grainCount = static_cast<int32_t>(header.grainCount);
+		state.history.resize(header.historyLength);
+		char padding[8];
+		qint64 historyBytes = static_cast<qint64>(header.historyLength * sizeof(float));
+		qint64 paddingBytes = static_cast<qint64>(CheckpointPadding(header.historyLength));
+		if(historyBytes != file.read(reinterpret_cast<char*>(state.history.data()), historyBytes)
+		   || paddingBytes != file.read(padding, paddingBytes))
+			return QString("Checkpoint file '%1' is truncated").arg(path);
+
+		//map the cell arrays instead of reading them through the file buffer when possible
+		qint64 cellOffset = file.pos();
+		if(file.size() < cellOffset + numCells * 8)
+			return QString("Checkpoint file '%1' is truncated").arg(path);
+		uchar* cells = file.map(cellOffset, numCells * 8);
+		if(NULL != cells)
+		{
+			memcpy(ids, cells, numCells * 4);
+			memcpy(times, cells + numCells * 4, numCells * 4);
+			file.unmap(cells);
+		}
+		else if(numCells * 4 != file.read(reinterpret_cast<char*>(ids), numCells * 4)
+		        || numCells * 4 != file.read(reinterpret_cast<char*>(times), numCells * 4))
+			return QString("Checkpoint file '%1' is truncated").arg(path);
+		return QString();
+	}
+
+	//writes checkpoints on a background thread from a private snapshot of the state, so the step loop only pays for a copy
+	class CheckpointWriter : public QThread
+	{
+		QString m_path;
+		CheckpointHeader m_header;
+		std::vector<float> m_history;
+		std::vector<int32_t> m_ids;
+		std::vector<uint32_t> m_times;
+		const int32_t* m_sharedIds;//arrays of writeShared (NULL while writing a snapshot)
+		const uint32_t* m_sharedTimes;
+		bool m_ok;
+
+	public:
+		CheckpointWriter(const QString& path, const CheckpointKey& key) :
+			m_path(path),
+			m_header(MakeCheckpointHeader(key)),
+			m_sharedIds(NULL),
+			m_sharedTimes(NULL),
+			m_ok(true)
+		{}
+
+		virtual ~CheckpointWriter()
+		{
+			wait();
+		}
+
+		//snapshot the state and start writing it (waits for the previous checkpoint to finish first)
+		void write(const SimulationState& state, const int32_t* ids, const uint32_t* times)
+		{
+			size_t numCells = m_header.dims[0] * m_header.dims[1] * m_header.dims[2];
+			begin(state);
+			m_ids.assign(ids, ids + numCells);
+			m_times.assign(times, times + numCells);
+			start();
+		}
+
+		//starts writing the state straight from ids and times without a snapshot, they must not change until succeeded() returns
+		void writeShared(const SimulationState& state, const int32_t* ids, const uint32_t* times)
+		{
+			begin(state);
+			std::vector<int32_t>().swap(m_ids);
+			std::vector<uint32_t>().swap(m_times);
+			m_sharedIds = ids;
+			m_sharedTimes = times;
+			start();
+		}
+
+		//true if every checkpoint written so far succeeded (waits for the current write)
+		bool succeeded()
+		{
+			wait();
+			return m_ok;
+		}
+
+		QString getPath() const
+		{
+			return m_path;
+		}
+
+	protected:
+		//waits for the previous checkpoint and takes the header + history of the next one
+		void begin(const SimulationState& state)
+		{
+			wait();
+			m_header.timeStep = state.timeStep;
+			m_header.seed = state.seed;
+			m_header.iteration = state.iteration;
+			m_header.grainCount = state.grainCount;
+			m_header.historyLength = state.history.size();
+			m_history = state.history;
+			m_sharedIds = NULL;
+			m_sharedTimes = NULL;
+		}
+
+		virtual void run()
+		{
+			//QSaveFile only replaces the previous checkpoint once the new one is completely written
+			QSaveFile file(m_path);
+			const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+			qint64 historyBytes = static_cast<qint64>(m_history.size() * sizeof(float));
+			qint64 paddingBytes = static_cast<qint64>(CheckpointPadding(m_history.size()));
+			size_t numCells = m_header.dims[0] * m_header.dims[1] * m_header.dims[2];
+			const int32_t* ids = NULL != m_sharedIds ? m_sharedIds : m_ids.data();
+			const uint32_t* times = NULL != m_sharedTimes ? m_sharedTimes : m_times.data();
+			qint64 cellBytes = static_cast<qint64>(numCells * 4);
+			bool ok = file.open(QIODevice::WriteOnly)
+			          && sizeof(m_header) == file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header))
+			          && historyBytes == file.write(reinterpret_cast<const char*>(m_history.data()), historyBytes)
+			          && paddingBytes == file.write(padding, paddingBytes)
+			          && cellBytes == file.write(reinterpret_cast<const char*>(ids), cellBytes)
+			          && cellBytes == file.write(reinterpret_cast<const char*>(times), cellBytes)
+			          && file.commit();
+			if(!ok)
+				m_ok = false;
+		}
+	};
+}
+
+#endif
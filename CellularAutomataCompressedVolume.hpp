@@ -0,0 +1,309 @@
+#ifndef _CellularAutomataCompressedVolume_H_
+#define _CellularAutomataCompressedVolume_H_
+
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include <QtCore/QString>
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+
+#include "CellularAutomataFrames.hpp"
+
+namespace CellularAutomata
+{
+	/*
+	 * Compressed volume file layout (native byte order): CompressedVolumeHeader, the slabs and the slab index (offset +
+	 * compressed size of every slab) at the end. A slab is slabRows consecutive x rows (the last may have fewer) stored as
+	 * a zlib (qCompress) block: the grain ids of every row run length encoded as pairs of varints (run length, id),
+	 * followed by the recrystallization times of every row as zigzag varints of their difference to TimePrediction.
+	 * Grains are contiguous and times grow steadily away from each nucleus, so both streams are mostly short repeats.
+	 * Slabs are independent: they are compressed in parallel and any of them can be read on its own.
+	 */
+	struct CompressedVolumeHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t reserved;
+		uint64_t dims[3];
+		uint64_t slabRows;
+		uint64_t slabs;
+	};
+
+	struct CompressedSlab
+	{
+		uint64_t offset;//from the start of the file
+		uint64_t compressedBytes;
+	};
+
+	static const char CompressedVolumeMagic[8] = {'C', 'A', 'R', 'X', 'V', 'O', 'L', 'M'};
+	static const uint32_t CompressedVolumeVersion = 1;
+
+	//rows of a slab of about a million cells
+	inline size_t DefaultSlabRows(size_t xDim)
+	{
+		return std::max(static_cast<size_t>(1), (static_cast<size_t>(1) << 20) / std::max(xDim, static_cast<size_t>(1)));
+	}
+
+	inline uint64_t ZigZag(int64_t value)
+	{
+		return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+	}
+
+	inline int64_t UnZigZag(uint64_t value)
+	{
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+	//predicts the time of cell x of a row from the cells before it and the previous row of the slab (NULL for the first):
+	//the left neighbor plus the change between the cells above, which holds wherever time is planar in x and y
+	inline int64_t TimePrediction(const uint32_t* row, const uint32_t* above, size_t x)
+	{
+		if(NULL == above)
+			return 0 == x ? 0 : static_cast<int64_t>(row[x - 1]);
+		if(0 == x)
+			return above[0];
+		return static_cast<int64_t>(row[x - 1]) + above[x] - above[x - 1];
+	}
+
+	//encodes + compresses rows [firstRow, lastRow) of a volume with x rows of xDim cells
+	inline QByteArray EncodeSlab(size_t xDim, size_t firstRow, size_t lastRow, const int32_t* ids, const uint32_t* times)
+	{
+		QByteArray raw;
+		raw.reserve(static_cast<int>((lastRow - firstRow) * xDim * 2));
+		for(size_t row = firstRow; row < lastRow; row++)
+		{
+			const int32_t* rowIds = ids + row * xDim;
+			size_t start = 0;
+			for(size_t x = 1; x <= xDim; x++)
+			{
+				if(x < xDim && rowIds[x] == rowIds[start])
+					continue;
+				AppendVarint(raw, x - start);
+				AppendVarint(raw, static_cast<uint32_t>(rowIds[start]));
+				start = x;
+			}
+		}
+		for(size_t row = firstRow; row < lastRow; row++)
+		{
+			const uint32_t* rowTimes = times + row * xDim;
+			const uint32_t* above = row > firstRow ? rowTimes - xDim : NULL;
+			for(size_t x = 0; x < xDim; x++)
+				AppendVarint(raw, ZigZag(static_cast<int64_t>(rowTimes[x]) - TimePrediction(rowTimes, above, x)));
+		}
+		return qCompress(raw);
+	}
+
+	//decompresses a slab of rows x rows into ids + times, returns false on corrupt data
+	inline bool DecodeSlab(const QByteArray& compressed, size_t xDim, size_t rows, int32_t* ids, uint32_t* times)
+	{
+		QByteArray raw = qUncompress(compressed);
+		const char* pos = raw.constData();
+		const char* end = pos + raw.size();
+		uint64_t length, value;
+		for(size_t row = 0; row < rows; row++)
+		{
+			int32_t* rowIds = ids + row * xDim;
+			for(size_t x = 0; x < xDim; x += static_cast<size_t>(length))
+			{
+				if(!ReadVarint(pos, end, length) || !ReadVarint(pos, end, value) || 0 == length || length > xDim - x)
+					return false;
+				std::fill(rowIds + x, rowIds + x + length, static_cast<int32_t>(value));
+			}
+		}
+		for(size_t row = 0; row < rows; row++)
+		{
+			uint32_t* rowTimes = times + row * xDim;
+			const uint32_t* above = row > 0 ? rowTimes - xDim : NULL;
+			for(size_t x = 0; x < xDim; x++)
+			{
+				if(!ReadVarint(pos, end, value))
+					return false;
+				rowTimes[x] = static_cast<uint32_t>(TimePrediction(rowTimes, above, x) + UnZigZag(value));
+			}
+		}
+		return pos == end;
+	}
+
+	//compresses a range of slabs into slabs[s - firstSlab]
+	class SlabEncoder
+	{
+		size_t m_xDim;
+		size_t m_rows;
+		size_t m_slabRows;
+		size_t m_firstSlab;
+		const int32_t* m_ids;
+		const uint32_t* m_times;
+		QByteArray* m_slabs;
+
+	public:
+		SlabEncoder(size_t xDim, size_t rows, size_t slabRows, size_t firstSlab, const int32_t* ids, const uint32_t* times, QByteArray* slabs) :
+			m_xDim(xDim),
+			m_rows(rows),
+			m_slabRows(slabRows),
+			m_firstSlab(firstSlab),
+			m_ids(ids),
+			m_times(times),
+			m_slabs(slabs)
+		{}
+
+		void compute(size_t start, size_t end) const
+		{
+			for(size_t s = start; s < end; s++)
+				m_slabs[s - m_firstSlab] = EncodeSlab(m_xDim, s * m_slabRows, std::min((s + 1) * m_slabRows, m_rows), m_ids, m_times);
+		}
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+		void operator()(const tbb::blocked_range<size_t>& r) const
+		{
+			compute(r.begin(), r.end());
+		}
+#endif
+	};
+
+	//writes the grain ids + recrystallization times of a volume in slabs of slabRows x rows (0 picks about a million
+	//cells), a batch of slabs at a time compressed in parallel; returns an error message (empty on success) and the size of the file in bytes
+	inline QString WriteCompressedVolume(const QString& path, const size_t dims[3], const int32_t* ids, const uint32_t* times, size_t slabRows, bool parallel, uint64_t& bytes)
+	{
+		//slabs compressed at once (bounds the compressed data held in memory)
+		static const size_t BatchSlabs = 64;
+
+		size_t rows = dims[1] * dims[2];
+		if(0 == slabRows)
+			slabRows = DefaultSlabRows(dims[0]);
+		CompressedVolumeHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, CompressedVolumeMagic, sizeof(CompressedVolumeMagic));
+		header.version = CompressedVolumeVersion;
+		for(size_t i = 0; i < 3; i++)
+			header.dims[i] = dims[i];
+		header.slabRows = slabRows;
+		header.slabs = (rows + slabRows - 1) / slabRows;
+
+		//QSaveFile only replaces an existing file once the new one is completely written
+		QSaveFile file(path);
+		if(!file.open(QIODevice::WriteOnly) || sizeof(header) != file.write(reinterpret_cast<const char*>(&header), sizeof(header)))
+			return QString("Unable to write compressed volume file '%1'").arg(path);
+		std::vector<CompressedSlab> index(header.slabs);
+		std::vector<QByteArray> batch(BatchSlabs);
+		bytes = sizeof(header);
+		for(size_t first = 0; first < header.slabs; first += BatchSlabs)
+		{
+			size_t last = std::min(first + BatchSlabs, static_cast<size_t>(header.slabs));
+			SlabEncoder encoder(dims[0], rows, slabRows, first, ids, times, &batch[0]);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+			if(parallel)
+				tbb::parallel_for(tbb::blocked_range<size_t>(first, last, 1), encoder, tbb::auto_partitioner());
+			else
+#else
+			Q_UNUSED(parallel);
+#endif
+				encoder.compute(first, last);
+			for(size_t s = first; s < last; s++)
+			{
+				const QByteArray& slab = batch[s - first];
+				index[s].offset = bytes;
+				index[s].compressedBytes = slab.size();
+				if(slab.size() != file.write(slab.constData(), slab.size()))
+					return QString("Unable to write compressed volume file '%1'").arg(path);
+				bytes += slab.size();
+			}
+		}
+		qint64 indexBytes = static_cast<qint64>(index.size() * sizeof(CompressedSlab));
+		if(indexBytes != file.write(reinterpret_cast<const char*>(index.data()), indexBytes) || !file.commit())
+			return QString("Unable to write compressed volume file '%1'").arg(path);
+		bytes += indexBytes;
+		return QString();
+	}
+
+	//reads a compressed volume slab by slab, only the slabs asked for are decompressed
+	class CompressedVolumeReader
+	{
+		QFile m_file;
+		CompressedVolumeHeader m_header;
+		std::vector<CompressedSlab> m_index;
+
+	public:
+		CompressedVolumeReader(const QString& path) :
+			m_file(path)
+		{
+			memset(&m_header, 0, sizeof(m_header));
+		}
+
+		//reads the header + slab index, returns an error message (empty on success)
+		QString open()
+		{
+			if(!m_file.open(QIODevice::ReadOnly))
+				return QString("Unable to open compressed volume file '%1'").arg(m_file.fileName());
+			if(sizeof(m_header) != m_file.read(reinterpret_cast<char*>(&m_header), sizeof(m_header)) || 0 != memcmp(m_header.magic, CompressedVolumeMagic, sizeof(CompressedVolumeMagic)))
+				return QString("'%1' is not a compressed volume file").arg(m_file.fileName());
+			if(CompressedVolumeVersion != m_header.version)
+				return QString("Compressed volume file '%1' has unsupported version %2").arg(m_file.fileName()).arg(m_header.version);
+			uint64_t rows = m_header.dims[1] * m_header.dims[2];
+			qint64 indexBytes = static_cast<qint64>(m_header.slabs * sizeof(CompressedSlab));
+			if(0 == m_header.slabRows || m_header.slabs != (rows + m_header.slabRows - 1) / m_header.slabRows || m_file.size() < static_cast<qint64>(sizeof(m_header)) + indexBytes)
+				return QString("Compressed volume file '%1' is truncated").arg(m_file.fileName());
+			m_index.resize(m_header.slabs);
+			if(!m_file.seek(m_file.size() - indexBytes) || indexBytes != m_file.read(reinterpret_cast<char*>(m_index.data()), indexBytes))
+				return QString("Compressed volume file '%1' is truncated").arg(m_file.fileName());
+			return QString();
+		}
+
+		const uint64_t* dims() const
+		{
+			return m_header.dims;
+		}
+
+		size_t slabs() const
+		{
+			return m_index.size();
+		}
+
+		//index of the first cell of a slab
+		size_t firstCell(size_t slab) const
+		{
+			return static_cast<size_t>(slab * m_header.slabRows * m_header.dims[0]);
+		}
+
+		size_t slabCells(size_t slab) const
+		{
+			size_t rows = static_cast<size_t>(m_header.dims[1] * m_header.dims[2]);
+			size_t first = static_cast<size_t>(slab * m_header.slabRows);
+			return (std::min(first + static_cast<size_t>(m_header.slabRows), rows) - first) * static_cast<size_t>(m_header.dims[0]);
+		}
+
+		//decompresses a slab into ids + times (slabCells(slab) each), returns false on corrupt data
+		bool readSlab(size_t slab, int32_t* ids, uint32_t* times)
+		{
+			if(slab >= m_index.size() || !m_file.seek(static_cast<qint64>(m_index[slab].offset)))
+				return false;
+			QByteArray compressed = m_file.read(static_cast<qint64>(m_index[slab].compressedBytes));
+			if(static_cast<uint64_t>(compressed.size()) != m_index[slab].compressedBytes)
+				return false;
+			size_t xDim = static_cast<size_t>(m_header.dims[0]);
+			return DecodeSlab(compressed, xDim, slabCells(slab) / xDim, ids, times);
+		}
+
+		//decompresses every slab into ids + times of the whole volume
+		bool read(int32_t* ids, uint32_t* times)
+		{
+			for(size_t s = 0; s < m_index.size(); s++)
+			{
+				if(!readSlab(s, ids + firstCell(s), times + firstCell(s)))
+					return false;
+			}
+			return true;
+		}
+	};
+}
+
+#endif
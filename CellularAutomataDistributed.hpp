@@ -0,0 +1,341 @@
+#ifndef _CellularAutomataDistributed_H_
+#define _CellularAutomataDistributed_H_
+
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+
+#include "CellularAutomataHelpers.hpp"
+#include "CellularAutomataRandom.hpp"
+
+namespace CellularAutomata
+{
+	//planes a subdomain needs beyond its own cells on each side (neighbors reach 1 plane, the nucleation suppression window 2)
+	static const size_t HaloPlanes = 2;
+
+	//cells [begin, end) of one z plane that process `from` owns and process `to` keeps in its halo
+	struct HaloTransfer
+	{
+		size_t from;
+		size_t to;
+		size_t begin;
+		size_t end;
+	};
+
+	/*
+	 * Splits a lattice over processes into contiguous ranges of cells (z slabs that may start or end part way through a
+	 * plane) made of whole random number blocks, so every cell draws from the same stream as in a single process and the
+	 * result doesn't depend on the number of processes. Each process stores a window of whole planes: the planes its
+	 * cells touch plus HaloPlanes on each side (wrapping around z), or the whole lattice if that is smaller.
+	 */
+	class SlabPartition
+	{
+		Lattice m_lattice;
+		std::vector<size_t> m_begin;//first cell of each process (+ the number of cells)
+
+	public:
+		SlabPartition(const Lattice& lattice, size_t processes) :
+			m_lattice(lattice)
+		{
+			size_t numBlocks = (lattice.size() + RandomBlockSize - 1) / RandomBlockSize;
+			m_begin.resize(processes + 1);
+			for(size_t p = 0; p <= processes; p++)
+				m_begin[p] = std::min(lattice.size(), (numBlocks * p / processes) * RandomBlockSize);
+		}
+
+		const Lattice& lattice() const
+		{
+			return m_lattice;
+		}
+
+		size_t processes() const
+		{
+			return m_begin.size() - 1;
+		}
+
+		size_t begin(size_t process) const
+		{
+			return m_begin[process];
+		}
+
+		size_t end(size_t process) const
+		{
+			return m_begin[process + 1];
+		}
+
+		size_t owner(size_t index) const
+		{
+			return std::upper_bound(m_begin.begin(), m_begin.end(), index) - m_begin.begin() - 1;
+		}
+
+		//first plane (lattice z) and number of planes of a process's window (no planes if it owns no cells)
+		void window(size_t process, size_t& firstPlane, size_t& planeCount) const
+		{
+			size_t planeSize = m_lattice.dimension(0) * m_lattice.dimension(1);
+			size_t dimZ = m_lattice.dimension(2);
+			firstPlane = 0;
+			planeCount = 0;
+			if(begin(process) == end(process))
+				return;
+			size_t first = begin(process) / planeSize;
+			size_t last = (end(process) - 1) / planeSize;
+			planeCount = last - first + 1 + 2 * HaloPlanes;
+			if(planeCount >= dimZ)
+				planeCount = dimZ;
+			else
+				firstPlane = (first + dimZ - HaloPlanes) % dimZ;
+		}
+
+		//every halo transfer of a step, in the same order on every process (messages between a pair of processes are matched in order)
+		std::vector<HaloTransfer> transfers() const
+		{
+			std::vector<HaloTransfer> transfers;
+			size_t planeSize = m_lattice.dimension(0) * m_lattice.dimension(1);
+			for(size_t to = 0; to < processes(); to++)
+			{
+				size_t firstPlane, planeCount;
+				window(to, firstPlane, planeCount);
+				for(size_t k = 0; k < planeCount; k++)
+				{
+					size_t planeStart = ((firstPlane + k) % m_lattice.dimension(2)) * planeSize;
+					size_t planeEnd = planeStart + planeSize;
+					for(size_t from = owner(planeStart); from < processes() && begin(from) < planeEnd; from++)
+					{
+						HaloTransfer transfer;
+						transfer.from = from;
+						transfer.to = to;
+						transfer.begin = std::max(planeStart, begin(from));
+						transfer.end = std::min(planeEnd, end(from));
+						if(from != to && transfer.begin < transfer.end)
+							transfers.push_back(transfer);
+					}
+				}
+			}
+			return transfers;
+		}
+	};
+
+	/*
+	 * The cells of one process of a SlabPartition: grain ids of its window (own cells + halo) and recrystallization times of
+	 * its own cells. step() advances the own cells with the rules and random draws of RecrystalizeVolume's 3D kernel for
+	 * the 3D neighborhoods (Von Neumann to Moore, 0 - 5), so a distributed run reproduces a single process run exactly.
+	 * Interface area and feature statistics aren't tracked.
+	 */
+	class Slab
+	{
+		const SlabPartition& m_partition;
+		size_t m_process;
+		int m_neighborhood;
+		size_t m_begin;
+		size_t m_end;
+		size_t m_firstPlane;
+		Lattice m_window;
+		size_t m_offset;//window index of the first own cell
+		std::vector<int32_t> m_ids;
+		std::vector<int32_t> m_working;
+		std::vector<uint32_t> m_times;
+		std::vector<size_t> m_nuclei;//own cells (relative to begin) that nucleated during the last step
+
+		//neighbors of a window cell, returns the number of neighbors (variant neighborhoods draw their variant)
+		size_t neighbors(size_t index, VariateStream& generator, size_t* neighbors) const
+		{
+			size_t moore[26];
+			switch(m_neighborhood)
+			{
+				case 0:
+					m_window.Neighbors(index, 6, neighbors);
+					return 6;
+
+				case 1:
+				{
+					const size_t* edges = EightCellEdges[generator.below(6)];
+					m_window.Neighbors(index, 18, moore);
+					std::copy(moore, moore + 6, neighbors);
+					neighbors[6] = moore[edges[0]];
+					neighbors[7] = moore[edges[1]];
+					return 8;
+				}
+
+				case 2:
+				{
+					const size_t* corners = FourteenCellCorners[generator.below(4)];
+					m_window.Neighbors(index, 26, moore);
+					std::copy(moore, moore + 6, neighbors);
+					for(size_t n = 0; n < 8; n++)
+						neighbors[6 + n] = moore[corners[n]];
+					return 14;
+				}
+
+				case 3:
+					m_window.Neighbors(index, 18, neighbors);
+					return 18;
+
+				case 4:
+				{
+					const size_t* corners = TwentyCellCorners[generator.below(4)];
+					m_window.Neighbors(index, 26, moore);
+					std::copy(moore, moore + 18, neighbors);
+					neighbors[18] = moore[corners[0]];
+					neighbors[19] = moore[corners[1]];
+					return 20;
+				}
+
+				default:
+					m_window.Neighbors(index, 26, neighbors);
+					return 26;
+			}
+		}
+
+		//true if a cell in the 5 x 5 x 5 window around a window cell is recrystallized
+		bool suppressed(size_t index) const
+		{
+			std::vector<size_t> extended = m_window.ExtendedMoore(index);
+			for(std::vector<size_t>::const_iterator iter = extended.begin(); iter != extended.end(); ++iter)
+			{
+				if(0 != m_ids[*iter])
+					return true;
+			}
+			return false;
+		}
+
+	public:
+		Slab(const SlabPartition& partition, size_t process, int neighborhood) :
+			m_partition(partition),
+			m_process(process),
+			m_neighborhood(neighborhood),
+			m_begin(partition.begin(process)),
+			m_end(partition.end(process)),
+			m_firstPlane(0),
+			m_window(1, 1, 1),
+			m_offset(0)
+		{
+			const Lattice& lattice = partition.lattice();
+			size_t planeCount;
+			partition.window(process, m_firstPlane, planeCount);
+			m_window = Lattice(lattice.dimension(0), lattice.dimension(1), planeCount);
+			if(0 != planeCount)
+				m_offset = windowIndex(m_begin);
+			m_ids.resize(m_window.size(), 0);
+			m_working.resize(m_end - m_begin, 0);
+			m_times.resize(m_end - m_begin, 0);
+		}
+
+		//first and one past the last lattice index of the own cells
+		size_t begin() const
+		{
+			return m_begin;
+		}
+
+		size_t end() const
+		{
+			return m_end;
+		}
+
+		//index of a lattice cell in the window (the cell's plane must be part of the window)
+		size_t windowIndex(size_t index) const
+		{
+			size_t planeSize = m_window.dimension(0) * m_window.dimension(1);
+			size_t dimZ = m_partition.lattice().dimension(2);
+			size_t plane = (index / planeSize + dimZ - m_firstPlane) % dimZ;
+			return plane * planeSize + index % planeSize;
+		}
+
+		//first plane (lattice z) of the window
+		size_t firstPlane() const
+		{
+			return m_firstPlane;
+		}
+
+		size_t planeCount() const
+		{
+			return m_window.dimension(2);
+		}
+
+		//grain ids of the window
+		int32_t* ids()
+		{
+			return m_ids.empty() ? NULL : &m_ids[0];
+		}
+
+		//grain ids of the own cells
+		int32_t* ownIds()
+		{
+			return m_ids.empty() ? NULL : &m_ids[m_offset];
+		}
+
+		//recrystallization times of the own cells
+		uint32_t* times()
+		{
+			return m_times.empty() ? NULL : &m_times[0];
+		}
+
+		/*
+		 * Advances the own cells one step (the halo has to hold the current state of the neighboring processes' cells) and
+		 * returns the number of own cells left unrecrystallized. Nuclei are marked -1 until commit numbers them.
+		 */
+		size_t step(uint64_t stepSeed, uint64_t nucleationThreshold, uint32_t timeStep)
+		{
+			size_t unrecrystallized = 0;
+			size_t neighborList[26];
+			for(size_t blockStart = m_begin; blockStart < m_end; blockStart += RandomBlockSize)
+			{
+				size_t blockEnd = std::min(blockStart + RandomBlockSize, m_end);
+				VariateStream generator(StreamSeed(stepSeed, blockStart / RandomBlockSize));
+				for(size_t i = blockStart; i < blockEnd; i++)
+				{
+					size_t own = i - m_begin;
+					size_t index = m_offset + own;
+					if(0 != m_ids[index])
+					{
+						m_working[own] = m_ids[index];
+						continue;
+					}
+
+					//the neighbor list is built (and the variant drawn) even if no neighbor turns out to be recrystallized
+					size_t count = neighbors(index, generator, neighborList);
+					size_t good[26];
+					size_t numGood = 0;
+					for(size_t n = 0; n < count; n++)
+					{
+						if(0 != m_ids[neighborList[n]])
+							good[numGood++] = neighborList[n];
+					}
+					if(0 != numGood)
+					{
+						m_working[own] = m_ids[good[generator.below(static_cast<uint32_t>(numGood))]];
+						m_times[own] = timeStep;
+					}
+					else if(0 != nucleationThreshold && generator.passes(nucleationThreshold) && !suppressed(index))
+					{
+						m_working[own] = -1;
+						m_times[own] = timeStep;
+						m_nuclei.push_back(own);
+					}
+					else
+					{
+						m_working[own] = 0;
+						unrecrystallized++;
+					}
+				}
+			}
+			return unrecrystallized;
+		}
+
+		//number of nuclei created by the last step
+		size_t nuclei() const
+		{
+			return m_nuclei.size();
+		}
+
+		//numbers the last step's nuclei from firstId in index order and makes the step's state current (the halo is stale until exchanged)
+		void commit(int32_t firstId)
+		{
+			for(size_t n = 0; n < m_nuclei.size(); n++)
+				m_working[m_nuclei[n]] = firstId + static_cast<int32_t>(n);
+			m_nuclei.clear();
+			std::copy(m_working.begin(), m_working.end(), m_ids.begin() + m_offset);
+		}
+	};
+}
+
+#endif
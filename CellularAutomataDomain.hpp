@@ -0,0 +1,167 @@
+#ifndef _CellularAutomataDomain_H_
+#define _CellularAutomataDomain_H_
+
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include "CellularAutomataHelpers.hpp"
+
+namespace CellularAutomata
+{
+	/*
+	 * Compacted index of the cells of a lattice selected by a mask. Active cells are numbered in lattice order, and arrays
+	 * over the domain hold size() + 1 values: the last is a padding cell that stays unrecrystallized and stands in for every
+	 * neighbor outside the mask. The neighbor table holds the first `width` entries of each cell's Moore neighbor list
+	 * (see Lattice::Moore: 6 faces, 12 edges, 8 corners) as compact indices, in 32 bits unless the domain (+ padding cell)
+	 * needs 64 bit indices or they are forced.
+	 */
+	class Domain
+	{
+		Lattice* m_lattice;
+		std::vector<size_t> m_cells;//lattice index of each active cell
+		std::vector<size_t> m_rowStart;//first active cell of each x row (row y + z * dimY)
+		std::vector<uint32_t> m_neighbors;
+		std::vector<uint64_t> m_wideNeighbors;
+		size_t m_width;
+		bool m_wide;
+
+		template<typename IndexType>
+		void buildTable(std::vector<IndexType>& table)
+		{
+			table.resize(m_cells.size() * m_width);
+			size_t moore[26];
+			for(size_t c = 0; c < m_cells.size(); c++)
+			{
+				m_lattice->Neighbors(m_cells[c], m_width, moore);
+				for(size_t n = 0; n < m_width; n++)
+					table[c * m_width + n] = static_cast<IndexType>(compactIndex(moore[n]));
+			}
+		}
+
+	public:
+		//width is the number of Moore neighbors kept per cell (6, 18 or 26), forceWide builds the 64 bit table whatever the
+		//size (so the wide kernels can be checked on small domains)
+		Domain(Lattice& lattice, const bool* mask, size_t width, bool forceWide = false) :
+			m_lattice(&lattice),
+			m_width(width),
+			m_wide(forceWide)
+		{
+			size_t xDim = lattice.dimension(0);
+			size_t rows = lattice.dimension(1) * lattice.dimension(2);
+			m_rowStart.resize(rows + 1);
+			for(size_t row = 0, index = 0; row < rows; row++)
+			{
+				m_rowStart[row] = m_cells.size();
+				for(size_t x = 0; x < xDim; x++, index++)
+				{
+					if(mask[index])
+						m_cells.push_back(index);
+				}
+			}
+			m_rowStart[rows] = m_cells.size();
+
+			m_wide = m_wide || m_cells.size() >= Lattice::Max32BitCells;
+			if(wide())
+				buildTable(m_wideNeighbors);
+			else
+				buildTable(m_neighbors);
+		}
+
+		//number of active cells
+		size_t size() const
+		{
+			return m_cells.size();
+		}
+
+		//true if the neighbor table holds 64 bit indices (needed from Lattice::Max32BitCells cells on, the padding cell index
+		//is size())
+		bool wide() const
+		{
+			return m_wide;
+		}
+
+		size_t width() const
+		{
+			return m_width;
+		}
+
+		size_t fullIndex(size_t c) const
+		{
+			return m_cells[c];
+		}
+
+		//compact index of a lattice cell, size() if the cell isn't active
+		size_t compactIndex(size_t index) const
+		{
+			size_t row = index / m_lattice->dimension(0);
+			std::vector<size_t>::const_iterator begin = m_cells.begin() + m_rowStart[row];
+			std::vector<size_t>::const_iterator end = m_cells.begin() + m_rowStart[row + 1];
+			std::vector<size_t>::const_iterator iter = std::lower_bound(begin, end, index);
+			if(iter == end || *iter != index)
+				return m_cells.size();
+			return iter - m_cells.begin();
+		}
+
+		bool contains(size_t index) const
+		{
+			return compactIndex(index) != m_cells.size();
+		}
+
+		//first width() Moore neighbors of active cell c (32 bit table, only if !wide())
+		const uint32_t* neighbors(size_t c) const
+		{
+			return &m_neighbors[c * m_width];
+		}
+
+		//first width() Moore neighbors of active cell c (64 bit table, only if wide())
+		const uint64_t* wideNeighbors(size_t c) const
+		{
+			return &m_wideNeighbors[c * m_width];
+		}
+
+		//compact indices of the 2 shell neighborhood of active cell c (inactive cells map to the padding cell)
+		std::vector<size_t> ExtendedMoore(size_t c) const
+		{
+			std::vector<size_t> neighbors = m_lattice->ExtendedMoore(m_cells[c]);
+			for(std::vector<size_t>::iterator iter = neighbors.begin(); iter != neighbors.end(); ++iter)
+				*iter = compactIndex(*iter);
+			return neighbors;
+		}
+
+		//writes the compact indices of the 2 shell neighborhood of active cell c to neighbors (Lattice::MaxExtendedNeighbors
+		//at most), returns their number
+		size_t ExtendedNeighbors(size_t c, size_t* neighbors) const
+		{
+			size_t count = m_lattice->ExtendedNeighbors(m_cells[c], neighbors);
+			for(size_t n = 0; n < count; n++)
+				neighbors[n] = compactIndex(neighbors[n]);
+			return count;
+		}
+
+		void ToTuple(size_t c, size_t& x, size_t& y, size_t& z) const
+		{
+			m_lattice->ToTuple(m_cells[c], x, y, z);
+		}
+
+		//copies lattice values into a domain array (the padding cell gets padding)
+		template<typename T>
+		void gather(const T* full, T* compact, T padding) const
+		{
+			for(size_t c = 0; c < m_cells.size(); c++)
+				compact[c] = full[m_cells[c]];
+			compact[m_cells.size()] = padding;
+		}
+
+		//copies domain values back into a lattice array (inactive cells are left untouched)
+		template<typename T>
+		void scatter(const T* compact, T* full) const
+		{
+			for(size_t c = 0; c < m_cells.size(); c++)
+				full[m_cells[c]] = compact[c];
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,279 @@
+#ifndef _CellularAutomataEngine_H_
+#define _CellularAutomataEngine_H_
+
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#endif
+
+#include <QtCore/QString>
+#include <QtCore/QElapsedTimer>
+
+#include "CellularAutomataHelpers.hpp"
+
+namespace CellularAutomata
+{
+	//execution strategies of a simulation. Random numbers are drawn per block of cells from streams seeded by the block,
+	//so every strategy (and thread count / grain size) produces the same result.
+	enum EngineType
+	{
+		AutoEngine = 0,
+		ParallelEngine,
+		SerialEngine
+	};
+
+	//how a simulation is run
+	struct EnginePlan
+	{
+		EnginePlan() : parallel(false), probe(false), threads(1), grainSize(1), wideIndices(false), windowBlocks(0), checkpointSnapshots(true) {}
+
+		bool parallel;
+		bool probe;//time the first steps alternately in parallel and serially and keep the faster
+		size_t threads;
+		size_t grainSize;//random number blocks per task
+		bool wideIndices;//64 bit neighbor tables (masked domains of 2^32 or more cells)
+		size_t windowBlocks;//random number blocks stepped at a time with a working window instead of a lattice sized working array (0 disables)
+		bool checkpointSnapshots;//checkpoints are written from a copy in the background (otherwise from the live arrays while the simulation waits)
+		QString kernel;
+		QString reason;
+
+		QString summary() const
+		{
+			QString strategy = probe ? QString("probing") : parallel ? QString("parallel (%1 threads, %2 blocks per task)").arg(threads).arg(grainSize) : QString("serial");
+			QString memory;
+			if(0 != windowBlocks)
+			{ memory += QString(", working window of %1 blocks").arg(windowBlocks); }
+			if(!checkpointSnapshots)
+			{ memory += QString(", checkpoints written in the foreground"); }
+			return QString("%1 kernel, %2 bit indices%3, %4: %5").arg(kernel).arg(wideIndices ? 64 : 32).arg(memory).arg(strategy).arg(reason);
+		}
+	};
+
+	//neighbors examined per cell on the recrystallization front for each neighborhood type (see RecrystalizeVolume)
+	static const size_t EngineNeighborCounts[9] = { 6, 8, 14, 18, 20, 26, 4, 8, 6 };
+
+	//EngineNeighborCounts of a neighborhood type, the most of any type for types it doesn't know
+	inline size_t EngineNeighborCount(int neighborhood)
+	{
+		if(neighborhood < 0 || neighborhood >= static_cast<int>(sizeof(EngineNeighborCounts) / sizeof(EngineNeighborCounts[0])))
+			return 26;
+		return EngineNeighborCounts[neighborhood];
+	}
+
+	//work (cell updates weighted by neighbors examined) per step below which threads don't pay off / above which they always do
+	static const double SerialStepWork = 3.0e4;
+	static const double ParallelStepWork = 1.0e6;
+
+	//tasks per thread, enough to balance blocks that are cheap (unrecrystallized interior) against ones on the front
+	static const size_t TasksPerThread = 4;
+
+	/*
+	 * Picks the strategy for a simulation of activeCells cells (the lattice, or the cells of a mask) split into blocks of
+	 * blockSize cells, run by the named kernel with a neighborhood type of RecrystalizeVolume. Steps cost about one random
+	 * draw per cell plus a neighbor check per front cell, weighted here by the neighborhood. Tiny steps run serially, large
+	 * ones in parallel with a few tasks per thread, and steps in between are decided by timing (probe).
+	 */
+	inline EnginePlan PlanEngine(int engine, const QString& kernel, size_t activeCells, bool masked, size_t blockSize, int neighborhood, float pNuc, size_t threads)
+	{
+		EnginePlan plan;
+		plan.kernel = kernel;
+		plan.wideIndices = masked && activeCells >= Lattice::Max32BitCells;
+		plan.threads = std::max(threads, static_cast<size_t>(1));
+
+		size_t numBlocks = (activeCells + blockSize - 1) / blockSize;
+		plan.grainSize = std::max(numBlocks / (TasksPerThread * plan.threads), static_cast<size_t>(1));
+		double work = static_cast<double>(activeCells) * (1.0 + EngineNeighborCount(neighborhood) / 8.0);
+		double nuclei = static_cast<double>(pNuc) * activeCells;
+
+		if(SerialEngine == engine)
+		{
+			plan.reason = "selected";
+		}
+		else if(ParallelEngine == engine)
+		{
+			plan.parallel = true;
+			plan.reason = "selected";
+		}
+		else if(plan.threads < 2)
+		{
+			plan.reason = "a single thread is available";
+		}
+		else if(numBlocks < 2)
+		{
+			plan.reason = QString("%1 cells fit a single random number block").arg(activeCells);
+		}
+		else if(work < SerialStepWork)
+		{
+			plan.reason = QString("steps of %1 cells are too small to split").arg(activeCells);
+		}
+		else if(work >= ParallelStepWork)
+		{
+			plan.parallel = true;
+			plan.reason = QString("steps of %1 cells in %2 blocks").arg(activeCells).arg(numBlocks);
+		}
+		else
+		{
+			plan.parallel = true;
+			plan.probe = true;
+			plan.reason = QString("steps of %1 cells are timed").arg(activeCells);
+		}
+
+		//a low rate spends its first steps waiting for a nucleus, a high one finishes in a few steps
+		if(AutoEngine == engine)
+		{
+			if(nuclei < 1.0)
+			{ plan.reason += QString(", ~%1 steps to the first nucleus").arg(static_cast<uint64_t>(1.0 / std::max(nuclei, 1.0e-12))); }
+			else
+			{ plan.reason += QString(", ~%1 nuclei per step").arg(static_cast<uint64_t>(nuclei)); }
+		}
+		return plan;
+	}
+
+	//steps a probing plan times with each strategy
+	static const size_t ProbeStepsPerStrategy = 4;
+
+	//times the first steps of a probing plan, alternately parallel and serial (so both see the front grow alike) for
+	//ProbeStepsPerStrategy steps each, and keeps the strategy with the lower total. Both strategies give the same result,
+	//so the probe steps are regular steps of the simulation.
+	class EngineProbe
+	{
+		EnginePlan& m_plan;
+		QElapsedTimer m_timer;
+		size_t m_steps;
+		qint64 m_times[2];//parallel, serial
+
+	public:
+		EngineProbe(EnginePlan& plan) : m_plan(plan), m_steps(0)
+		{
+			m_times[0] = m_times[1] = 0;
+			if(m_plan.probe)
+			{ m_plan.parallel = true; }
+		}
+
+		void start()
+		{
+			if(m_plan.probe)
+			{ m_timer.start(); }
+		}
+
+		//ends a step, returns true when the probe has decided (the plan's strategy and reason are updated)
+		bool stop()
+		{
+			if(!m_plan.probe)
+			{ return false; }
+			m_times[m_steps % 2] += m_timer.nsecsElapsed();
+			if(++m_steps < 2 * ProbeStepsPerStrategy)
+			{
+				m_plan.parallel = 0 == m_steps % 2;
+				return false;
+			}
+			m_plan.probe = false;
+			m_plan.parallel = m_times[0] < m_times[1];
+			m_plan.reason = QString("%1 timed steps each took %2 ms parallel, %3 ms serial").arg(ProbeStepsPerStrategy).arg(m_times[0] * 1.0e-6).arg(m_times[1] * 1.0e-6);
+			return true;
+		}
+	};
+
+	//runs work on at most a fixed number of threads: a dedicated arena, so the rest of the process (and other arenas)
+	//keep the remaining threads. Without parallel algorithms work simply runs on the calling thread.
+	class ThreadArena
+	{
+		//calls object.method(argument) (the work of an arena is a function object)
+		template<typename Object, typename Argument>
+		struct MethodCall
+		{
+			Object* object;
+			void (Object::*method)(Argument&);
+			Argument* argument;
+
+			void operator()() const
+			{
+				(object->*method)(*argument);
+			}
+		};
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+		tbb::task_arena m_arena;
+#endif
+		size_t m_threads;
+
+	public:
+		ThreadArena(size_t threads) :
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+			m_arena(static_cast<int>(std::max(threads, static_cast<size_t>(1)))),
+#endif
+			m_threads(std::max(threads, static_cast<size_t>(1)))
+		{
+		}
+
+		size_t threads() const
+		{
+			return m_threads;
+		}
+
+		//runs function() in the arena and waits for it
+		template<typename Function>
+		void execute(Function& function)
+		{
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+			m_arena.execute(function);
+#else
+			function();
+#endif
+		}
+
+		//runs object.method(argument) in the arena and waits for it
+		template<typename Object, typename Argument>
+		void execute(Object& object, void (Object::*method)(Argument&), Argument& argument)
+		{
+			MethodCall<Object, Argument> call = { &object, method, &argument };
+			execute(call);
+		}
+	};
+
+	//thread counts of a scaling study up to maxThreads: 1, 2, 4, ... and maxThreads itself
+	inline std::vector<size_t> ScalingThreadCounts(size_t maxThreads)
+	{
+		std::vector<size_t> counts;
+		for(size_t threads = 1; threads < maxThreads; threads *= 2)
+		{ counts.push_back(threads); }
+		counts.push_back(std::max(maxThreads, static_cast<size_t>(1)));
+		return counts;
+	}
+
+	//columns of the scaling study table: threads, seconds, speedup, efficiency, weak scaling efficiency
+	static const size_t ScalingColumns = 5;
+
+	//a point of a scaling study: the time of the same steps (strong scaling) and of steps on a lattice grown with the
+	//thread count (weak scaling, negative if it didn't fit)
+	struct ScalingPoint
+	{
+		ScalingPoint() : threads(1), seconds(0), weakSeconds(-1) {}
+
+		//speedup over a run on base.threads threads and the share of that per added thread
+		double speedup(const ScalingPoint& base) const
+		{
+			return seconds > 0 ? base.seconds / seconds : 0.0;
+		}
+
+		double efficiency(const ScalingPoint& base) const
+		{
+			return speedup(base) * base.threads / threads;
+		}
+
+		//the same work per thread ideally takes the same time
+		double weakEfficiency(const ScalingPoint& base) const
+		{
+			return weakSeconds > 0 && base.weakSeconds > 0 ? base.weakSeconds / weakSeconds : 0.0;
+		}
+
+		size_t threads;
+		double seconds;
+		double weakSeconds;
+	};
+}
+
+#endif
@@ -0,0 +1,346 @@
+#ifndef _CellularAutomataEstimate_H_
+#define _CellularAutomataEstimate_H_
+
+#include <stdint.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <QtCore/QString>
+
+#include "CellularAutomataHelpers.hpp"
+#include "CellularAutomataRandom.hpp"
+#include "CellularAutomataFeatureStatistics.hpp"
+#include "CellularAutomataKinetics.hpp"
+#include "CellularAutomataEngine.hpp"
+
+namespace CellularAutomata
+{
+	//a simulation as RecrystalizeVolume runs it (a parameter sweep runs every (nucleation probability, neighborhood) pair of sweep)
+	struct SimulationRequest
+	{
+		SimulationRequest() :
+			activeCells(0),
+			neighborhood(0),
+			nucleationProbability(0.0f),
+			kineticsOnly(false),
+			masked(false),
+			weightedSites(false),
+			continued(false),
+			checkpoints(false),
+			frameInterval(0),
+			featureStatistics(false),
+			growthSteps(0),
+			threads(1),
+			parallel(false)
+		{
+			for(size_t i = 0; i < 3; i++)
+				dims[i] = 1;
+		}
+
+		size_t cells() const
+		{
+			return dims[0] * dims[1] * dims[2];
+		}
+
+		size_t dims[3];
+		size_t activeCells;//cells of the mask (the lattice if there is none)
+		int neighborhood;//as listed by RecrystalizeVolume (0 - 8)
+		float nucleationProbability;//per cell and step
+		bool kineticsOnly;
+		bool masked;
+		bool weightedSites;//heterogeneous nucleation
+		bool continued;//resumed from a checkpoint or warm started
+		bool checkpoints;
+		uint64_t frameInterval;
+		bool featureStatistics;
+		uint64_t growthSteps;//grain growth after the recrystallization
+		StopCriteria stop;
+		size_t threads;
+		bool parallel;//steps run on threads threads
+		std::vector<std::pair<float, int> > sweep;
+	};
+
+	//memory (bytes) and time a simulation needs
+	struct ResourceEstimate
+	{
+		ResourceEstimate() : outputBytes(0), workingBytes(0), snapshotBytes(0), auxiliaryBytes(0), steps(0), grains(0), seconds(0), concurrentRuns(1) {}
+
+		uint64_t outputBytes;//arrays created by the filter
+		uint64_t workingBytes;//working state of the kernel (working ids, bit-sliced states, compact domain copies + tables, sweep lattices)
+		uint64_t snapshotBytes;//copies of the state for checkpoints written in the background
+		uint64_t auxiliaryBytes;//nucleation site table, frame buffers and feature statistics
+		double steps;//including the steps before the first nucleus (of the slowest replica / longest sweep combination)
+		double grains;
+		double seconds;//infinite if a simulation can't complete
+		size_t concurrentRuns;//sweep combinations run at once
+
+		uint64_t peakBytes() const
+		{
+			return outputBytes + workingBytes + snapshotBytes + auxiliaryBytes;
+		}
+
+		QString memorySummary() const
+		{
+			double gb = 1.0 / (1024.0 * 1024.0 * 1024.0);
+			return QString("%1 GB peak (%2 GB outputs, %3 GB working state, %4 GB checkpoint copies, %5 GB other)").arg(peakBytes() * gb, 0, 'f', 2).arg(outputBytes * gb, 0, 'f', 2)
+			       .arg(workingBytes * gb, 0, 'f', 2).arg(snapshotBytes * gb, 0, 'f', 2).arg(auxiliaryBytes * gb, 0, 'f', 2);
+		}
+
+		QString runtimeSummary() const
+		{
+			if(seconds > std::numeric_limits<double>::max())
+				return QString("unbounded (nothing nucleates without a stop criterion)");
+			QString time = seconds < 120.0 ? QString("%1 s").arg(seconds, 0, 'f', 1) : (seconds < 7200.0 ? QString("%1 min").arg(seconds / 60.0, 0, 'f', 1) : QString("%1 h").arg(seconds / 3600.0, 0, 'f', 1));
+			return QString("~%1 (~%2 steps, ~%3 grains)").arg(time).arg(static_cast<uint64_t>(steps)).arg(static_cast<uint64_t>(grains));
+		}
+	};
+
+	/*
+	 * Calibration of the runtime estimate, fit to runs of the reference kernels (serial, SSE2 build on an x86-64 Xeon core).
+	 * A grain covers about GrowthConstants * t^3 cells (t^2 on single slices) t steps after it nucleated, a single grain
+	 * fills a periodic lattice in about FillSteps * cells^(1/3) (^(1/2)) steps and a step costs KernelNanoseconds per cell
+	 * (BitSlicedNanoseconds for all 64 replicas). Indexed by neighborhood (0 - 8).
+	 */
+	static const double GrowthConstants[9] = { 2.42, 7.64, 12.06, 14.47, 13.54, 17.35, 3.81, 7.79, 5.33 };
+	static const double FillSteps[9] = { 1.5, 0.8, 0.7, 1.0, 0.75, 0.5, 1.0, 0.5, 0.75 };
+	static const double KernelNanoseconds[9] = { 23.0, 28.0, 33.0, 30.0, 35.0, 30.0, 10.1, 12.6, 10.8 };
+	static const double BitSlicedNanoseconds[6] = { 61.0, 136.0, 93.0, 80.0, 75.0, 60.0 };
+
+	//growth calibration of a neighborhood (on a single slice Von Neumann is the 4 cell square and the other 3D neighborhoods grow like the 8 cell square)
+	inline int CalibratedNeighborhood(bool slice, int neighborhood)
+	{
+		if(slice && 0 == neighborhood)
+			return 6;
+		return slice && neighborhood < 6 ? 7 : neighborhood;
+	}
+
+	//a grain growth step costs GrainGrowthNanoseconds per boundary cell (3D, single slice)
+	static const double GrainGrowthNanoseconds[2] = { 210.0, 100.0 };
+
+	//speedup per thread of a parallel step (assumed, scaling isn't part of the calibration)
+	static const double ParallelEfficiency = 0.8;
+
+	//frame buffers per changed cell: the change list (8), the frame's index + id (12), encoded and compressed copies (12)
+	static const size_t FrameBytesPerCell = 32;
+
+	//nucleation site table per candidate cell: sites, probabilities and aliases (24), build lists (8), growth of the site list (8)
+	static const size_t SiteBytesPerCell = 40;
+
+	//recrystallization history, interface area and grain count of a step (state + output arrays)
+	static const size_t StepBytes = 44;
+
+	//feature arrays per grain: Active, + NumCells, Volumes, NucleationTime, NucleationSite, Centroids and BoundingBox with statistics
+	static const size_t FeatureBytes = 1;
+	static const size_t FeatureStatisticsBytes = 60;
+
+	//planes a chunk of the working window covers (at least a few tasks per thread)
+	static const size_t WindowPlanes = 4;
+
+	//random number blocks a working window steps at a time
+	inline size_t WorkingWindowBlocks(const size_t dims[3], size_t threads)
+	{
+		size_t planeBlocks = (WindowPlanes * dims[0] * dims[1] + RandomBlockSize - 1) / RandomBlockSize;
+		return std::max(planeBlocks, TasksPerThread * std::max(threads, static_cast<size_t>(1)));
+	}
+
+	//cells of a working window: a chunk, the planes before it whose old ids are still read (3 including a partial one) and
+	//the first 2 planes of the lattice (read by the last ones, so they are held until the step ends)
+	inline size_t WorkingWindowCells(const size_t dims[3], size_t windowBlocks)
+	{
+		size_t numCells = dims[0] * dims[1] * dims[2];
+		size_t planeSize = dims[0] * dims[1];
+		return std::min(numCells, windowBlocks * RandomBlockSize + 3 * planeSize) + std::min(numCells, 2 * planeSize);
+	}
+
+	//true if the 3D kernel can step a request with a working window (a lattice with more planes than the window, every cell active, uniform nucleation)
+	inline bool WindowAllowed(const SimulationRequest& request, size_t windowBlocks)
+	{
+		return !request.kineticsOnly && request.sweep.empty() && !request.masked && !request.weightedSites && request.neighborhood < 6 && request.dims[2] > 1
+		       && WorkingWindowCells(request.dims, windowBlocks) < request.cells();
+	}
+
+	/*
+	 * Steps until a fraction of the lattice is recrystallized, from the Johnson-Mehl-Avrami-Kolmogorov kinetics of grains
+	 * nucleating uniformly at a rate and growing as calibrated: the wait for the first nucleus plus the growth, which ends
+	 * either once the nuclei impinge or once a single grain fills the lattice. Completion is the fraction leaving half a cell.
+	 */
+	inline double EstimateSteps(size_t numCells, bool slice, int neighborhood, float nucleationProbability, float fraction)
+	{
+		double cells = static_cast<double>(numCells);
+		double rate = static_cast<double>(nucleationProbability);
+		double order = slice ? 3.0 : 4.0;
+		double extended = fraction < 1.0f ? -std::log(1.0 - fraction) : std::log(2.0 * cells);
+		int calibrated = CalibratedNeighborhood(slice, neighborhood);
+		double impinged = std::pow(order * extended / (GrowthConstants[calibrated] * rate), 1.0 / order);
+		double filled = FillSteps[calibrated] * std::pow(cells * std::min(1.0, static_cast<double>(fraction)), 1.0 / (order - 1.0));
+		return 1.0 / (rate * cells) + std::min(impinged, filled);
+	}
+
+	//expected number of grains of a complete simulation (every nucleus of the JMAK kinetics, at least 1)
+	inline double EstimateGrains(size_t numCells, bool slice, int neighborhood, float nucleationProbability)
+	{
+		double rate = static_cast<double>(nucleationProbability);
+		double order = slice ? 3.0 : 4.0;
+		double growth = GrowthConstants[CalibratedNeighborhood(slice, neighborhood)];
+		double grains = rate * numCells * std::exp(lgamma(1.0 + 1.0 / order)) * std::pow(order / (growth * rate), 1.0 / order);
+		return std::min(static_cast<double>(numCells), std::max(1.0, grains));
+	}
+
+	//largest fraction of the lattice that recrystallizes within interval steps (the steepest part of the JMAK curve)
+	inline double EstimateFrameFraction(bool slice, int neighborhood, float nucleationProbability, uint64_t interval)
+	{
+		double order = slice ? 3.0 : 4.0;
+		double a = GrowthConstants[CalibratedNeighborhood(slice, neighborhood)] * nucleationProbability / order;
+		double peak = std::pow((order - 1.0) / (a * order), 1.0 / order);
+		double slope = a * order * std::pow(peak, order - 1.0) * std::exp(-a * std::pow(peak, order));
+		return std::min(1.0, slope * interval);
+	}
+
+	//cells on a grain boundary (of either grain) if grains equal cubes (squares) tiled the lattice
+	inline double EstimateBoundaryCells(size_t numCells, bool slice, double grains)
+	{
+		double order = slice ? 2.0 : 3.0;
+		double side = std::pow(numCells / std::max(grains, 1.0), 1.0 / order);
+		return std::min(static_cast<double>(numCells), grains * 2.0 * order * std::pow(side, order - 1.0));
+	}
+
+	/*
+	 * Memory and runtime of a request run with a working window of windowBlocks blocks (0 for a lattice sized working array)
+	 * and with checkpoints written from background snapshots or not. Allocations that depend on the input data (mask, site
+	 * weights) are exact for the given activeCells; those that depend on the course of the simulation (grains, frames) use
+	 * the expected kinetics. Runtimes are calibrated estimates, the memory of earlier filters isn't included.
+	 */
+	inline ResourceEstimate EstimateResources(const SimulationRequest& request, size_t windowBlocks, bool checkpointSnapshots, uint64_t limitBytes)
+	{
+		ResourceEstimate estimate;
+		uint64_t numCells = request.cells();
+		uint64_t activeCells = std::min(static_cast<uint64_t>(request.activeCells), numCells);
+		bool slice = 1 == request.dims[2];
+		double speedup = request.parallel ? std::max(1.0, ParallelEfficiency * request.threads) : 1.0;
+
+		//parameter sweeps run whole lattices concurrently (each serially), as many as fit
+		if(!request.sweep.empty())
+		{
+			uint64_t latticeBytes = numCells * (request.kineticsOnly ? 2 * sizeof(uint64_t) : 2 * sizeof(int32_t) + sizeof(uint32_t));
+			estimate.concurrentRuns = static_cast<size_t>(std::min(static_cast<uint64_t>(std::min(request.threads, request.sweep.size())), limitBytes / latticeBytes));
+			estimate.workingBytes = std::max(estimate.concurrentRuns, static_cast<size_t>(1)) * latticeBytes;
+			estimate.outputBytes = request.sweep.size() * 16;
+			double work = 0;
+			for(size_t c = 0; c < request.sweep.size(); c++)
+			{
+				int neighborhood = request.sweep[c].second;
+				double steps = EstimateSteps(numCells, slice, neighborhood, request.sweep[c].first, request.stop.targetFraction);
+				if(0 != request.stop.maxTimeStep)
+				{ steps = std::min(steps, 1.0 / (request.sweep[c].first * numCells) + request.stop.maxTimeStep); }
+				estimate.steps = std::max(estimate.steps, steps);
+				work += steps * numCells * (request.kineticsOnly ? BitSlicedNanoseconds[std::min(neighborhood, 5)] : KernelNanoseconds[neighborhood]);
+			}
+			estimate.seconds = work * 1.0e-9 / std::max(estimate.concurrentRuns, static_cast<size_t>(1));
+			if(request.stop.wallClockLimit > 0)
+			{ estimate.seconds = std::min(estimate.seconds, request.stop.wallClockLimit * std::max(1.0, std::ceil(static_cast<double>(request.sweep.size()) / std::max(estimate.concurrentRuns, static_cast<size_t>(1))))); }
+			return estimate;
+		}
+
+		//steps of the growth (the slowest of 64 replicas waits about H(64) = 4.7 times as long for its first nucleus)
+		double rate = static_cast<double>(request.nucleationProbability);
+		double wait = 1.0 / (rate * activeCells);
+		double steps = EstimateSteps(activeCells, slice, request.neighborhood, request.nucleationProbability, request.stop.targetFraction);
+		if(request.kineticsOnly)
+		{ steps += 3.7 * wait; }
+		if(0 != request.stop.maxTimeStep)
+		{ steps = std::min(steps, (request.kineticsOnly ? 4.7 : 1.0) * wait + request.stop.maxTimeStep); }
+		estimate.steps = steps;
+		estimate.grains = request.kineticsOnly ? 0.0 : EstimateGrains(activeCells, slice, request.neighborhood, request.nucleationProbability);
+		double nanoseconds = request.kineticsOnly ? BitSlicedNanoseconds[std::min(request.neighborhood, 5)] : KernelNanoseconds[request.neighborhood];
+		estimate.seconds = rate > 0 ? steps * activeCells * nanoseconds * 1.0e-9 / speedup : std::numeric_limits<double>::infinity();
+		if(request.stop.wallClockLimit > 0)
+		{ estimate.seconds = std::min(estimate.seconds, request.stop.wallClockLimit); }
+		uint64_t historyBytes = static_cast<uint64_t>(std::min(steps, 1.0e9) * StepBytes);
+
+		//bit-sliced replicas only keep their two states
+		if(request.kineticsOnly)
+		{
+			estimate.workingBytes = 2 * numCells * sizeof(uint64_t);
+			estimate.outputBytes = historyBytes;
+			return estimate;
+		}
+
+		//FeatureIds and RecrystallizationTime + the feature and ensemble arrays
+		uint64_t grains = static_cast<uint64_t>(estimate.grains);
+		estimate.outputBytes = numCells * (sizeof(int32_t) + sizeof(uint32_t)) + grains * (FeatureBytes + (request.featureStatistics ? FeatureStatisticsBytes : 0)) + historyBytes;
+
+		//working ids: of the lattice, of a window of planes, or compact copies of the domain (ids, working ids, times + a padding cell) and its neighbor table
+		if(request.masked)
+		{
+			size_t width = 0 == request.neighborhood || 6 == request.neighborhood ? 6 : (1 == request.neighborhood || 3 == request.neighborhood || request.neighborhood > 6 ? 18 : 26);
+			uint64_t indexBytes = activeCells >= Lattice::Max32BitCells ? sizeof(uint64_t) : sizeof(uint32_t);
+			estimate.workingBytes = 3 * (activeCells + 1) * sizeof(int32_t) + 2 * activeCells * sizeof(size_t) + (request.dims[1] * request.dims[2] + 1) * sizeof(size_t) + activeCells * width * indexBytes;
+		}
+		else if(0 != windowBlocks)
+		{ estimate.workingBytes = WorkingWindowCells(request.dims, windowBlocks) * sizeof(int32_t); }
+		else
+		{ estimate.workingBytes = numCells * sizeof(int32_t); }
+
+		if(request.checkpoints && checkpointSnapshots)
+		{ estimate.snapshotBytes = numCells * (sizeof(int32_t) + sizeof(uint32_t)); }
+
+		//site table (+ the masked weights), the cells of the largest frame (every cell recrystallized so far in the first frame
+		//of a continued simulation) and the features (merged + one accumulator per thread, with room to grow)
+		if(request.weightedSites)
+		{ estimate.auxiliaryBytes += activeCells * SiteBytesPerCell + (request.masked ? numCells * sizeof(float) : 0); }
+		if(0 != request.frameInterval)
+		{
+			double fraction = request.continued ? 1.0 : EstimateFrameFraction(slice, request.neighborhood, request.nucleationProbability, request.frameInterval);
+			estimate.auxiliaryBytes += static_cast<uint64_t>(fraction * activeCells) * FrameBytesPerCell;
+		}
+		if(request.featureStatistics)
+		{ estimate.auxiliaryBytes += (request.threads + 2) * grains * sizeof(FeatureStatistics::Feature); }
+
+		//grain growth runs once the working ids are released: list flags and the boundary list (with room to grow), the
+		//boundary shrinks as the grains coarsen so its initial size bounds the steps
+		if(0 != request.growthSteps)
+		{
+			double boundary = EstimateBoundaryCells(numCells, slice, estimate.grains);
+			estimate.workingBytes = std::max(estimate.workingBytes, numCells * sizeof(uint8_t) + static_cast<uint64_t>(2.0 * boundary) * sizeof(size_t));
+			estimate.seconds += request.growthSteps * boundary * GrainGrowthNanoseconds[slice ? 1 : 0] * 1.0e-9;
+		}
+		return estimate;
+	}
+
+	/*
+	 * Fits a plan's memory strategy into limitBytes: a lattice sized working array with background checkpoints if that fits,
+	 * else a working window of planes (3D kernel only), else also checkpoints written from the live arrays. Returns false
+	 * (with the estimate of the smallest strategy) if nothing fits.
+	 */
+	inline bool FitMemory(const SimulationRequest& request, uint64_t limitBytes, EnginePlan& plan, ResourceEstimate& estimate)
+	{
+		plan.windowBlocks = 0;
+		plan.checkpointSnapshots = true;
+		estimate = EstimateResources(request, 0, true, limitBytes);
+		if(!request.sweep.empty())
+			return 0 != estimate.concurrentRuns;
+		if(estimate.peakBytes() <= limitBytes)
+			return true;
+
+		size_t windowBlocks = WorkingWindowBlocks(request.dims, plan.parallel || plan.probe ? plan.threads : 1);
+		if(WindowAllowed(request, windowBlocks))
+		{
+			plan.windowBlocks = windowBlocks;
+			plan.grainSize = std::max(windowBlocks / (TasksPerThread * plan.threads), static_cast<size_t>(1));
+			estimate = EstimateResources(request, plan.windowBlocks, true, limitBytes);
+			if(estimate.peakBytes() <= limitBytes)
+				return true;
+		}
+		if(request.checkpoints)
+		{
+			plan.checkpointSnapshots = false;
+			estimate = EstimateResources(request, plan.windowBlocks, false, limitBytes);
+		}
+		return estimate.peakBytes() <= limitBytes;
+	}
+}
+
+#endif
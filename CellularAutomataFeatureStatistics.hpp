@@ -0,0 +1,133 @@
+#ifndef _CellularAutomataFeatureStatistics_H_
+#define _CellularAutomataFeatureStatistics_H_
+
+#include <stdint.h>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "CellularAutomataHelpers.hpp"
+
+namespace CellularAutomata
+{
+	//per feature statistics accumulated while cells are assigned (positions are lattice coordinates)
+	class FeatureStatistics
+	{
+	public:
+		struct Feature
+		{
+			Feature() : numCells(0), nucleationTime(0), nucleationSite(0)
+			{
+				for(size_t i = 0; i < 3; i++)
+				{
+					sum[i] = 0;
+					min[i] = std::numeric_limits<uint32_t>::max();
+					max[i] = 0;
+				}
+			}
+
+			uint64_t numCells;
+			uint64_t sum[3];
+			uint32_t min[3];
+			uint32_t max[3];
+			uint32_t nucleationTime;
+			size_t nucleationSite;
+		};
+
+		std::vector<Feature> features;//indexed by feature id
+		std::vector<int32_t> touched;//features with cells added since the last merge
+
+		//adds a cell at (x, y, z) to feature id
+		inline void add(int32_t id, size_t x, size_t y, size_t z)
+		{
+			if(features.size() <= static_cast<size_t>(id))
+				features.resize(id + 1);
+			Feature& feature = features[id];
+			if(0 == feature.numCells)
+				touched.push_back(id);
+			feature.numCells++;
+			const size_t coords[3] = {x, y, z};
+			for(size_t i = 0; i < 3; i++)
+			{
+				uint32_t c = static_cast<uint32_t>(coords[i]);
+				feature.sum[i] += c;
+				if(c < feature.min[i]) feature.min[i] = c;
+				if(c > feature.max[i]) feature.max[i] = c;
+			}
+		}
+
+		//records the nucleus of feature id
+		inline void nucleate(int32_t id, size_t index, uint32_t time)
+		{
+			if(features.size() <= static_cast<size_t>(id))
+				features.resize(id + 1);
+			features[id].nucleationSite = index;
+			features[id].nucleationTime = time;
+		}
+
+		//moves the cells accumulated in local (e.g. by one thread during a step) into these statistics
+		void merge(FeatureStatistics& local)
+		{
+			for(std::vector<int32_t>::iterator iter = local.touched.begin(); iter != local.touched.end(); ++iter)
+			{
+				Feature& source = local.features[*iter];
+				if(features.size() <= static_cast<size_t>(*iter))
+					features.resize(*iter + 1);
+				Feature& target = features[*iter];
+				target.numCells += source.numCells;
+				for(size_t i = 0; i < 3; i++)
+				{
+					target.sum[i] += source.sum[i];
+					target.min[i] = std::min(target.min[i], source.min[i]);
+					target.max[i] = std::max(target.max[i], source.max[i]);
+				}
+				source = Feature();
+			}
+			local.touched.clear();
+		}
+
+		//recomputes the statistics of an existing volume (the nucleus of a feature is its earliest recrystallized cell)
+		void rebuild(Lattice& lattice, const int32_t* ids, const uint32_t* times)
+		{
+			features.clear();
+			touched.clear();
+			size_t numCells = lattice.size();
+			size_t x, y, z;
+			for(size_t i = 0; i < numCells; i++)
+			{
+				if(ids[i] <= 0)
+					continue;
+				bool first = features.size() <= static_cast<size_t>(ids[i]) || 0 == features[ids[i]].numCells;
+				lattice.ToTuple(i, x, y, z);
+				add(ids[i], x, y, z);
+				if(first || times[i] < features[ids[i]].nucleationTime)
+					nucleate(ids[i], i, times[i]);
+			}
+			touched.clear();
+		}
+
+		//recomputes the cells of every feature after they moved (e.g. by grain growth), keeping the nuclei
+		void recount(Lattice& lattice, const int32_t* ids)
+		{
+			for(std::vector<Feature>::iterator iter = features.begin(); iter != features.end(); ++iter)
+			{
+				Feature feature;
+				feature.nucleationTime = iter->nucleationTime;
+				feature.nucleationSite = iter->nucleationSite;
+				*iter = feature;
+			}
+			size_t numCells = lattice.size();
+			size_t x, y, z;
+			for(size_t i = 0; i < numCells; i++)
+			{
+				if(ids[i] <= 0)
+					continue;
+				lattice.ToTuple(i, x, y, z);
+				add(ids[i], x, y, z);
+			}
+			touched.clear();
+		}
+	};
+}
+
+#endif
@@ -4,6 +4,21 @@
 
 #include "RecrystalizeVolume.h"
 #include "CellularAutomataHelpers.hpp"
+#include "CellularAutomataMemory.hpp"
+#include "CellularAutomataRandom.hpp"
+#include "CellularAutomataCheckpoint.hpp"
+#include "CellularAutomataResultCache.hpp"
+#include "CellularAutomataFrames.hpp"
+#include "CellularAutomataFeatureStatistics.hpp"
+#include "CellularAutomataKinetics.hpp"
+#include "CellularAutomataNucleation.hpp"
+#include "CellularAutomataDomain.hpp"
+#include "CellularAutomataEngine.hpp"
+#include "CellularAutomataEstimate.hpp"
+#include "CellularAutomataGrainGrowth.hpp"
+#include "CellularAutomataStepper.hpp"
+#include "CellularAutomataMetrics.hpp"
+#include "CellularAutomataCompressedVolume.hpp"
 
 #ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
@@ -11,19 +26,58 @@
 #include <tbb/partitioner.h>
 #include <tbb/task_scheduler_init.h>
 #include <tbb/atomic.h>
+#include <tbb/concurrent_vector.h>
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
 #endif
 
 #include <QtCore/QString>
 
+#include <QtCore/QStringList>
+#include <QtCore/QRegExp>
+#include <QtCore/QFile>
+#include <QtCore/QDir>
+#include <QtCore/QScopedPointer>
+
 #include "DREAM3DLib/Math/DREAM3DMath.h"
 
-#include <boost/random/mersenne_twister.hpp>
-#include <boost/random/uniform_int.hpp>
-#include <boost/random/uniform_real.hpp>
+#include <boost/random/poisson_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
 
 #include "CellularAutomata/CellularAutomataConstants.h"
 
+//indicies of cells that nucleated during a time step (ids are assigned afterwards in index order)
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+typedef tbb::concurrent_vector<size_t> NucleusList;
+#else
+typedef std::vector<size_t> NucleusList;
+#endif
+
+//indicies of cells that recrystallized since the last output frame
+typedef CellularAutomata::ThreadLocal<std::vector<size_t> > ChangeBuffers;
+
+//cells added to each feature during a time step
+typedef CellularAutomata::ThreadLocal<CellularAutomata::FeatureStatistics> FeatureAccumulators;
+
+//randomly selected parts of the variant neighborhoods and the hexagonal slice neighbors (shared with the distributed simulation and the stepper)
+using CellularAutomata::EightCellEdges;
+using CellularAutomata::FourteenCellCorners;
+using CellularAutomata::TwentyCellCorners;
+using CellularAutomata::HexagonalNeighbors;
+
+/**
+ * @brief The RecrystalizeVolumeImpl class is the recrystallization rule of a time step: recrystallized cells keep their
+ * grain, unrecrystallized cells join a random recrystallized neighbor or may nucleate. The traversal (blocks, random
+ * streams, threads and the frontier check) is done by a CellularAutomata::Stepper, which hands each unrecrystallized cell
+ * the neighbors of the selected neighborhood. The remaining cells and the interface are reduced per task.
+ */
 class RecrystalizeVolumeImpl
 {
   public:
@@ -34,648 +88,3073 @@ class RecrystalizeVolumeImpl
     static const int TWENTY_CELL = 4;
     static const int MOORE = 5;
 
-#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
-    RecrystalizeVolumeImpl(CellularAutomata::Lattice* cellLattice, int32_t* currentGrainIDs, int32_t* workingGrainIDs, uint32_t* updateTime, int neighborhoodType, tbb::atomic<size_t>* counter, uint32_t* time, tbb::atomic<int32_t>* grainCount, float nucleationRate) :
-#elif
-    RecrystalizeVolumeImpl(CellularAutomata::Lattice cellLattice, int32_t* currentGrainIDs, int32_t* workingGrainIDs, uint32_t* updateTime, int neighborhoodType, size_t* counter, uint32_t* time, int32_t* grainCount, float nucleationRate) :
-#endif
+    //in plane neighborhoods of single slice volumes
+    static const int SQUARE_FOUR = 6;
+    static const int SQUARE_EIGHT = 7;
+    static const int HEXAGONAL = 8;
+
+    //cells are processed in fixed blocks with one random stream each so results don't depend on the thread partitioning
+    static const size_t BlockSize = CellularAutomata::RandomBlockSize;
+
+    //unrecrystallized cells left after a step and faces between them and recrystallized cells (per axis)
+    struct Reduction
+    {
+      Reduction() : unrecrystallized(0)
+      {
+        for(size_t i = 0; i < 3; i++) { interfaceFaces[i] = 0; }
+      }
+
+      void merge(const Reduction& other)
+      {
+        unrecrystallized += other.unrecrystallized;
+        for(size_t i = 0; i < 3; i++) { interfaceFaces[i] += other.interfaceFaces[i]; }
+      }
+
+      size_t unrecrystallized;
+      size_t interfaceFaces[3];
+    };
+
+    typedef CellularAutomata::StepperBase<RecrystalizeVolumeImpl> Stepper;
+
+    RecrystalizeVolumeImpl(CellularAutomata::Lattice* cellLattice, const CellularAutomata::Domain* domain, int32_t* currentGrainIDs, int32_t* workingGrainIDs, uint32_t* updateTime, uint32_t* time, NucleusList* nuclei, ChangeBuffers* changes, FeatureAccumulators* statistics, float nucleationRate, int neighborhood) :
       m_lattice(cellLattice),
+      m_domain(domain),
       m_currentIDs(currentGrainIDs),
       m_workingIDs(workingGrainIDs),
+      m_workingBase(0),
       m_updateTime(updateTime),
-      m_neighborhood(neighborhoodType),
-      m_unrecrystalizedCount(counter),
       m_time(time),
-      m_grainCount(grainCount),
-      m_nucleationRate(nucleationRate)
+      m_nuclei(nuclei),
+      m_changes(changes),
+      m_statistics(statistics),
+      m_nucleationThreshold(CellularAutomata::ProbabilityThreshold(nucleationRate)),
+      m_faceNeighbors(IsPlanar(neighborhood) ? 4 : 6)
     {}
 
     virtual ~RecrystalizeVolumeImpl() {}
 
-    inline void computeBase(size_t index, std::vector<size_t>::iterator begin, std::vector<size_t>::iterator end, boost::mt19937& generator) const
+    //the working array holds the cells from index base on (a working window, see WorkingWindow)
+    void setWorkingBase(size_t base)
+    {
+      m_workingBase = base;
+    }
+
+    inline int32_t& working(size_t index) const
+    {
+      return m_workingIDs[index - m_workingBase];
+    }
+
+    //states the stepper reads
+    const int32_t* states() const
+    {
+      return m_currentIDs;
+    }
+
+    //don't change cells that are already recrystallized
+    inline void transformed(size_t index, CellularAutomata::VariateStream&, Reduction&) const
+    {
+      working(index) = m_currentIDs[index];
+    }
+
+    //cells out of reach of every recrystallized cell can only nucleate
+    inline void isolated(size_t index, CellularAutomata::VariateStream& generator, Reduction& reduction) const
+    {
+      computeBase(index, static_cast<const size_t*>(NULL), static_cast<const size_t*>(NULL), generator, reduction);
+    }
+
+    //otherwise determine the next state from the cell's neighbors
+    inline void update(size_t index, const size_t* neighbors, size_t count, CellularAutomata::VariateStream& generator, Reduction& reduction) const
     {
-      //check if any neighbors are recrystallized
-      std::vector<size_t> goodNeighbors;
-      for(std::vector<size_t>::iterator iter = begin; iter != end; ++iter)
+      computeBase(index, neighbors, neighbors + count, generator, reduction);
+    }
+
+    template<typename Iterator>
+    inline void computeBase(size_t index, Iterator begin, Iterator end, CellularAutomata::VariateStream& generator, Reduction& reduction) const
+    {
+      //check if any neighbors are recrystallized (every neighborhood starts with the face neighbors, 2 per axis in the lattice or plane)
+      size_t goodNeighbors[26];
+      size_t numGood = 0;
+      for(Iterator iter = begin; iter != end; ++iter)
       {
         if(0 != m_currentIDs[*iter])
-        { goodNeighbors.push_back(*iter); }
+        {
+          goodNeighbors[numGood++] = *iter;
+          size_t neighbor = iter - begin;
+
+          //faces between this unrecrystallized cell and recrystallized neighbors are part of the current interface
+          if(neighbor < m_faceNeighbors) { reduction.interfaceFaces[neighbor / 2]++; }
+        }
       }
 
-      if(0 == goodNeighbors.size())
+      if(0 == numGood)
       {
-        //if no immediate neighbors are recrystalized, allow random chance to create nucluie
-        boost::uniform_real<> distribution(0, 1);
-        boost::variate_generator<boost::mt19937&, boost::uniform_real<> > seedGen(generator, distribution);
-        if(seedGen() <= m_nucleationRate)
+        //if no immediate neighbors are recrystalized, allow random chance to create nucluie (heterogeneous nucleation runs with a rate of 0 and samples its sites separately)
+        if(0 != m_nucleationThreshold && generator.passes(m_nucleationThreshold))
         {
           //if extended neighborhood is empty allow nucleation, otherwise supress
-          std::vector<size_t> extendedNeighbors = m_lattice->ExtendedMoore(index);
-          bool goodSeed = true;
-          for(std::vector<size_t>::iterator iter = extendedNeighbors.begin(); iter != extendedNeighbors.end(); ++iter)
-          {
-            if(0 != m_currentIDs[*iter])
-            {
-              goodSeed = false;
-              break;
-            }
-          }
-
-          if(goodSeed)
+          if(!suppressed(index))
           {
-            m_workingIDs[index] = m_grainCount->fetch_and_increment() + 1;
+            m_nuclei->push_back(index);
+            working(index) = -1;//placeholder until ids are assigned
             m_updateTime[index] = *m_time;
+            if(NULL != m_changes) { m_changes->local().push_back(index); }
           }
           else
           {
-            ++(*m_unrecrystalizedCount);
-            m_workingIDs[index] = 0;
+            reduction.unrecrystallized++;
+            working(index) = 0;
           }
         }
         else
         {
-          ++(*m_unrecrystalizedCount);
-          m_workingIDs[index] = 0;
+          reduction.unrecrystallized++;
+          working(index) = 0;
         }
       }
       else
       {
         //if neighbors are recrystallized, choose one at random to join
-        boost::uniform_int<> distribution(0, goodNeighbors.size() - 1);//range is inclusive
-        boost::variate_generator<boost::mt19937&, boost::uniform_int<> > indexGen(generator, distribution);
-        m_workingIDs[index] = m_currentIDs[goodNeighbors[indexGen()]];
+        working(index) = m_currentIDs[goodNeighbors[generator.below(static_cast<uint32_t>(numGood))]];
         m_updateTime[index] = *m_time;
+        if(NULL != m_changes) { m_changes->local().push_back(index); }
+        if(NULL != m_statistics)
+        {
+          size_t x, y, z;
+          if(NULL != m_domain) { m_domain->ToTuple(index, x, y, z); }
+          else { m_lattice->ToTuple(index, x, y, z); }
+          m_statistics->local().add(working(index), x, y, z);
+        }
       }
     }
 
-    void computeVonNeuman(size_t start, size_t end, boost::mt19937& generator) const
+    //true if a cell in the 2 shell neighborhood of a cell is recrystallized (the 5 x 5 x 5 window, 5 x 5 on a single slice,
+    //of an unmasked lattice is scanned in place)
+    inline bool suppressed(size_t index) const
     {
-      for (size_t i = start; i < end; i++)
+      if(NULL == m_domain)
       {
-        //don't change cells that are already recrystallized
-        if(0 != m_currentIDs[i])
+        const size_t dimX = m_lattice->dimension(0);
+        const size_t dimY = m_lattice->dimension(1);
+        const size_t dimZ = m_lattice->dimension(2);
+        size_t x = index % dimX;
+        size_t y = (index / dimX) % dimY;
+        size_t z = index / (dimX * dimY);
+        size_t depth = 1 == dimZ ? 1 : 5;
+        for(size_t dz = 0; dz < depth; dz++)
         {
-          m_workingIDs[i] = m_currentIDs[i];
-          continue;
+          size_t plane = 1 == dimZ ? 0 : (z + dimZ * 2 + dz - 2) % dimZ;
+          for(size_t dy = 0; dy < 5; dy++)
+          {
+            const int32_t* row = m_currentIDs + (plane * dimY + (y + dimY * 2 + dy - 2) % dimY) * dimX;
+            for(size_t dx = 0; dx < 5; dx++)
+            {
+              if(0 != row[(x + dimX * 2 + dx - 2) % dimX]) { return true; }
+            }
+          }
         }
+        return false;
+      }
 
-        //otherwise get cell neighbors and determine next state
-        std::vector<size_t> neighborList = m_lattice->VonNeumann(i);
-        computeBase(i, neighborList.begin(), neighborList.end(), generator);
+      size_t extendedNeighbors[CellularAutomata::Lattice::MaxExtendedNeighbors];
+      size_t count = m_domain->ExtendedNeighbors(index, extendedNeighbors);
+      for(size_t n = 0; n < count; n++)
+      {
+        if(0 != m_currentIDs[extendedNeighbors[n]]) { return true; }
       }
+      return false;
     }
 
-    void compute18Cell(size_t start, size_t end, boost::mt19937& generator) const
+    //number of Moore neighbors a masked domain needs for a neighborhood
+    static size_t DomainWidth(int neighborhood)
     {
-      for (size_t i = start; i < end; i++)
+      switch(neighborhood)
       {
-        //don't change cells that are already recrystallized
-        if(0 != m_currentIDs[i])
-        {
-          m_workingIDs[i] = m_currentIDs[i];
-          continue;
-        }
-
-        //otherwise get cell neighbors and determine next state
-        std::vector<size_t> neighborList = m_lattice->EighteenCell(i);
-        computeBase(i, neighborList.begin(), neighborList.end(), generator);
+        case VON_NEUMAN: return 6;
+        case EIGHT_CELL: return 18;
+        case EIGHTEEN_CELL: return 18;
+        case SQUARE_FOUR: return 6;
+        case SQUARE_EIGHT: return 18;
+        case HEXAGONAL: return 18;
+        default: return 26;
       }
     }
 
-    void computeMoore(size_t start, size_t end, boost::mt19937& generator) const
+    //neighborhood the kernel runs: single slices without a mask use the in plane neighborhood for the neighborhoods that have an
+    //equivalent (Von Neumann is exactly the 4 cell square, Moore reaches the 8 cell square's neighbors 3 times each)
+    static int KernelNeighborhood(const CellularAutomata::Lattice& lattice, const CellularAutomata::Domain* domain, int neighborhood)
     {
-      for (size_t i = start; i < end; i++)
-      {
-        //don't change cells that are already recrystallized
-        if(0 != m_currentIDs[i])
-        {
-          m_workingIDs[i] = m_currentIDs[i];
-          continue;
-        }
+      if(NULL != domain || !lattice.Is2D()) { return neighborhood; }
+      if(VON_NEUMAN == neighborhood) { return SQUARE_FOUR; }
+      if(MOORE == neighborhood) { return SQUARE_EIGHT; }
+      return neighborhood;
+    }
 
-        //otherwise get cell neighbors and determine next state
-        std::vector<size_t> neighborList = m_lattice->Moore(i);
-        computeBase(i, neighborList.begin(), neighborList.end(), generator);
-      }
+    //true for the neighborhoods that only exist on single slices
+    static bool IsPlanar(int neighborhood)
+    {
+      return SQUARE_FOUR == neighborhood || SQUARE_EIGHT == neighborhood || HEXAGONAL == neighborhood;
     }
 
-    void compute8Cell(size_t start, size_t end, boost::mt19937& generator) const
+    //stepper of a kernel neighborhood (see KernelNeighborhood)
+    static Stepper* NewStepper(const CellularAutomata::Lattice& lattice, const CellularAutomata::Domain* domain, int neighborhood, const CellularAutomata::EnginePlan& plan)
     {
-      //wrap generator in uniform interger distribution for selecting neighborhood variant
-      boost::uniform_int<> distribution(0, 5);
-      boost::variate_generator<boost::mt19937&, boost::uniform_int<> > indexGen(generator, distribution);
-      for (size_t i = start; i < end; i++)
+      return CellularAutomata::NewStepper<RecrystalizeVolumeImpl>(neighborhood, lattice, domain, plan);
+    }
+
+  private:
+    CellularAutomata::Lattice* m_lattice;
+    const CellularAutomata::Domain* m_domain;
+    int32_t* m_currentIDs;
+    int32_t* m_workingIDs;
+    size_t m_workingBase;//lattice index of m_workingIDs[0]
+    uint32_t* m_updateTime;
+    uint32_t* m_time;
+    NucleusList* m_nuclei;
+    ChangeBuffers* m_changes;
+    FeatureAccumulators* m_statistics;
+    uint64_t m_nucleationThreshold;//nucleation rate as a 32 bit variate threshold
+    size_t m_faceNeighbors;//leading neighbors that share a face with the cell (4 for single slice neighborhoods)
+};
+
+//position of the lowest set bit (word must be non zero)
+static inline size_t lowestSetBit(uint64_t word)
+{
+#if defined(_MSC_VER)
+  unsigned long bit;
+  _BitScanForward64(&bit, word);
+  return bit;
+#else
+  return __builtin_ctzll(word);
+#endif
+}
+
+/**
+ * @brief The RecrystalizeVolumeBitSliceImpl class advances 64 independent replicas of the lattice per time step. Bit b of
+ * each cell's word is the recrystallized state of the cell in replica b, so growth is a bitwise OR over the neighbor words
+ * and nucleation is a per bit mask. Grain ids are not tracked, only the number of recrystallized cells in each replica
+ * (counted per task and reduced after the step).
+ */
+class RecrystalizeVolumeBitSliceImpl
+{
+  public:
+    static const size_t Replicas = 64;
+
+    //cells recrystallized during a step in each replica
+    struct Reduction
+    {
+      Reduction()
       {
-        //don't change cells that are already recrystallized
-        if(0 != m_currentIDs[i])
-        {
-          m_workingIDs[i] = m_currentIDs[i];
-          continue;
-        }
+        std::fill(newCounts, newCounts + Replicas, 0);
+      }
 
-        //otherwise get cell neighbors and determine next state
-        std::vector<size_t> neighborList = m_lattice->EightCell(i, indexGen());
-        computeBase(i, neighborList.begin(), neighborList.end(), generator);
+      void merge(const Reduction& other)
+      {
+        for(size_t b = 0; b < Replicas; b++) { newCounts[b] += other.newCounts[b]; }
       }
+
+      size_t newCounts[Replicas];
+    };
+
+    RecrystalizeVolumeBitSliceImpl(CellularAutomata::Lattice* cellLattice, uint64_t* currentState, uint64_t* workingState, int neighborhoodType, CellularAutomata::ThreadLocal<Reduction>* reductions, float nucleationRate, uint64_t seed) :
+      m_lattice(cellLattice),
+      m_currentState(currentState),
+      m_workingState(workingState),
+      m_neighborhood(neighborhoodType),
+      m_reductions(reductions),
+      m_nucleationRate(nucleationRate),
+      m_logFailure(std::log(1.0 - static_cast<double>(nucleationRate))),
+      m_seed(seed)
+    {}
+
+    virtual ~RecrystalizeVolumeBitSliceImpl() {}
+
+    //64 independent random bits
+    static inline uint64_t randomWord(CellularAutomata::VariateStream& generator)
+    {
+      uint64_t high = generator();
+      return (high << 32) | static_cast<uint64_t>(generator());
     }
 
-    void compute14Cell(size_t start, size_t end, boost::mt19937& generator) const
+    //number of failed nucleation trials before the next successful one (geometric distribution sampled by inversion)
+    inline uint64_t nucleationSkip(CellularAutomata::VariateStream& generator) const
     {
-      //wrap generator in uniform interger distribution for selecting neighborhood variant
-      boost::uniform_int<> distribution(0, 3);
-      boost::variate_generator<boost::mt19937&, boost::uniform_int<> > indexGen(generator, distribution);
-      for (size_t i = start; i < end; i++)
-      {
-        //don't change cells that are already recrystallized
-        if(0 != m_currentIDs[i])
-        {
-          m_workingIDs[i] = m_currentIDs[i];
-          continue;
-        }
+      const uint64_t never = static_cast<uint64_t>(1) << 62;
+      if(m_nucleationRate <= 0.0f) { return never; }
+      if(m_nucleationRate >= 1.0f) { return 0; }
+      double skip = std::floor(std::log(generator.uniform()) / m_logFailure);
+      if(skip >= static_cast<double>(never)) { return never; }
+      return static_cast<uint64_t>(skip);
+    }
+
+    //for every bit independently choose which of the 4 masks to take the bit from
+    inline uint64_t select4(const uint64_t* masks, CellularAutomata::VariateStream& generator) const
+    {
+      uint64_t r0 = randomWord(generator);
+      uint64_t r1 = randomWord(generator);
+      return (masks[0] & ~r1 & ~r0) | (masks[1] & ~r1 & r0) | (masks[2] & r1 & ~r0) | (masks[3] & r1 & r0);
+    }
 
-        //otherwise get cell neighbors and determine next state
-        std::vector<size_t> neighborList = m_lattice->FourteenCell(i, indexGen());
-        computeBase(i, neighborList.begin(), neighborList.end(), generator);
+    //for every bit independently choose which of the 6 masks to take the bit from (3 bit values of 6 or 7 are redrawn)
+    inline uint64_t select6(const uint64_t* masks, CellularAutomata::VariateStream& generator) const
+    {
+      uint64_t result = 0;
+      uint64_t pending = ~static_cast<uint64_t>(0);
+      while(0 != pending)
+      {
+        uint64_t r0 = randomWord(generator);
+        uint64_t r1 = randomWord(generator);
+        uint64_t r2 = randomWord(generator);
+        uint64_t accepted = pending & ~(r2 & r1);
+        uint64_t selected = (masks[0] & ~r2 & ~r1 & ~r0) | (masks[1] & ~r2 & ~r1 & r0) | (masks[2] & ~r2 & r1 & ~r0)
+                            | (masks[3] & ~r2 & r1 & r0) | (masks[4] & r2 & ~r1 & ~r0) | (masks[5] & r2 & ~r1 & r0);
+        result |= accepted & selected;
+        pending &= ~accepted;
       }
+      return result;
     }
 
-    void compute20Cell(size_t start, size_t end, boost::mt19937& generator) const
+    //union of recrystallized replicas over the (per replica) neighborhood, given the states of the 26 Moore neighbors (and
+    //the parity of the cell's row for the hexagonal neighborhood)
+    inline uint64_t neighborhoodState(const uint64_t* moore, size_t rowParity, CellularAutomata::VariateStream& generator) const
     {
-      //wrap generator in uniform interger distribution for selecting neighborhood variant
-      boost::uniform_int<> distribution(0, 3);
-      boost::variate_generator<boost::mt19937&, boost::uniform_int<> > indexGen(generator, distribution);
-      for (size_t i = start; i < end; i++)
+      uint64_t faces = moore[0] | moore[1] | moore[2] | moore[3] | moore[4] | moore[5];
+      uint64_t variants[6];
+      switch(m_neighborhood)
       {
-        //don't change cells that are already recrystallized
-        if(0 != m_currentIDs[i])
+        case RecrystalizeVolumeImpl::VON_NEUMAN:
+          return faces;
+
+        case RecrystalizeVolumeImpl::EIGHT_CELL:
+          for(size_t v = 0; v < 6; v++)
+          { variants[v] = moore[EightCellEdges[v][0]] | moore[EightCellEdges[v][1]]; }
+          return faces | select6(variants, generator);
+
+        case RecrystalizeVolumeImpl::FOURTEEN_CELL:
+          for(size_t v = 0; v < 4; v++)
+          {
+            variants[v] = 0;
+            for(size_t j = 0; j < 8; j++)
+            { variants[v] |= moore[FourteenCellCorners[v][j]]; }
+          }
+          return faces | select4(variants, generator);
+
+        case RecrystalizeVolumeImpl::EIGHTEEN_CELL:
+        case RecrystalizeVolumeImpl::TWENTY_CELL:
         {
-          m_workingIDs[i] = m_currentIDs[i];
-          continue;
+          uint64_t edges = 0;
+          for(size_t j = 6; j < 18; j++)
+          { edges |= moore[j]; }
+          if(RecrystalizeVolumeImpl::EIGHTEEN_CELL == m_neighborhood)
+          { return faces | edges; }
+          for(size_t v = 0; v < 4; v++)
+          { variants[v] = moore[TwentyCellCorners[v][0]] | moore[TwentyCellCorners[v][1]]; }
+          return faces | edges | select4(variants, generator);
+        }
+
+        case RecrystalizeVolumeImpl::SQUARE_FOUR:
+          return moore[0] | moore[1] | moore[2] | moore[3];
+
+        case RecrystalizeVolumeImpl::HEXAGONAL:
+        {
+          uint64_t all = 0;
+          for(size_t j = 0; j < 6; j++)
+          { all |= moore[HexagonalNeighbors[rowParity][j]]; }
+          return all;
         }
 
-        //otherwise get cell neighbors and determine next state
-        std::vector<size_t> neighborList = m_lattice->TwentyCell(i, indexGen());
-        computeBase(i, neighborList.begin(), neighborList.end(), generator);
+        case RecrystalizeVolumeImpl::SQUARE_EIGHT:
+        case RecrystalizeVolumeImpl::MOORE:
+        default:
+        {
+          uint64_t all = 0;
+          for(size_t j = 0; j < 26; j++)
+          { all |= moore[j]; }
+          return all;
+        }
       }
     }
 
-    void compute(size_t start, size_t end) const
+    //start must be a multiple of RecrystalizeVolumeImpl::BlockSize
+    void compute(size_t start, size_t end, Reduction& reduction) const
     {
-      //create random number generator + initialize (parallel threads may call simultaneously so rand() or time alone are insufficient for different seeds)
-      boost::mt19937 generator( static_cast<size_t>( QDateTime::currentMSecsSinceEpoch() * end + start ) );
+      for(size_t blockStart = start; blockStart < end; blockStart += RecrystalizeVolumeImpl::BlockSize)
+      { computeBlock(blockStart, std::min(blockStart + RecrystalizeVolumeImpl::BlockSize, end), reduction); }
+    }
 
-      switch(m_neighborhood)
+    void computeBlock(size_t start, size_t end, Reduction& reduction) const
+    {
+      //create random number stream for this block of cells (seeded from the step seed + block so runs are reproducible)
+      CellularAutomata::VariateStream generator(CellularAutomata::StreamSeed(m_seed, start / RecrystalizeVolumeImpl::BlockSize));
+
+      //nucleation trials are a single stream over (cell, replica) pairs, so only the successful ones need to be drawn
+      uint64_t nextNucleus = static_cast<uint64_t>(start) * Replicas + nucleationSkip(generator);
+
+      size_t neighborList[26];
+      size_t extendedNeighbors[CellularAutomata::Lattice::MaxExtendedNeighbors];
+      uint64_t moore[26];
+      for (size_t i = start; i < end; i++)
       {
-        case VON_NEUMAN:
-          computeVonNeuman(start, end, generator);
-          break;
+        //collect nucleation events for this cell (the stream has to advance even for fully recrystallized cells)
+        uint64_t cellStart = static_cast<uint64_t>(i) * Replicas;
+        uint64_t nucleation = 0;
+        while(nextNucleus < cellStart + Replicas)
+        {
+          nucleation |= static_cast<uint64_t>(1) << (nextNucleus - cellStart);
+          nextNucleus += 1 + nucleationSkip(generator);
+        }
 
-        case EIGHT_CELL:
-          compute8Cell(start, end, generator);
-          break;
+        //don't change cells that are already recrystallized in every replica
+        uint64_t current = m_currentState[i];
+        if(0 == ~current)
+        {
+          m_workingState[i] = current;
+          continue;
+        }
 
-        case FOURTEEN_CELL:
-          compute14Cell(start, end, generator);
-          break;
+        //grow into replicas with a recrystallized neighbor
+        m_lattice->Neighbors<size_t>(i, 26, neighborList);
+        for(size_t j = 0; j < 26; j++)
+        { moore[j] = m_currentState[neighborList[j]]; }
+        size_t rowParity = (i / m_lattice->dimension(0)) % 2;
+        uint64_t grown = neighborhoodState(moore, rowParity, generator) & ~current;
 
-        case EIGHTEEN_CELL:
-          compute18Cell(start, end, generator);
-          break;
+        //nucleate in the remaining replicas if the extended neighborhood is empty
+        nucleation &= ~(current | grown);
+        if(0 != nucleation)
+        {
+          size_t count = m_lattice->ExtendedNeighbors(i, extendedNeighbors);
+          for(size_t j = 0; j < count; j++)
+          { nucleation &= ~m_currentState[extendedNeighbors[j]]; }
+        }
 
-        case TWENTY_CELL:
-          compute20Cell(start, end, generator);
-          break;
+        uint64_t updated = current | grown | nucleation;
+        m_workingState[i] = updated;
 
-        case MOORE:
-          computeMoore(start, end, generator);
-          break;
+        //count newly recrystallized cells in each replica
+        for(uint64_t changed = updated & ~current; 0 != changed; changed &= changed - 1)
+        { reduction.newCounts[lowestSetBit(changed)]++; }
       }
     }
 
 #ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    //range is over blocks of cells, the task's counts are added to the thread's
     void operator()(const tbb::blocked_range<size_t>& r) const
     {
-      compute(r.begin(), r.end());
+      Reduction reduction;
+      compute(r.begin() * RecrystalizeVolumeImpl::BlockSize, std::min(r.end() * RecrystalizeVolumeImpl::BlockSize, m_lattice->size()), reduction);
+      m_reductions->local().merge(reduction);
     }
 #endif
   private:
     CellularAutomata::Lattice* m_lattice;
-    int32_t* m_currentIDs;
-    int32_t* m_workingIDs;
-    uint32_t* m_updateTime;
+    uint64_t* m_currentState;
+    uint64_t* m_workingState;
     int m_neighborhood;
-
-#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
-    tbb::atomic<size_t>* m_unrecrystalizedCount;
-    tbb::atomic<int32_t>* m_grainCount;
-#elif
-    size_t* m_unrecrystalizedCount;
-    int32_t* m_grainCount;
-#endif
-    uint32_t* m_time;
+    CellularAutomata::ThreadLocal<Reduction>* m_reductions;
     float m_nucleationRate;
+    double m_logFailure;
+    uint64_t m_seed;
 };
 
-#define INIT_SYNTH_VOLUME_CHECK(var, errCond) \
-  if (m_##var <= 0) { QString ss = QObject::tr(":%1 must be a value > 0\n").arg( #var); notifyErrorMessage(getHumanLabel(), ss, errCond);}
+// -----------------------------------------------------------------------------
+// Rebuilds the interface faces + grain count of every recorded state of a simulation from the recrystallization times
+// (a face is part of the interface from the time its first cell recrystallizes until its second cell does), only faces
+// between cells of the domain are counted if it isn't NULL
+// -----------------------------------------------------------------------------
+static void RebuildInterfaceHistory(CellularAutomata::Lattice& lattice, const CellularAutomata::Domain* domain, const int32_t* ids, const uint32_t* times, CellularAutomata::SimulationState& state)
+{
+  const size_t numStates = state.history.size();
+  const uint32_t never = std::numeric_limits<uint32_t>::max();
+  const size_t dims[3] = { lattice.dimension(0), lattice.dimension(1), lattice.dimension(2) };
+
+  //accumulate changes per state and direction, then sum
+  std::vector<int64_t> faceChanges(3 * (numStates + 1), 0);
+  std::vector<int64_t> grainChanges(numStates + 1, 0);
+  std::vector<uint32_t> nucleationTimes(state.grainCount + 1, never);
+  size_t index = 0;
+  for(size_t z = 0; z < dims[2]; z++)
+  {
+    for(size_t y = 0; y < dims[1]; y++)
+    {
+      for(size_t x = 0; x < dims[0]; x++, index++)
+      {
+        uint32_t time = 0 != ids[index] ? times[index] : never;
+        if(0 != ids[index] && ids[index] <= state.grainCount)
+        { nucleationTimes[ids[index]] = std::min(nucleationTimes[ids[index]], time); }
+
+        //faces with the next cell along each axis
+        size_t neighbors[3] = { lattice.ToIndex(x + 1 == dims[0] ? 0 : x + 1, y, z), lattice.ToIndex(x, y + 1 == dims[1] ? 0 : y + 1, z), lattice.ToIndex(x, y, z + 1 == dims[2] ? 0 : z + 1) };
+        for(size_t d = 0; d < 3; d++)
+        {
+          if(NULL != domain && (!domain->contains(index) || !domain->contains(neighbors[d]))) { continue; }//faces with cells outside the mask aren't interface
+          uint32_t neighborTime = 0 != ids[neighbors[d]] ? times[neighbors[d]] : never;
+          uint32_t first = std::min(time, neighborTime);
+          uint32_t last = std::max(time, neighborTime);
+          if(first == last || first >= numStates) { continue; }
+          faceChanges[3 * first + d]++;
+          faceChanges[3 * std::min<size_t>(last, numStates) + d]--;
+        }
+      }
+    }
+  }
+  for(size_t i = 1; i < nucleationTimes.size(); i++)
+  {
+    if(nucleationTimes[i] < numStates)
+    { grainChanges[nucleationTimes[i]]++; }
+  }
+
+  state.interfaceFaces.assign(3 * numStates, 0);
+  state.grainCounts.assign(numStates, 0);
+  int64_t faces[3] = {0, 0, 0};
+  int64_t grains = 0;
+  for(size_t t = 0; t < numStates; t++)
+  {
+    for(size_t d = 0; d < 3; d++)
+    {
+      faces[d] += faceChanges[3 * t + d];
+      state.interfaceFaces[3 * t + d] = static_cast<uint64_t>(faces[d]);
+    }
+    grains += grainChanges[t];
+    state.grainCounts[t] = static_cast<int32_t>(grains);
+  }
+}
 
 // -----------------------------------------------------------------------------
-//
+// Heterogeneous nucleation for one time step: a Poisson distributed number of attempts (with mean attempts) is drawn
+// from the weighted sites, so the cost is proportional to the number of nuclei instead of the volume. An attempt
+// succeeds under the same conditions as in the kernel (the cell didn't grow during the step and its extended Moore
+// neighborhood is unrecrystallized). The count and the sites are drawn from the random stream of seed. Sites are lattice
+// indices, the ids are compact if domain isn't NULL. Returns the number of new nuclei.
 // -----------------------------------------------------------------------------
-RecrystalizeVolume::RecrystalizeVolume() :
-  AbstractFilter(),
-  m_DataContainerName(DREAM3D::Defaults::SyntheticVolumeDataContainerName),
-  m_CellAttributeMatrixName(DREAM3D::Defaults::CellAttributeMatrixName),
-  m_CellFeatureAttributeMatrixName(DREAM3D::Defaults::CellFeatureAttributeMatrixName),
-  m_CellEnsembleAttributeMatrixName(DREAM3D::Defaults::CellEnsembleAttributeMatrixName),
-  m_NucleationRate(0.0001f),
-  m_Neighborhood(0),
-  m_FeatureIds(NULL),
-  m_FeatureIdsArrayName(DREAM3D::CellData::FeatureIds),
-  m_RecrystallizationTime(NULL),
-  m_RecrystallizationTimeArrayName("RecrystallizationTime"),
-  m_Active(NULL),
-  m_ActiveArrayName(DREAM3D::FeatureData::Active),
-  m_RecrystallizationHistory(NULL),
-  m_RecrystallizationHistoryArrayName("RecrystallizationHistory"),
-  m_Avrami(NULL),
-  m_AvramiArrayName("AvaramiParameters")
+static size_t NucleateFromSites(CellularAutomata::Lattice& lattice, const CellularAutomata::Domain* domain, const CellularAutomata::AliasTable& sites, double attempts, uint64_t seed, const int32_t* currentIDs, int32_t* workingIDs,
+                                uint32_t* recrstTime, uint32_t time, NucleusList& nuclei, ChangeBuffers* changes)
 {
-  m_Dimensions.x = 128;
-  m_Dimensions.y = 128;
-  m_Dimensions.z = 128;
+  CellularAutomata::VariateStream generator(seed);
+  boost::poisson_distribution<size_t, double> countDistribution(attempts);
+  boost::variate_generator<CellularAutomata::VariateStream&, boost::poisson_distribution<size_t, double> > countGen(generator, countDistribution);
+
+  size_t created = 0;
+  size_t count = countGen();
+  size_t extendedNeighbors[CellularAutomata::Lattice::MaxExtendedNeighbors];
+  for(size_t a = 0; a < count; a++)
+  {
+    //cells that are recrystallized, grew during this step or already nucleated are skipped
+    size_t index = sites.sample(generator.uniform());
+    if(NULL != domain)
+    {
+      index = domain->compactIndex(index);
+      if(domain->size() == index) { continue; }
+    }
+    if(0 != currentIDs[index] || 0 != workingIDs[index]) { continue; }
 
-  m_Resolution.x = 0.25f;
-  m_Resolution.y = 0.25f;
-  m_Resolution.z = 0.25f;
+    //if extended neighborhood is empty allow nucleation, otherwise supress
+    size_t numNeighbors = NULL != domain ? domain->ExtendedNeighbors(index, extendedNeighbors) : lattice.ExtendedNeighbors(index, extendedNeighbors);
+    bool goodSeed = true;
+    for(size_t n = 0; n < numNeighbors; n++)
+    {
+      if(0 != currentIDs[extendedNeighbors[n]])
+      {
+        goodSeed = false;
+        break;
+      }
+    }
+    if(!goodSeed) { continue; }
 
-  m_Origin.x = 0.0f;
-  m_Origin.y = 0.0f;
-  m_Origin.z = 0.0f;
-  setupFilterParameters();
+    nuclei.push_back(index);
+    workingIDs[index] = -1;//placeholder until ids are assigned
+    recrstTime[index] = time;
+    if(NULL != changes) { changes->local().push_back(index); }
+    created++;
+  }
+  return created;
 }
 
 // -----------------------------------------------------------------------------
-//
+// Assigns the unrecrystallized cells to the nearest recrystallized cell's grain (city block distance through the face
+// neighbors across the periodic boundaries, like the simulation) at the given time: a breadth first search from every recrystallized cell
+// in index order. Cells outside the domain (if it isn't NULL) are neither filled nor passed through, so cells of a part
+// of the domain without any grain stay unrecrystallized. The assigned cells are appended to filled.
 // -----------------------------------------------------------------------------
-RecrystalizeVolume::~RecrystalizeVolume()
+static void FillNearestGrain(CellularAutomata::Lattice& lattice, const CellularAutomata::Domain* domain, int32_t* ids, uint32_t* times, uint32_t time, std::vector<size_t>& filled)
 {
+  const size_t numCells = lattice.size();
+  std::vector<bool> active(numCells, NULL == domain);
+  if(NULL != domain)
+  {
+    for(size_t c = 0; c < domain->size(); c++)
+    { active[domain->fullIndex(c)] = true; }
+  }
+
+  //the queue holds the recrystallized cells followed by the filled cells in the order they were reached
+  std::vector<size_t> queue;
+  for(size_t i = 0; i < numCells; i++)
+  {
+    if(0 != ids[i] && active[i]) { queue.push_back(i); }
+  }
+  size_t seeds = queue.size();
+
+  //a single slice's z neighbors are the cell itself (already assigned)
+  size_t neighbors[6];
+  for(size_t head = 0; head < queue.size(); head++)
+  {
+    size_t i = queue[head];
+    lattice.Neighbors<size_t>(i, 6, neighbors);
+    for(size_t n = 0; n < 6; n++)
+    {
+      size_t neighbor = neighbors[n];
+      if(0 != ids[neighbor] || !active[neighbor]) { continue; }
+      ids[neighbor] = ids[i];
+      times[neighbor] = time;
+      queue.push_back(neighbor);
+    }
+  }
+  filled.insert(filled.end(), queue.begin() + seeds, queue.end());
 }
 
 // -----------------------------------------------------------------------------
-//
+// Hands the cells that changed since the last frame (with their current ids) to the frame writer
 // -----------------------------------------------------------------------------
-void RecrystalizeVolume::setupFilterParameters()
+static void WriteFrame(CellularAutomata::FrameWriter* frames, const CellularAutomata::Domain* domain, ChangeBuffers& changes, const int32_t* ids, const CellularAutomata::SimulationState& state)
 {
-  FilterParameterVector parameters;
-  parameters.push_back(SeparatorFilterParameter::New(Required Information, FilterParameter::Uncategorized));
-  parameters.push_back(;
+  std::vector<size_t> indices;
+  for(ChangeBuffers::iterator iter = changes.begin(); iter != changes.end(); ++iter)
   {
-    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
-    parameter->setHumanLabel("Neighborhood Type");
-    parameter->setPropertyName("Neighborhood");
-    
-    QVector<QString> choices;
-    choices.push_back("Von Neumann (6 cell) [octohedra]");
-    choices.push_back("8 cell [sphere]");
-    choices.push_back("14 cell [~superellipsoid]");
-    choices.push_back("18 cell [cubeoctahedron]");
-    choices.push_back("20 cell [~truncated cube]");
-    choices.push_back("Moore (26 cell) [cube]");
-    parameter->setChoices(choices);
-    parameter->setAdvanced(false);
-    parameters.push_back(parameter);
+    indices.insert(indices.end(), iter->begin(), iter->end());
+    iter->clear();
   }
-  parameters.push_back(StringFilterParameter::New("New DataContainer Name", "DataContainerName", getDataContainerName(), FilterParameter::Uncategorized));
-  parameters.push_back(StringFilterParameter::New("New Cell Attribute Matrix Name", "CellAttributeMatrixName", getCellAttributeMatrixName(), FilterParameter::Uncategorized));
-  parameters.push_back(StringFilterParameter::New("New Cell Feature Attribute Matrix Name", "CellFeatureAttributeMatrixName", getCellFeatureAttributeMatrixName(), FilterParameter::Uncategorized));
-  parameters.push_back(StringFilterParameter::New("New Cell Ensemble Attribute Matrix Name", "CellEnsembleAttributeMatrixName", getCellEnsembleAttributeMatrixName(), FilterParameter::Uncategorized));
-  parameters.push_back(StringFilterParameter::New("Feature Ids Array Name", "FeatureIdsArrayName", getFeatureIdsArrayName(), FilterParameter::Uncategorized));
-  parameters.push_back(StringFilterParameter::New("Recrystallization Time Array Name", "RecrystallizationTimeArrayName", getRecrystallizationTimeArrayName(), FilterParameter::Uncategorized));
-  parameters.push_back(StringFilterParameter::New("Recrystallization History Array Name", "RecrystallizationHistoryArrayName", getRecrystallizationHistoryArrayName(), FilterParameter::Uncategorized));
-  parameters.push_back(StringFilterParameter::New("Active Array Name", "ActiveArrayName", getActiveArrayName(), FilterParameter::Uncategorized));
-  parameters.push_back(StringFilterParameter::New("Avrami Parameter Array Name", "AvramiArrayName", getAvramiArrayName(), FilterParameter::Uncategorized));
-  parameters.push_back(;
-                       parameters.push_back(;
-                                            parameters.push_back(;
-                                                setFilterParameters(parameters);
+  std::sort(indices.begin(), indices.end());
+  std::vector<int32_t> frameIds(indices.size());
+  for(size_t i = 0; i < indices.size(); i++)
+  { frameIds[i] = ids[indices[i]]; }
+  if(NULL != domain)
+  {
+    for(size_t i = 0; i < indices.size(); i++)
+    { indices[i] = domain->fullIndex(indices[i]); }
+  }
+  frames->write(state.iteration, state.timeStep - 1, indices, frameIds);
 }
 
 // -----------------------------------------------------------------------------
-//
+// Numbers the nuclei of a step in index order (so ids don't depend on thread scheduling) and starts their features. The
+// working array holds the cells from index workingBase on.
 // -----------------------------------------------------------------------------
-                                          void RecrystalizeVolume::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+static void NumberNuclei(NucleusList& nuclei, int32_t* workingIDs, size_t workingBase, const CellularAutomata::Lattice& lattice, const CellularAutomata::Domain* domain, const uint32_t* recrstTime,
+                         CellularAutomata::FeatureStatistics* statistics, CellularAutomata::SimulationState& state)
 {
-  reader->openFilterGroup(this, index);
-  setNucleationRate(reader->readValue("NucleationRate", getNucleationRate() ) );
-  setNeighborhood(reader->readValue("Neighborhood", getNeighborhood() ) );
-  setDataContainerName(reader->readString("DataContainerName", getDataContainerName() ) );
-  setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName() ) );
-  setCellFeatureAttributeMatrixName(reader->readString("CellFeatureAttributeMatrixName", getCellFeatureAttributeMatrixName() ) );
+  std::sort(nuclei.begin(), nuclei.end());
+  for(NucleusList::iterator iter = nuclei.begin(); iter != nuclei.end(); ++iter)
+  {
+    workingIDs[*iter - workingBase] = ++state.grainCount;
+    if(NULL != statistics)
+    {
+      size_t x, y, z;
+      if(NULL != domain) { domain->ToTuple(*iter, x, y, z); }
+      else { lattice.ToTuple(*iter, x, y, z); }
+      statistics->add(state.grainCount, x, y, z);
+      statistics->nucleate(state.grainCount, *iter, recrstTime[*iter]);
+    }
+  }
+  nuclei.clear();
+}
+
+/**
+ * @brief The WorkingWindow class steps an unmasked 3D lattice without a lattice sized working array. The blocks of a step
+ * run in chunks (in index order), each chunk's next state goes to a window of planes and cells are committed to the
+ * current array in place as soon as no later cell of the step reads them (2 planes behind the chunk, the reach of the
+ * nucleation suppression). The first 2 planes are read by the last ones across the periodic boundary and are held until
+ * the step ends. Nuclei are numbered per chunk, which gives the same ids as numbering the whole step.
+ */
+class WorkingWindow
+{
+  public:
+    WorkingWindow(const CellularAutomata::Lattice& lattice, size_t windowBlocks) :
+      m_numCells(lattice.size()),
+      m_planeSize(lattice.dimension(0) * lattice.dimension(1)),
+      m_chunkCells(windowBlocks * RecrystalizeVolumeImpl::BlockSize),
+      m_held(std::min(m_numCells, 2 * m_planeSize))
+    {
+      size_t dims[3] = { lattice.dimension(0), lattice.dimension(1), lattice.dimension(2) };
+      m_window.resize(CellularAutomata::WorkingWindowCells(dims, windowBlocks) - m_held.size());
+    }
+
+    //working array of the kernel
+    int32_t* buffer()
+    {
+      return &m_window[0];
+    }
+
+    //advances currentIDs one step with kernel (built on buffer()) run by stepper, numbering the nuclei as they are committed
+    RecrystalizeVolumeImpl::Reduction step(RecrystalizeVolumeImpl& kernel, RecrystalizeVolumeImpl::Stepper& stepper, uint64_t stepSeed, int32_t* currentIDs, NucleusList& nuclei, const CellularAutomata::Lattice& lattice, const uint32_t* recrstTime,
+                                           CellularAutomata::FeatureStatistics* statistics, CellularAutomata::SimulationState& state)
+    {
+      RecrystalizeVolumeImpl::Reduction reduction;
+      size_t committed = 0;
+      for(size_t chunkStart = 0; chunkStart < m_numCells; chunkStart += m_chunkCells)
+      {
+        size_t chunkEnd = std::min(chunkStart + m_chunkCells, m_numCells);
+        kernel.setWorkingBase(committed);
+        reduction.merge(stepper.run(kernel, stepSeed, chunkStart, chunkEnd));
+        if(!nuclei.empty())
+        { NumberNuclei(nuclei, &m_window[0], committed, lattice, NULL, recrstTime, statistics, state); }
+
+        //cells before the plane 2 behind the chunk's last one aren't read by the rest of the step
+        size_t lastPlane = (chunkEnd - 1) / m_planeSize;
+        size_t safe = chunkEnd == m_numCells ? m_numCells : (lastPlane > 2 ? (lastPlane - 2) * m_planeSize : 0);
+        if(safe > committed)
+        {
+          commit(currentIDs, committed, safe);
+          std::copy(m_window.begin() + (safe - committed), m_window.begin() + (chunkEnd - committed), m_window.begin());
+          committed = safe;
+        }
+      }
+      std::copy(m_held.begin(), m_held.end(), currentIDs);
+      return reduction;
+    }
+
+  private:
+    //moves the window's cells [begin, end) (the window starts at begin) to the current array or, for the first planes, to the held cells
+    void commit(int32_t* currentIDs, size_t begin, size_t end)
+    {
+      for(size_t i = begin; i < end; i++)
+      {
+        if(i < m_held.size()) { m_held[i] = m_window[i - begin]; }
+        else { currentIDs[i] = m_window[i - begin]; }
+      }
+    }
+
+    size_t m_numCells;
+    size_t m_planeSize;
+    size_t m_chunkCells;
+    std::vector<int32_t> m_held;//next state of the first planes
+    std::vector<int32_t> m_window;
+};
+
+// -----------------------------------------------------------------------------
+// Number of threads the parallel algorithms run on (1 without them)
+// -----------------------------------------------------------------------------
+static size_t HardwareThreads()
+{
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  return static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+#else
+  return 1;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Runs the grain id tracking simulation until every cell is recrystallized. A state with iteration 0 starts from an empty
+// lattice, otherwise currentIDs and recrstTime must already hold the cells of the state. The final ids are left in
+// currentIDs. A checkpoint is written every checkpointInterval steps if checkpoint isn't NULL, the changed cells are
+// written every frameInterval steps (and after the last step) if frames isn't NULL, per feature statistics are accumulated
+// into statistics if it isn't NULL, the metrics of every step are published to metrics if it isn't NULL and progress is
+// reported to filter unless it is NULL. Nuclei are drawn from sites
+// (weighted so the mean probability per cell is pNuc) if it isn't NULL. Every recorded state is added to
+// the avrami regression as it is reached. The simulation ends early once a stop criterion is met, the remaining cells are
+// then assigned to the nearest grain in a final step if fillRemainder. If domain isn't NULL only its cells are simulated
+// (on compact copies, workingIDs is unused) and cells outside it are left unrecrystallized. Single slices run the planar
+// kernel where the neighborhood allows it (see RecrystalizeVolumeImpl::KernelNeighborhood). An unmasked 3D lattice steps
+// through a working window if the plan has one (workingIDs may then be NULL).
+// -----------------------------------------------------------------------------
+static void SimulateReference(CellularAutomata::Lattice& lattice, const CellularAutomata::Domain* domain, int32_t* currentIDs, int32_t* workingIDs, uint32_t* recrstTime, int neighborhood, float pNuc, const CellularAutomata::AliasTable* sites,
+                              CellularAutomata::SimulationState& state, CellularAutomata::CheckpointWriter* checkpoint, uint64_t checkpointInterval,
+                              CellularAutomata::FrameWriter* frames, uint64_t frameInterval, CellularAutomata::FeatureStatistics* statistics,
+                              const CellularAutomata::StopCriteria& stop, bool fillRemainder, CellularAutomata::AvramiRegression& regression, CellularAutomata::EnginePlan& plan,
+                              CellularAutomata::MetricsWriter* metrics, AbstractFilter* filter)
+{
+  size_t numCells = NULL != domain ? domain->size() : lattice.size();
+  size_t numBlocks = (numCells + RecrystalizeVolumeImpl::BlockSize - 1) / RecrystalizeVolumeImpl::BlockSize;
+  int kernelNeighborhood = RecrystalizeVolumeImpl::KernelNeighborhood(lattice, domain, neighborhood);
+  int32_t* featureIds = currentIDs;
+  uint32_t* featureTimes = recrstTime;
+
+  //initialize arrays
+  if(0 == state.iteration)
+  {
+    std::fill(currentIDs, currentIDs + lattice.size(), 0);
+    std::fill(recrstTime, recrstTime + lattice.size(), 0);
+    state.timeStep = 1;
+    state.grainCount = 0;
+    state.history.assign(1, 0.0f);
+  }
+
+  //initialize variables to track recrystallizatino progress
+  size_t unrecrstallizedCount = 1;
+  NucleusList nuclei;
+
+  //the interface of a state is counted by the step that starts from it, states from before this call are rebuilt
+  if(0 == state.iteration)
+  {
+    state.interfaceFaces.assign(3, 0);
+    state.grainCounts.assign(1, 0);
+  }
+  else if(state.interfaceFaces.size() != 3 * state.history.size() || state.grainCounts.size() != state.history.size())
+  { RebuildInterfaceHistory(lattice, domain, currentIDs, recrstTime, state); }
+
+  //features are accumulated per thread during a step and merged afterwards (cells already recrystallized are counted once up front)
+  FeatureAccumulators accumulators;
+  FeatureAccumulators* pAccumulators = NULL;
+  if(NULL != statistics)
+  {
+    pAccumulators = &accumulators;
+    if(0 == state.iteration)
+    { *statistics = CellularAutomata::FeatureStatistics(); }
+    else
+    { statistics->rebuild(lattice, currentIDs, recrstTime); }
+  }
+
+  //a masked simulation runs on compact copies of the domain's cells (+ the padding cell)
+  std::vector<int32_t> compactIDs[2];
+  std::vector<uint32_t> compactTimes;
+  if(NULL != domain)
+  {
+    compactIDs[0].resize(numCells + 1);
+    compactIDs[1].resize(numCells + 1, 0);
+    compactTimes.resize(numCells + 1);
+    domain->gather(featureIds, &compactIDs[0][0], 0);
+    domain->gather(featureTimes, &compactTimes[0], 0u);
+    currentIDs = &compactIDs[0][0];
+    workingIDs = &compactIDs[1][0];
+    recrstTime = &compactTimes[0];
+  }
+
+  //an unmasked 3D lattice with uniform nucleation can step through a working window (workingIDs is then unused)
+  QScopedPointer<WorkingWindow> window;
+  if(0 != plan.windowBlocks && NULL == domain && NULL == sites && !RecrystalizeVolumeImpl::IsPlanar(kernelNeighborhood))
+  { window.reset(new WorkingWindow(lattice, plan.windowBlocks)); }
+  else
+  { std::fill(workingIDs, workingIDs + numCells, 0); }
+
+  //the first frame of a continued simulation holds every cell recrystallized so far
+  ChangeBuffers changes;
+  ChangeBuffers* pChanges = NULL;
+  if(NULL != frames)
+  {
+    pChanges = &changes;
+    if(0 != state.iteration)
+    {
+      std::vector<size_t>& initial = changes.local();
+      for(size_t i = 0; i < numCells; i++)
+      {
+        if(0 != currentIDs[i])
+        { initial.push_back(i); }
+      }
+      WriteFrame(frames, domain, changes, currentIDs, state);
+    }
+  }
+
+  //continue time stepping until all cells are recrystallized (or a stop criterion is met)
+  CellularAutomata::StopMonitor monitor(stop, regression);
+  CellularAutomata::EngineProbe probe(plan);
+  QScopedPointer<RecrystalizeVolumeImpl::Stepper> stepper(RecrystalizeVolumeImpl::NewStepper(lattice, domain, kernelNeighborhood, plan));
+  CellularAutomata::ProgressEstimate progress(stop.targetFraction);
+  CellularAutomata::StopReason reason = CellularAutomata::NotStopped;
+  while(CellularAutomata::NotStopped == reason)
+  {
+    //perform time step (the kernel reduces the remaining cells to recrystallize + interface)
+    uint64_t stepSeed = CellularAutomata::StreamSeed(state.seed, state.iteration);
+    float kernelNucleationRate = NULL != sites ? 0.0f : pNuc;
+    probe.start();
+    RecrystalizeVolumeImpl kernel(&lattice, domain, currentIDs, window.isNull() ? workingIDs : window->buffer(), recrstTime, &state.timeStep, &nuclei, pChanges, pAccumulators, kernelNucleationRate, kernelNeighborhood);
+    RecrystalizeVolumeImpl::Reduction reduction;
+    if(!window.isNull())
+    { reduction = window->step(kernel, *stepper, stepSeed, currentIDs, nuclei, lattice, recrstTime, statistics, state); }
+    else
+    { reduction = stepper->run(kernel, stepSeed, 0, numCells); }
+    unrecrstallizedCount = reduction.unrecrystallized;
+    if(NULL != sites)
+    {
+      //seeded from the stream after the last block's
+      uint64_t nucleationSeed = CellularAutomata::StreamSeed(stepSeed, numBlocks);
+      size_t created = NucleateFromSites(lattice, domain, *sites, static_cast<double>(pNuc) * numCells, nucleationSeed, currentIDs, workingIDs, recrstTime, state.timeStep, nuclei, pChanges);
+      unrecrstallizedCount = unrecrstallizedCount - created;
+    }
+    if(probe.stop() && NULL != filter)
+    { filter->notifyStatusMessage(filter->getHumanLabel(), QObject::tr("Engine: %1").arg(plan.summary())); }
+    state.iteration++;
+
+    //number new grains in index order so ids don't depend on thread scheduling (a working window numbers them as it goes)
+    if(!nuclei.empty())
+    { NumberNuclei(nuclei, workingIDs, 0, lattice, domain, recrstTime, statistics, state); }
+
+    //merge the cells each thread added to existing features
+    if(NULL != statistics)
+    {
+      for(FeatureAccumulators::iterator iter = accumulators.begin(); iter != accumulators.end(); ++iter)
+      { statistics->merge(*iter); }
+      statistics->touched.clear();
+    }
+
+    // swap working + current arrays (a working window updates the current array in place)
+    if(window.isNull())
+    { std::swap(currentIDs, workingIDs); }
+
+    //compute recrstallized percent
+    float percent = 1 - (static_cast<float>(unrecrstallizedCount) / numCells);
+
+    //only add to history/consider as time step if there is at least some recrystallization (low nucleations rates may require multiple timesteps for the first nuclei to form)
+    for(size_t i = 0; i < 3; i++)
+    { state.interfaceFaces[state.interfaceFaces.size() - 3 + i] = reduction.interfaceFaces[i]; }
+    if(percent > 0)
+    {
+      state.timeStep++;
+      state.history.push_back(percent);
+      state.grainCounts.push_back(state.grainCount);
+      state.interfaceFaces.resize(state.interfaceFaces.size() + 3, 0);//counted by the next step (0 once completely recrystallized)
+    }
+    reason = 0 == unrecrstallizedCount ? CellularAutomata::Completed : monitor.update(state.history);
+
+    //update progress (with the current estimate of the avrami parameters)
+    if(NULL != filter)
+    {
+      QString ss = QObject::tr("%1% recrystallized").arg(100 * percent);
+      double k, n;
+      if(regression.fit(k, n))
+      { ss += QObject::tr(" (K = %1, n = %2)").arg(k).arg(n); }
+      filter->notifyStatusMessage(filter->getHumanLabel(), ss);
+    }
+
+    //checkpoint (the write overlaps with the following steps unless the plan has no memory for a copy of the state), a run
+    //that stops early can be continued from its last state
+    if(NULL != checkpoint && 0 != unrecrstallizedCount && (CellularAutomata::NotStopped != reason || 0 == state.iteration % checkpointInterval))
+    {
+      if(NULL != domain)
+      {
+        domain->scatter(currentIDs, featureIds);
+        domain->scatter(recrstTime, featureTimes);
+      }
+      const int32_t* checkpointIDs = NULL != domain ? featureIds : currentIDs;
+      const uint32_t* checkpointTimes = NULL != domain ? featureTimes : recrstTime;
+      if(plan.checkpointSnapshots)
+      { checkpoint->write(state, checkpointIDs, checkpointTimes); }
+      else
+      {
+        checkpoint->writeShared(state, checkpointIDs, checkpointTimes);
+        checkpoint->succeeded();
+      }
+    }
+
+    //finish the remainder in a single step
+    if(CellularAutomata::NotStopped != reason && CellularAutomata::Completed != reason && fillRemainder && state.grainCount > 0)
+    {
+      std::vector<size_t> filled;
+      if(NULL != domain)
+      {
+        //fill on the lattice (so distances follow the lattice) and copy the filled cells back
+        domain->scatter(currentIDs, featureIds);
+        domain->scatter(recrstTime, featureTimes);
+        FillNearestGrain(lattice, domain, featureIds, featureTimes, state.timeStep, filled);
+        for(std::vector<size_t>::iterator iter = filled.begin(); iter != filled.end(); ++iter)
+        {
+          size_t c = domain->compactIndex(*iter);
+          currentIDs[c] = featureIds[*iter];
+          recrstTime[c] = state.timeStep;
+          *iter = c;
+        }
+      }
+      else
+      { FillNearestGrain(lattice, NULL, currentIDs, recrstTime, state.timeStep, filled); }
+      size_t x, y, z;
+      for(std::vector<size_t>::iterator iter = filled.begin(); iter != filled.end(); ++iter)
+      {
+        if(NULL != statistics)
+        {
+          if(NULL != domain) { domain->ToTuple(*iter, x, y, z); }
+          else { lattice.ToTuple(*iter, x, y, z); }
+          statistics->add(currentIDs[*iter], x, y, z);
+        }
+        if(NULL != frames)
+        { changes.local().push_back(*iter); }
+      }
+      if(NULL != statistics)
+      { statistics->touched.clear(); }
+      //cells no grain can reach (a part of the mask without grains) are left unrecrystallized
+      unrecrstallizedCount -= filled.size();
+      state.timeStep++;
+      state.history.push_back(1 - (static_cast<float>(unrecrstallizedCount) / numCells));
+      state.grainCounts.push_back(state.grainCount);
+      state.interfaceFaces.resize(state.interfaceFaces.size() + 3, 0);
+    }
+
+    //frame of the cells that changed since the previous one (encoded + written in the background)
+    if(NULL != frames && (CellularAutomata::NotStopped != reason || 0 == state.iteration % frameInterval))
+    { WriteFrame(frames, domain, changes, currentIDs, state); }
+
+    //metrics of the step (written in the background)
+    if(NULL != metrics)
+    {
+      CellularAutomata::SimulationMetrics sample;
+      sample.iteration = state.iteration;
+      sample.timeStep = state.history.size() - 1;
+      sample.fraction = state.history.back();
+      sample.grainCount = state.grainCount;
+      sample.finished = CellularAutomata::NotStopped != reason;
+      progress.step(numCells, sample.fraction, sample);
+      metrics->publish(sample);
+    }
+  }
+
+  if(NULL != filter && CellularAutomata::Completed != reason)
+  {
+    static const char* reasons[] = { "", "", "target fraction reached", "maximum time step reached", "wall clock limit reached", "Avrami parameters converged" };
+    QString ss = QObject::tr("Stopped at %1% recrystallized (%2)").arg(100 * state.history.back()).arg(reasons[reason]);
+    filter->notifyStatusMessage(filter->getHumanLabel(), ss);
+  }
+
+  //share of the cell updates that needed a neighbor list (the rest were recrystallized or out of reach of every grain)
+  const CellularAutomata::StepCounters& counters = stepper->total();
+  if(NULL != filter && 0 != counters.cells())
+  {
+    QString ss = QObject::tr("Stepper: %1% of %2 cell updates on the frontier, %3 ns per cell")
+                 .arg(100.0 * counters.frontier / counters.cells()).arg(counters.cells()).arg(static_cast<double>(counters.nanoseconds) / counters.cells());
+    filter->notifyStatusMessage(filter->getHumanLabel(), ss);
+  }
+
+  //make sure the final state ends up in the caller's array
+  if(NULL != domain)
+  {
+    domain->scatter(currentIDs, featureIds);
+    domain->scatter(recrstTime, featureTimes);
+  }
+  else if(currentIDs != featureIds)
+  { std::copy(currentIDs, currentIDs + numCells, featureIds); }
+}
+
+// -----------------------------------------------------------------------------
+// Rebuilds a simulation state from the ids and recrystallization times of an existing (partially) recrystallized volume.
+// Cells recrystallized after lastStep (if it isn't 0) are reset. Returns an error message if the volume isn't valid.
+// -----------------------------------------------------------------------------
+static QString WarmStartState(int32_t* ids, uint32_t* times, size_t numCells, uint32_t lastStep, CellularAutomata::SimulationState& state)
+{
+  //truncate to the requested step and find the last step + highest grain id
+  uint32_t maxTime = 0;
+  int32_t maxId = 0;
+  for(size_t i = 0; i < numCells; i++)
+  {
+    if(ids[i] < 0)
+    { return QObject::tr("Initial Feature Ids must be >= 0"); }
+    if(0 == ids[i] || (0 != lastStep && times[i] > lastStep))
+    {
+      ids[i] = 0;
+      times[i] = 0;
+      continue;
+    }
+    if(0 == times[i])
+    { return QObject::tr("Recrystallized cells must have an Initial Recrystallization Time > 0"); }
+    maxTime = std::max(maxTime, times[i]);
+    maxId = std::max(maxId, ids[i]);
+  }
+
+  //rebuild the recrystallized fraction at each step
+  std::vector<size_t> counts(maxTime + 1, 0);
+  for(size_t i = 0; i < numCells; i++)
+  {
+    if(0 != ids[i])
+    { counts[times[i]]++; }
+  }
+  state.history.assign(1, 0.0f);
+  size_t recrystallized = 0;
+  for(uint32_t t = 1; t <= maxTime; t++)
+  {
+    recrystallized += counts[t];
+    state.history.push_back(1 - (static_cast<float>(numCells - recrystallized) / numCells));//rounded like the simulation's fraction
+  }
+  if(recrystallized == numCells)
+  { return QObject::tr("The initial volume is already completely recrystallized"); }
+
+  //steps before the first nucleation aren't recorded, so the random streams only continue those of the original run if it nucleated in its first step
+  state.iteration = maxTime;
+  state.timeStep = maxTime + 1;
+  state.grainCount = maxId;
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+// Runs 64 bit sliced replicas until every replica is recrystallized (or reaches the target fraction of stop, the step
+// and wall clock limits end every replica, Avrami convergence isn't checked). The history is the mean of the replicas
+// (aligned on their first nucleation) and the states of every replica are pooled in the avrami regression. The metrics
+// of every step (with the mean fraction) are published to metrics if it isn't NULL and progress is reported to filter
+// unless it is NULL.
+// -----------------------------------------------------------------------------
+static void SimulateBitSliced(CellularAutomata::Lattice& lattice, uint64_t* currentState, uint64_t* workingState, int neighborhood, float pNuc, uint64_t seed,
+                              const CellularAutomata::StopCriteria& stop, std::vector<float>& history, CellularAutomata::AvramiRegression& regression, CellularAutomata::EnginePlan& plan,
+                              CellularAutomata::MetricsWriter* metrics, AbstractFilter* filter)
+{
+  const size_t replicas = RecrystalizeVolumeBitSliceImpl::Replicas;
+  size_t numCells = lattice.size();
+  size_t numBlocks = (numCells + RecrystalizeVolumeImpl::BlockSize - 1) / RecrystalizeVolumeImpl::BlockSize;
+
+  //initialize arrays (bit b of each cell is the state of replica b)
+  std::fill(currentState, currentState + numCells, 0);
+  std::fill(workingState, workingState + numCells, 0);
+
+  //number of recrystallized cells in each replica (the steps' counts are reduced from the threads)
+  size_t replicaCounts[replicas];
+  std::fill(replicaCounts, replicaCounts + replicas, 0);
+  CellularAutomata::ThreadLocal<RecrystalizeVolumeBitSliceImpl::Reduction> reductions;
+
+  //each replica has its own history starting from its own first nucleation
+  std::vector<std::vector<float> > replicaHistory(replicas, std::vector<float>(1, 0.0f));
+  std::vector<bool> finished(replicas, false);
+  size_t finishedReplicas = 0;
+  size_t completedReplicas = 0;
+  size_t recordedSteps = 0;
+  QElapsedTimer timer;
+  timer.start();
+  CellularAutomata::EngineProbe probe(plan);
+  CellularAutomata::ProgressEstimate progress(stop.targetFraction);
+
+  for(uint64_t iteration = 0; finishedReplicas < replicas; iteration++)
+  {
+    uint64_t stepSeed = CellularAutomata::StreamSeed(seed, iteration);
+    probe.start();
+    RecrystalizeVolumeBitSliceImpl::Reduction step;
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    if(plan.parallel)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, plan.grainSize),
+                        RecrystalizeVolumeBitSliceImpl(&lattice, currentState, workingState, neighborhood, &reductions, pNuc, stepSeed), tbb::auto_partitioner());
+      for(CellularAutomata::ThreadLocal<RecrystalizeVolumeBitSliceImpl::Reduction>::iterator iter = reductions.begin(); iter != reductions.end(); ++iter)
+      {
+        step.merge(*iter);
+        *iter = RecrystalizeVolumeBitSliceImpl::Reduction();
+      }
+    }
+    else
+#endif
+    {
+      RecrystalizeVolumeBitSliceImpl serial(&lattice, currentState, workingState, neighborhood, &reductions, pNuc, stepSeed);
+      serial.compute(0, numCells, step);
+    }
+    for(size_t b = 0; b < replicas; b++)
+    { replicaCounts[b] += step.newCounts[b]; }
+    if(probe.stop() && NULL != filter)
+    { filter->notifyStatusMessage(filter->getHumanLabel(), QObject::tr("Engine: %1").arg(plan.summary())); }
+
+    // swap working + current arrays
+    std::swap(currentState, workingState);
+
+    //update replica histories (finished replicas stay at 100%)
+    float meanPercent = 0;
+    for(size_t b = 0; b < replicas; b++)
+    {
+      float percent = static_cast<float>(replicaCounts[b]) / numCells;
+      meanPercent += percent / replicas;
+      if(finished[b] || 0 == replicaCounts[b]) { continue; }
+      replicaHistory[b].push_back(percent);
+      regression.add(static_cast<double>(replicaHistory[b].size() - 1), percent);
+      recordedSteps = std::max(recordedSteps, replicaHistory[b].size() - 1);
+      if(numCells == replicaCounts[b] || (stop.targetFraction < 1.0f && percent >= stop.targetFraction))
+      {
+        finished[b] = true;
+        finishedReplicas++;
+        if(numCells == replicaCounts[b]) { completedReplicas++; }
+      }
+    }
+
+    if(NULL != filter)
+    {
+      QString ss = QObject::tr("%1% recrystallized (mean of %2 replicas)").arg(100 * meanPercent).arg(replicas);
+      double k, n;
+      if(regression.fit(k, n))
+      { ss += QObject::tr(", K = %1, n = %2").arg(k).arg(n); }
+      filter->notifyStatusMessage(filter->getHumanLabel(), ss);
+    }
+
+    bool limited = (0 != stop.maxTimeStep && recordedSteps >= stop.maxTimeStep) || (stop.wallClockLimit > 0 && timer.elapsed() > stop.wallClockLimit * 1000.0);
+
+    //metrics of the step (written in the background, grains aren't tracked)
+    if(NULL != metrics)
+    {
+      CellularAutomata::SimulationMetrics sample;
+      sample.iteration = iteration + 1;
+      sample.timeStep = recordedSteps;
+      sample.fraction = meanPercent;
+      sample.finished = limited || finishedReplicas == replicas;
+      progress.step(numCells, meanPercent, sample);
+      metrics->publish(sample);
+    }
+
+    if(limited)
+    {
+      if(NULL != filter)
+      {
+        QString ss = QObject::tr("Stopped with %1 of %2 replicas finished").arg(finishedReplicas).arg(replicas);
+        filter->notifyStatusMessage(filter->getHumanLabel(), ss);
+      }
+      break;
+    }
+  }
+
+  //average replica histories aligned on first nucleation (replicas that ended early hold their last fraction)
+  size_t steps = 0;
+  for(size_t b = 0; b < replicas; b++)
+  { steps = std::max(steps, replicaHistory[b].size()); }
+  history.assign(steps, 0.0f);
+  for(size_t b = 0; b < replicas; b++)
+  {
+    for(size_t i = 0; i < steps; i++)
+    { history[i] += (i < replicaHistory[b].size() ? replicaHistory[b][i] : replicaHistory[b].back()) / replicas; }
+  }
+  if(replicas == completedReplicas)
+  { history.back() = 1.0f; }
+}
+
+// -----------------------------------------------------------------------------
+// Splits a comma / whitespace separated list of numbers
+// -----------------------------------------------------------------------------
+static bool ParseSweepList(const QString& list, QVector<float>& values)
+{
+  values.clear();
+  QStringList tokens = list.split(QRegExp("[,;\\s]+"), QString::SkipEmptyParts);
+  for(QStringList::iterator iter = tokens.begin(); iter != tokens.end(); ++iter)
+  {
+    bool ok = false;
+    values.push_back(iter->toFloat(&ok));
+    if(!ok) { return false; }
+  }
+  return !values.empty();
+}
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+typedef tbb::atomic<size_t> SweepCounter;
+#else
+typedef size_t SweepCounter;
+#endif
+
+/**
+ * @brief The RecrystalizeVolumeSweepImpl class runs complete simulations for a range of parameter combinations. Combination
+ * c uses nucleation rate c / (number of neighborhoods), neighborhood c % (number of neighborhoods) and the run seed (the
+ * same random streams as a single simulation with those parameters), every simulation ends at the stop criteria
+ * (remaining cells aren't filled). Combinations that can't allocate their lattice or fit the avrami equation get NaN
+ * parameters, the ones that can't allocate are also flagged in allocated. Each lane (a task of the parallel range) holds
+ * one lattice at a time and takes the next combination from a shared counter as soon as its previous one is done, so there
+ * are never more lattices than lanes, whichever threads steal the tasks. The steps of each simulation are planned for
+ * engine, which has to be serial while several lanes run so their steps don't split the arena again.
+ */
+class RecrystalizeVolumeSweepImpl
+{
+  public:
+    RecrystalizeVolumeSweepImpl(size_t xDim, size_t yDim, size_t zDim, float voxelVolume, const QVector<float>& nucleationRates, const QVector<int32_t>& neighborhoods, bool kineticsOnly,
+                                const CellularAutomata::StopCriteria& stop, bool weightedFit, uint64_t seed, int engine, size_t threads, size_t grainSize, float* avrami,
+                                uint8_t* allocated, SweepCounter* next, SweepCounter* completed, AbstractFilter* filter) :
+      m_xDim(xDim),
+      m_yDim(yDim),
+      m_zDim(zDim),
+      m_voxelVolume(voxelVolume),
+      m_nucleationRates(nucleationRates),
+      m_neighborhoods(neighborhoods),
+      m_kineticsOnly(kineticsOnly),
+      m_stop(stop),
+      m_weightedFit(weightedFit),
+      m_seed(seed),
+      m_engine(engine),
+      m_threads(threads),
+      m_grainSize(grainSize),
+      m_avrami(avrami),
+      m_allocated(allocated),
+      m_next(next),
+      m_completed(completed),
+      m_filter(filter)
+    {}
+
+    virtual ~RecrystalizeVolumeSweepImpl() {}
+
+    //runs combinations until there are none left (or the filter is canceled)
+    void compute() const
+    {
+      size_t combinations = m_nucleationRates.size() * m_neighborhoods.size();
+      QVector<size_t> cDims(1, 1);
+      for(size_t c = (*m_next)++; c < combinations && !m_filter->getCancel(); c = (*m_next)++)
+      {
+        float pNuc = m_nucleationRates[c / m_neighborhoods.size()] * m_voxelVolume;
+        int neighborhood = m_neighborhoods[c % m_neighborhoods.size()];
+        CellularAutomata::Lattice lattice(m_xDim, m_yDim, m_zDim);
+        size_t numCells = lattice.size();
+
+        std::vector<float> history;
+        CellularAutomata::AvramiRegression regression(m_weightedFit);
+        m_avrami[2 * c + 0] = std::numeric_limits<float>::quiet_NaN();
+        m_avrami[2 * c + 1] = std::numeric_limits<float>::quiet_NaN();
+        m_allocated[c] = 1;
+        if(m_kineticsOnly)
+        {
+          UInt64ArrayType::Pointer currentState = UInt64ArrayType::CreateArray(numCells, cDims, "CurrentState");
+          UInt64ArrayType::Pointer workingState = UInt64ArrayType::CreateArray(numCells, cDims, "WorkingState");
+          if(UInt64ArrayType::NullPointer() == currentState || UInt64ArrayType::NullPointer() == workingState) { m_allocated[c] = 0; }
+          else
+          {
+            CellularAutomata::EnginePlan plan = getPlan("bit-sliced", numCells, neighborhood, pNuc);
+            SimulateBitSliced(lattice, currentState->getPointer(0), workingState->getPointer(0), neighborhood, pNuc, m_seed, m_stop, history, regression, plan, NULL, NULL);
+          }
+        }
+        else
+        {
+          Int32ArrayType::Pointer currentIDs = Int32ArrayType::CreateArray(numCells, cDims, "CurrentIDs");
+          Int32ArrayType::Pointer workingIDs = Int32ArrayType::CreateArray(numCells, cDims, "WorkingIDs");
+          UInt32ArrayType::Pointer recrstTime = UInt32ArrayType::CreateArray(numCells, cDims, "RecrystallizationTime");
+          if(Int32ArrayType::NullPointer() == currentIDs || Int32ArrayType::NullPointer() == workingIDs || UInt32ArrayType::NullPointer() == recrstTime) { m_allocated[c] = 0; }
+          else
+          {
+            CellularAutomata::SimulationState state;
+            state.seed = m_seed;
+            //single slices run the planar kernel with the in plane equivalent of the neighborhood
+            CellularAutomata::EnginePlan plan = 1 == m_zDim ? getPlan("planar", numCells, RecrystalizeVolumeImpl::KernelNeighborhood(lattice, NULL, neighborhood), pNuc) : getPlan("3D", numCells, neighborhood, pNuc);
+            SimulateReference(lattice, NULL, currentIDs->getPointer(0), workingIDs->getPointer(0), recrstTime->getPointer(0), neighborhood, pNuc, NULL, state, NULL, 0, NULL, 0, NULL, m_stop, false, regression, plan, NULL, NULL);
+          }
+        }
+
+        double k, n;
+        if(regression.fit(k, n))
+        {
+          m_avrami[2 * c + 0] = k;
+          m_avrami[2 * c + 1] = n;
+        }
+
+        QString ss = QObject::tr("%1 of %2 parameter combinations complete").arg(++(*m_completed)).arg(combinations);
+        m_filter->notifyStatusMessage(m_filter->getHumanLabel(), ss);
+      }
+    }
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      for(size_t lane = r.begin(); lane < r.end(); lane++)
+      { compute(); }
+    }
+#endif
+  private:
+    CellularAutomata::EnginePlan getPlan(const QString& kernel, size_t numCells, int neighborhood, float pNuc) const
+    {
+      CellularAutomata::EnginePlan plan = CellularAutomata::PlanEngine(m_engine, kernel, numCells, false, RecrystalizeVolumeImpl::BlockSize, neighborhood, pNuc, m_threads);
+      if(0 != m_grainSize) { plan.grainSize = m_grainSize; }
+#ifndef DREAM3D_USE_PARALLEL_ALGORITHMS
+      plan.parallel = false;
+      plan.probe = false;
+#endif
+      return plan;
+    }
+
+    size_t m_xDim;
+    size_t m_yDim;
+    size_t m_zDim;
+    float m_voxelVolume;
+    const QVector<float>& m_nucleationRates;
+    const QVector<int32_t>& m_neighborhoods;
+    bool m_kineticsOnly;
+    CellularAutomata::StopCriteria m_stop;
+    bool m_weightedFit;
+    uint64_t m_seed;
+    int m_engine;//engine of the steps of each simulation
+    size_t m_threads;//threads of the arena the combinations share
+    size_t m_grainSize;//random number blocks per task (0 picks one from the threads)
+    float* m_avrami;
+    uint8_t* m_allocated;//1 if the lattice of a combination could be allocated
+    SweepCounter* m_next;//next combination to start
+    SweepCounter* m_completed;
+    AbstractFilter* m_filter;
+};
+
+/**
+ * @brief The ScalingRun class times the first recorded steps of a uniform nucleation simulation from an empty lattice with a
+ * parallel plan for a number of threads. It is the work of an arena of that many threads, so the time includes the
+ * scheduling of the tasks on them. Lattices that can't be allocated are reported with a negative time.
+ */
+class ScalingRun
+{
+  public:
+    ScalingRun(const size_t dims[3], int neighborhood, float pNuc, bool kineticsOnly, uint64_t seed, uint32_t steps, size_t threads, size_t grainSize, double* seconds, float* fraction) :
+      m_neighborhood(neighborhood),
+      m_pNuc(pNuc),
+      m_kineticsOnly(kineticsOnly),
+      m_seed(seed),
+      m_steps(steps),
+      m_threads(threads),
+      m_grainSize(grainSize),
+      m_seconds(seconds),
+      m_fraction(fraction)
+    {
+      std::copy(dims, dims + 3, m_dims);
+    }
+
+    virtual ~ScalingRun() {}
+
+    void operator()() const
+    {
+      CellularAutomata::Lattice lattice(m_dims[0], m_dims[1], m_dims[2]);
+      size_t numCells = lattice.size();
+      CellularAutomata::StopCriteria stop;
+      stop.maxTimeStep = m_steps;
+      CellularAutomata::AvramiRegression regression(false);
+      QVector<size_t> cDims(1, 1);
+      *m_seconds = -1.0;
+      *m_fraction = 0.0f;
+
+      QElapsedTimer timer;
+      if(m_kineticsOnly)
+      {
+        UInt64ArrayType::Pointer currentState = UInt64ArrayType::CreateArray(numCells, cDims, "CurrentState");
+        UInt64ArrayType::Pointer workingState = UInt64ArrayType::CreateArray(numCells, cDims, "WorkingState");
+        if(UInt64ArrayType::NullPointer() == currentState || UInt64ArrayType::NullPointer() == workingState) { return; }
+        CellularAutomata::EnginePlan plan = getPlan("bit-sliced", numCells);
+        std::vector<float> history;
+        timer.start();
+        SimulateBitSliced(lattice, currentState->getPointer(0), workingState->getPointer(0), m_neighborhood, m_pNuc, m_seed, stop, history, regression, plan, NULL, NULL);
+        *m_seconds = timer.nsecsElapsed() * 1.0e-9;
+        *m_fraction = history.back();
+      }
+      else
+      {
+        Int32ArrayType::Pointer currentIDs = Int32ArrayType::CreateArray(numCells, cDims, "CurrentIDs");
+        Int32ArrayType::Pointer workingIDs = Int32ArrayType::CreateArray(numCells, cDims, "WorkingIDs");
+        UInt32ArrayType::Pointer recrstTime = UInt32ArrayType::CreateArray(numCells, cDims, "RecrystallizationTime");
+        if(Int32ArrayType::NullPointer() == currentIDs || Int32ArrayType::NullPointer() == workingIDs || UInt32ArrayType::NullPointer() == recrstTime) { return; }
+        CellularAutomata::EnginePlan plan = getPlan(1 == m_dims[2] ? "planar" : "3D", numCells);
+        CellularAutomata::SimulationState state;
+        state.seed = m_seed;
+        timer.start();
+        SimulateReference(lattice, NULL, currentIDs->getPointer(0), workingIDs->getPointer(0), recrstTime->getPointer(0), m_neighborhood, m_pNuc, NULL, state, NULL, 0, NULL, 0, NULL, stop, false, regression, plan, NULL, NULL);
+        *m_seconds = timer.nsecsElapsed() * 1.0e-9;
+        *m_fraction = state.history.back();
+      }
+    }
+
+  private:
+    //every thread count runs in parallel (1 thread included, so speedups compare the same kernel)
+    CellularAutomata::EnginePlan getPlan(const QString& kernel, size_t numCells) const
+    {
+      CellularAutomata::EnginePlan plan = CellularAutomata::PlanEngine(CellularAutomata::ParallelEngine, kernel, numCells, false, RecrystalizeVolumeImpl::BlockSize, m_neighborhood, m_pNuc, m_threads);
+      if(0 != m_grainSize) { plan.grainSize = m_grainSize; }
+#ifndef DREAM3D_USE_PARALLEL_ALGORITHMS
+      plan.parallel = false;
+#endif
+      return plan;
+    }
+
+    size_t m_dims[3];
+    int m_neighborhood;
+    float m_pNuc;
+    bool m_kineticsOnly;
+    uint64_t m_seed;
+    uint32_t m_steps;
+    size_t m_threads;
+    size_t m_grainSize;
+    double* m_seconds;
+    float* m_fraction;
+};
+
+#define INIT_SYNTH_VOLUME_CHECK(var, errCond) \
+  if (m_##var <= 0) { QString ss = QObject::tr(":%1 must be a value > 0\n").arg( #var); setErrorCondition(errCond); notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RecrystalizeVolume::RecrystalizeVolume() :
+  AbstractFilter(),
+  m_DataContainerName(DREAM3D::Defaults::SyntheticVolumeDataContainerName),
+  m_CellAttributeMatrixName(DREAM3D::Defaults::CellAttributeMatrixName),
+  m_CellFeatureAttributeMatrixName(DREAM3D::Defaults::CellFeatureAttributeMatrixName),
+  m_CellEnsembleAttributeMatrixName(DREAM3D::Defaults::CellEnsembleAttributeMatrixName),
+  m_NucleationRate(0.0001f),
+  m_Neighborhood(0),
+  m_Engine(CellularAutomata::AutoEngine),
+  m_MaximumThreads(0),
+  m_TaskGrainSize(0),
+  m_ScalingStudySteps(0),
+  m_KineticsOnly(false),
+  m_ParameterSweep(false),
+  m_SweepNucleationRates("0.00001, 0.0001, 0.001, 0.01"),
+  m_SweepNeighborhoods("0, 1, 2, 3, 4, 5"),
+  m_SweepAttributeMatrixName("SweepResults"),
+  m_FixedSeed(false),
+  m_Seed(5489),
+  m_CheckpointInterval(0),
+  m_CheckpointFile(""),
+  m_ResumeFromCheckpoint(false),
+  m_WarmStart(false),
+  m_WarmStartTimeStep(0),
+  m_UseResultCache(false),
+  m_ResultCacheDirectory(""),
+  m_FrameInterval(0),
+  m_FrameFile(""),
+  m_MetricsFile(""),
+  m_CompressedVolumeFile(""),
+  m_FeatureStatistics(false),
+  m_TargetFraction(1.0f),
+  m_MaxTimeStep(0),
+  m_WallClockLimit(0.0),
+  m_AvramiTolerance(0.0f),
+  m_FillRemainder(false),
+  m_WeightedAvramiFit(false),
+  m_GrainGrowthSteps(0),
+  m_HeterogeneousNucleation(false),
+  m_UseMask(false),
+  m_MemoryLimit(0.0),
+  m_FeatureIds(NULL),
+  m_FeatureIdsArrayName(DREAM3D::CellData::FeatureIds),
+  m_RecrystallizationTime(NULL),
+  m_RecrystallizationTimeArrayName("RecrystallizationTime"),
+  m_Active(NULL),
+  m_ActiveArrayName(DREAM3D::FeatureData::Active),
+  m_RecrystallizationHistory(NULL),
+  m_RecrystallizationHistoryArrayName("RecrystallizationHistory"),
+  m_Avrami(NULL),
+  m_AvramiArrayName("AvaramiParameters"),
+  m_SweepNucleationRate(NULL),
+  m_SweepNeighborhood(NULL),
+  m_SweepAvrami(NULL),
+  m_InitialFeatureIds(NULL),
+  m_InitialRecrystallizationTime(NULL),
+  m_NucleationWeights(NULL),
+  m_Mask(NULL),
+  m_NumCells(NULL),
+  m_NumCellsArrayName(DREAM3D::FeatureData::NumCells),
+  m_Volumes(NULL),
+  m_VolumesArrayName(DREAM3D::FeatureData::Volumes),
+  m_NucleationTime(NULL),
+  m_NucleationTimeArrayName("NucleationTime"),
+  m_NucleationSite(NULL),
+  m_NucleationSiteArrayName("NucleationSite"),
+  m_Centroids(NULL),
+  m_CentroidsArrayName(DREAM3D::FeatureData::Centroids),
+  m_BoundingBox(NULL),
+  m_BoundingBoxArrayName("BoundingBox"),
+  m_InterfaceArea(NULL),
+  m_InterfaceAreaArrayName("InterfaceArea"),
+  m_GrainCount(NULL),
+  m_GrainCountArrayName("GrainCount"),
+  m_ScalingStudy(NULL),
+  m_ScalingStudyArrayName("ScalingStudy"),
+  m_EstimatedMemory(""),
+  m_EstimatedRuntime("")
+{
+  m_Dimensions.x = 128;
+  m_Dimensions.y = 128;
+  m_Dimensions.z = 128;
+
+  m_Resolution.x = 0.25f;
+  m_Resolution.y = 0.25f;
+  m_Resolution.z = 0.25f;
+
+  m_Origin.x = 0.0f;
+  m_Origin.y = 0.0f;
+  m_Origin.z = 0.0f;
+  setupFilterParameters();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RecrystalizeVolume::~RecrystalizeVolume()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RecrystalizeVolume::setupFilterParameters()
+{
+  FilterParameterVector parameters;
+  parameters.push_back(SeparatorFilterParameter::New("Required Information", FilterParameter::Uncategorized));
+  parameters.push_back(DoubleFilterParameter::New("Nucleation Rate", "NucleationRate", getNucleationRate(), FilterParameter::Uncategorized));
+  {
+    QStringList linkedProps;
+    linkedProps << "NucleationWeightsArrayPath";
+    parameters.push_back(LinkedBooleanFilterParameter::New("Heterogeneous Nucleation", "HeterogeneousNucleation", getHeterogeneousNucleation(), linkedProps, FilterParameter::Uncategorized));
+  }
+  parameters.push_back(DataArraySelectionFilterParameter::New("Nucleation Weights (e.g. Stored Energy)", "NucleationWeightsArrayPath", getNucleationWeightsArrayPath(), FilterParameter::Uncategorized));
+  {
+    QStringList linkedProps;
+    linkedProps << "MaskArrayPath";
+    parameters.push_back(LinkedBooleanFilterParameter::New("Use Mask", "UseMask", getUseMask(), linkedProps, FilterParameter::Uncategorized));
+  }
+  parameters.push_back(DataArraySelectionFilterParameter::New("Mask", "MaskArrayPath", getMaskArrayPath(), FilterParameter::Uncategorized));
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Neighborhood Type");
+    parameter->setPropertyName("Neighborhood");
+    
+    QVector<QString> choices;
+    choices.push_back("Von Neumann (6 cell) [octohedra]");
+    choices.push_back("8 cell [sphere]");
+    choices.push_back("14 cell [~superellipsoid]");
+    choices.push_back("18 cell [cubeoctahedron]");
+    choices.push_back("20 cell [~truncated cube]");
+    choices.push_back("Moore (26 cell) [cube]");
+    choices.push_back("4 cell [square, single slice]");
+    choices.push_back("8 cell [square, single slice]");
+    choices.push_back("Hexagonal (6 cell) [single slice]");
+    parameter->setChoices(choices);
+    parameter->setAdvanced(false);
+    parameters.push_back(parameter);
+  }
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Engine");
+    parameter->setPropertyName("Engine");
+
+    QVector<QString> choices;
+    choices.push_back("Auto");
+    choices.push_back("Parallel");
+    choices.push_back("Serial");
+    parameter->setChoices(choices);
+    parameter->setAdvanced(false);
+    parameters.push_back(parameter);
+  }
+  parameters.push_back(IntFilterParameter::New("Maximum Threads (0 Uses All)", "MaximumThreads", getMaximumThreads(), FilterParameter::Uncategorized));
+  parameters.push_back(IntFilterParameter::New("Blocks Per Task (0 Auto)", "TaskGrainSize", getTaskGrainSize(), FilterParameter::Uncategorized));
+  parameters.push_back(IntFilterParameter::New("Scaling Study Steps (0 Disables)", "ScalingStudySteps", getScalingStudySteps(), FilterParameter::Uncategorized));
+  parameters.push_back(BooleanFilterParameter::New("Kinetics Only (64 Bit-Sliced Replicas)", "KineticsOnly", getKineticsOnly(), FilterParameter::Uncategorized));
+  {
+    QStringList linkedProps;
+    linkedProps << "SweepNucleationRates" << "SweepNeighborhoods" << "SweepAttributeMatrixName";
+    parameters.push_back(LinkedBooleanFilterParameter::New("Parameter Sweep", "ParameterSweep", getParameterSweep(), linkedProps, FilterParameter::Uncategorized));
+  }
+  parameters.push_back(StringFilterParameter::New("Sweep Nucleation Rates", "SweepNucleationRates", getSweepNucleationRates(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Sweep Neighborhoods", "SweepNeighborhoods", getSweepNeighborhoods(), FilterParameter::Uncategorized));
+  {
+    QStringList linkedProps;
+    linkedProps << "Seed";
+    parameters.push_back(LinkedBooleanFilterParameter::New("Fixed Random Seed", "FixedSeed", getFixedSeed(), linkedProps, FilterParameter::Uncategorized));
+  }
+  parameters.push_back(IntFilterParameter::New("Random Seed", "Seed", getSeed(), FilterParameter::Uncategorized));
+  parameters.push_back(IntFilterParameter::New("Checkpoint Interval (Steps, 0 Disables)", "CheckpointInterval", getCheckpointInterval(), FilterParameter::Uncategorized));
+  parameters.push_back(OutputFileFilterParameter::New("Checkpoint File", "CheckpointFile", getCheckpointFile(), FilterParameter::Uncategorized, "*.ckpt", "Checkpoint"));
+  parameters.push_back(BooleanFilterParameter::New("Resume From Checkpoint", "ResumeFromCheckpoint", getResumeFromCheckpoint(), FilterParameter::Uncategorized));
+  {
+    QStringList linkedProps;
+    linkedProps << "InitialFeatureIdsArrayPath" << "InitialRecrystallizationTimeArrayPath" << "WarmStartTimeStep";
+    parameters.push_back(LinkedBooleanFilterParameter::New("Warm Start From Existing Volume", "WarmStart", getWarmStart(), linkedProps, FilterParameter::Uncategorized));
+  }
+  parameters.push_back(DataArraySelectionFilterParameter::New("Initial Feature Ids", "InitialFeatureIdsArrayPath", getInitialFeatureIdsArrayPath(), FilterParameter::Uncategorized));
+  parameters.push_back(DataArraySelectionFilterParameter::New("Initial Recrystallization Time", "InitialRecrystallizationTimeArrayPath", getInitialRecrystallizationTimeArrayPath(), FilterParameter::Uncategorized));
+  parameters.push_back(IntFilterParameter::New("Warm Start Time Step (0 Uses All)", "WarmStartTimeStep", getWarmStartTimeStep(), FilterParameter::Uncategorized));
+  {
+    QStringList linkedProps;
+    linkedProps << "ResultCacheDirectory";
+    parameters.push_back(LinkedBooleanFilterParameter::New("Use Result Cache", "UseResultCache", getUseResultCache(), linkedProps, FilterParameter::Uncategorized));
+  }
+  parameters.push_back(OutputPathFilterParameter::New("Result Cache Directory", "ResultCacheDirectory", getResultCacheDirectory(), FilterParameter::Uncategorized));
+  parameters.push_back(IntFilterParameter::New("Frame Interval (Steps, 0 Disables)", "FrameInterval", getFrameInterval(), FilterParameter::Uncategorized));
+  parameters.push_back(OutputFileFilterParameter::New("Frame File", "FrameFile", getFrameFile(), FilterParameter::Uncategorized, "*.frames", "Frames"));
+  parameters.push_back(OutputFileFilterParameter::New("Metrics File (Empty Disables)", "MetricsFile", getMetricsFile(), FilterParameter::Uncategorized, "*.prom", "Prometheus Metrics"));
+  parameters.push_back(OutputFileFilterParameter::New("Compressed Volume File (Empty Disables)", "CompressedVolumeFile", getCompressedVolumeFile(), FilterParameter::Uncategorized, "*.cavol", "Compressed Volume"));
+  {
+    QStringList linkedProps;
+    linkedProps << "NumCellsArrayName" << "VolumesArrayName" << "NucleationTimeArrayName" << "NucleationSiteArrayName" << "CentroidsArrayName" << "BoundingBoxArrayName";
+    parameters.push_back(LinkedBooleanFilterParameter::New("Feature Statistics", "FeatureStatistics", getFeatureStatistics(), linkedProps, FilterParameter::Uncategorized));
+  }
+  parameters.push_back(DoubleFilterParameter::New("Stop at Recrystallized Fraction", "TargetFraction", getTargetFraction(), FilterParameter::Uncategorized));
+  parameters.push_back(IntFilterParameter::New("Maximum Time Steps (0 Disables)", "MaxTimeStep", getMaxTimeStep(), FilterParameter::Uncategorized));
+  parameters.push_back(DoubleFilterParameter::New("Wall Clock Limit (Seconds, 0 Disables)", "WallClockLimit", getWallClockLimit(), FilterParameter::Uncategorized));
+  parameters.push_back(DoubleFilterParameter::New("Avrami Convergence Tolerance (0 Disables)", "AvramiTolerance", getAvramiTolerance(), FilterParameter::Uncategorized));
+  parameters.push_back(BooleanFilterParameter::New("Fill Remainder With Nearest Grain", "FillRemainder", getFillRemainder(), FilterParameter::Uncategorized));
+  parameters.push_back(BooleanFilterParameter::New("Weighted Avrami Fit", "WeightedAvramiFit", getWeightedAvramiFit(), FilterParameter::Uncategorized));
+  parameters.push_back(IntFilterParameter::New("Grain Growth Steps (0 Disables)", "GrainGrowthSteps", getGrainGrowthSteps(), FilterParameter::Uncategorized));
+  parameters.push_back(DoubleFilterParameter::New("Memory Limit (GB, 0 Uses 80% of Available)", "MemoryLimit", getMemoryLimit(), FilterParameter::Uncategorized));
+  parameters.push_back(PreflightUpdatedValueFilterParameter::New("Estimated Memory", "EstimatedMemory", getEstimatedMemory(), FilterParameter::Uncategorized));
+  parameters.push_back(PreflightUpdatedValueFilterParameter::New("Estimated Runtime", "EstimatedRuntime", getEstimatedRuntime(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("New DataContainer Name", "DataContainerName", getDataContainerName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("New Cell Attribute Matrix Name", "CellAttributeMatrixName", getCellAttributeMatrixName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("New Cell Feature Attribute Matrix Name", "CellFeatureAttributeMatrixName", getCellFeatureAttributeMatrixName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("New Cell Ensemble Attribute Matrix Name", "CellEnsembleAttributeMatrixName", getCellEnsembleAttributeMatrixName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("New Sweep Results Attribute Matrix Name", "SweepAttributeMatrixName", getSweepAttributeMatrixName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Feature Ids Array Name", "FeatureIdsArrayName", getFeatureIdsArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Recrystallization Time Array Name", "RecrystallizationTimeArrayName", getRecrystallizationTimeArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Recrystallization History Array Name", "RecrystallizationHistoryArrayName", getRecrystallizationHistoryArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Active Array Name", "ActiveArrayName", getActiveArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Interface Area Array Name", "InterfaceAreaArrayName", getInterfaceAreaArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Grain Count Array Name", "GrainCountArrayName", getGrainCountArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Scaling Study Array Name", "ScalingStudyArrayName", getScalingStudyArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Avrami Parameter Array Name", "AvramiArrayName", getAvramiArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Number of Cells Array Name", "NumCellsArrayName", getNumCellsArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Volumes Array Name", "VolumesArrayName", getVolumesArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Nucleation Time Array Name", "NucleationTimeArrayName", getNucleationTimeArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Nucleation Site Array Name", "NucleationSiteArrayName", getNucleationSiteArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Centroids Array Name", "CentroidsArrayName", getCentroidsArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(StringFilterParameter::New("Bounding Box Array Name", "BoundingBoxArrayName", getBoundingBoxArrayName(), FilterParameter::Uncategorized));
+  parameters.push_back(IntVec3FilterParameter::New("Dimensions", "Dimensions", getDimensions(), FilterParameter::Uncategorized));
+  parameters.push_back(FloatVec3FilterParameter::New("Resolution", "Resolution", getResolution(), FilterParameter::Uncategorized));
+  parameters.push_back(FloatVec3FilterParameter::New("Origin", "Origin", getOrigin(), FilterParameter::Uncategorized));
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RecrystalizeVolume::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setNucleationRate(reader->readValue("NucleationRate", getNucleationRate() ) );
+  setNeighborhood(reader->readValue("Neighborhood", getNeighborhood() ) );
+  setEngine(reader->readValue("Engine", getEngine() ) );
+  setMaximumThreads(reader->readValue("MaximumThreads", getMaximumThreads() ) );
+  setTaskGrainSize(reader->readValue("TaskGrainSize", getTaskGrainSize() ) );
+  setScalingStudySteps(reader->readValue("ScalingStudySteps", getScalingStudySteps() ) );
+  setKineticsOnly(reader->readValue("KineticsOnly", getKineticsOnly() ) );
+  setParameterSweep(reader->readValue("ParameterSweep", getParameterSweep() ) );
+  setSweepNucleationRates(reader->readString("SweepNucleationRates", getSweepNucleationRates() ) );
+  setSweepNeighborhoods(reader->readString("SweepNeighborhoods", getSweepNeighborhoods() ) );
+  setFixedSeed(reader->readValue("FixedSeed", getFixedSeed() ) );
+  setSeed(reader->readValue("Seed", getSeed() ) );
+  setCheckpointInterval(reader->readValue("CheckpointInterval", getCheckpointInterval() ) );
+  setCheckpointFile(reader->readString("CheckpointFile", getCheckpointFile() ) );
+  setResumeFromCheckpoint(reader->readValue("ResumeFromCheckpoint", getResumeFromCheckpoint() ) );
+  setWarmStart(reader->readValue("WarmStart", getWarmStart() ) );
+  setInitialFeatureIdsArrayPath(reader->readDataArrayPath("InitialFeatureIdsArrayPath", getInitialFeatureIdsArrayPath() ) );
+  setInitialRecrystallizationTimeArrayPath(reader->readDataArrayPath("InitialRecrystallizationTimeArrayPath", getInitialRecrystallizationTimeArrayPath() ) );
+  setWarmStartTimeStep(reader->readValue("WarmStartTimeStep", getWarmStartTimeStep() ) );
+  setUseResultCache(reader->readValue("UseResultCache", getUseResultCache() ) );
+  setResultCacheDirectory(reader->readString("ResultCacheDirectory", getResultCacheDirectory() ) );
+  setFrameInterval(reader->readValue("FrameInterval", getFrameInterval() ) );
+  setFrameFile(reader->readString("FrameFile", getFrameFile() ) );
+  setMetricsFile(reader->readString("MetricsFile", getMetricsFile() ) );
+  setCompressedVolumeFile(reader->readString("CompressedVolumeFile", getCompressedVolumeFile() ) );
+  setDataContainerName(reader->readString("DataContainerName", getDataContainerName() ) );
+  setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName() ) );
+  setCellFeatureAttributeMatrixName(reader->readString("CellFeatureAttributeMatrixName", getCellFeatureAttributeMatrixName() ) );
   setCellEnsembleAttributeMatrixName(reader->readString("CellEnsembleAttributeMatrixName", getCellEnsembleAttributeMatrixName() ) );
+  setSweepAttributeMatrixName(reader->readString("SweepAttributeMatrixName", getSweepAttributeMatrixName() ) );
   setFeatureIdsArrayName(reader->readString("FeatureIdsArrayName", getFeatureIdsArrayName() ) );
   setRecrystallizationTimeArrayName(reader->readString("RecrystallizationTimeArrayName", getRecrystallizationTimeArrayName() ) );
   setRecrystallizationHistoryArrayName(reader->readString("RecrystallizationHistoryArrayName", getRecrystallizationHistoryArrayName() ) );
   setActiveArrayName(reader->readString("ActiveArrayName", getActiveArrayName() ) );
+  setInterfaceAreaArrayName(reader->readString("InterfaceAreaArrayName", getInterfaceAreaArrayName() ) );
+  setGrainCountArrayName(reader->readString("GrainCountArrayName", getGrainCountArrayName() ) );
+  setScalingStudyArrayName(reader->readString("ScalingStudyArrayName", getScalingStudyArrayName() ) );
   setAvramiArrayName(reader->readString("AvramiArrayName", getAvramiArrayName() ) );
+  setFeatureStatistics(reader->readValue("FeatureStatistics", getFeatureStatistics() ) );
+  setTargetFraction(reader->readValue("TargetFraction", getTargetFraction() ) );
+  setMaxTimeStep(reader->readValue("MaxTimeStep", getMaxTimeStep() ) );
+  setWallClockLimit(reader->readValue("WallClockLimit", getWallClockLimit() ) );
+  setAvramiTolerance(reader->readValue("AvramiTolerance", getAvramiTolerance() ) );
+  setFillRemainder(reader->readValue("FillRemainder", getFillRemainder() ) );
+  setWeightedAvramiFit(reader->readValue("WeightedAvramiFit", getWeightedAvramiFit() ) );
+  setGrainGrowthSteps(reader->readValue("GrainGrowthSteps", getGrainGrowthSteps() ) );
+  setHeterogeneousNucleation(reader->readValue("HeterogeneousNucleation", getHeterogeneousNucleation() ) );
+  setNucleationWeightsArrayPath(reader->readDataArrayPath("NucleationWeightsArrayPath", getNucleationWeightsArrayPath() ) );
+  setUseMask(reader->readValue("UseMask", getUseMask() ) );
+  setMaskArrayPath(reader->readDataArrayPath("MaskArrayPath", getMaskArrayPath() ) );
+  setMemoryLimit(reader->readValue("MemoryLimit", getMemoryLimit() ) );
+  setNumCellsArrayName(reader->readString("NumCellsArrayName", getNumCellsArrayName() ) );
+  setVolumesArrayName(reader->readString("VolumesArrayName", getVolumesArrayName() ) );
+  setNucleationTimeArrayName(reader->readString("NucleationTimeArrayName", getNucleationTimeArrayName() ) );
+  setNucleationSiteArrayName(reader->readString("NucleationSiteArrayName", getNucleationSiteArrayName() ) );
+  setCentroidsArrayName(reader->readString("CentroidsArrayName", getCentroidsArrayName() ) );
+  setBoundingBoxArrayName(reader->readString("BoundingBoxArrayName", getBoundingBoxArrayName() ) );
   setDimensions( reader->readIntVec3("Dimensions", getDimensions() ) );
   setResolution( reader->readFloatVec3("Resolution", getResolution() ) );
   setOrigin( reader->readFloatVec3("Origin", getOrigin() ) );
   reader->closeFilterGroup();
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int RecrystalizeVolume::writeFilterParameters(AbstractFilterParametersWriter* writer, int index)
-{
-  writer->openFilterGroup(this, index);
-  DREAM3D_FILTER_WRITE_PARAMETER(NucleationRate)
-  DREAM3D_FILTER_WRITE_PARAMETER(Neighborhood)
-  DREAM3D_FILTER_WRITE_PARAMETER(DataContainerName)
-  DREAM3D_FILTER_WRITE_PARAMETER(CellAttributeMatrixName)
-  DREAM3D_FILTER_WRITE_PARAMETER(CellFeatureAttributeMatrixName)
-  DREAM3D_FILTER_WRITE_PARAMETER(CellEnsembleAttributeMatrixName)
-  DREAM3D_FILTER_WRITE_PARAMETER(FeatureIdsArrayName)
-  DREAM3D_FILTER_WRITE_PARAMETER(RecrystallizationTimeArrayName)
-  DREAM3D_FILTER_WRITE_PARAMETER(RecrystallizationHistoryArrayName)
-  DREAM3D_FILTER_WRITE_PARAMETER(ActiveArrayName)
-  DREAM3D_FILTER_WRITE_PARAMETER(AvramiArrayName)
-  DREAM3D_FILTER_WRITE_PARAMETER(Dimensions)
-  DREAM3D_FILTER_WRITE_PARAMETER(Resolution)
-  DREAM3D_FILTER_WRITE_PARAMETER(Origin)
-  writer->closeFilterGroup();
-  return ++index; // we want to return the next index that was just written to
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int RecrystalizeVolume::writeFilterParameters(AbstractFilterParametersWriter* writer, int index)
+{
+  writer->openFilterGroup(this, index);
+  DREAM3D_FILTER_WRITE_PARAMETER(NucleationRate)
+  DREAM3D_FILTER_WRITE_PARAMETER(Neighborhood)
+  DREAM3D_FILTER_WRITE_PARAMETER(Engine)
+  DREAM3D_FILTER_WRITE_PARAMETER(MaximumThreads)
+  DREAM3D_FILTER_WRITE_PARAMETER(TaskGrainSize)
+  DREAM3D_FILTER_WRITE_PARAMETER(ScalingStudySteps)
+  DREAM3D_FILTER_WRITE_PARAMETER(KineticsOnly)
+  DREAM3D_FILTER_WRITE_PARAMETER(ParameterSweep)
+  DREAM3D_FILTER_WRITE_PARAMETER(SweepNucleationRates)
+  DREAM3D_FILTER_WRITE_PARAMETER(SweepNeighborhoods)
+  DREAM3D_FILTER_WRITE_PARAMETER(FixedSeed)
+  DREAM3D_FILTER_WRITE_PARAMETER(Seed)
+  DREAM3D_FILTER_WRITE_PARAMETER(CheckpointInterval)
+  DREAM3D_FILTER_WRITE_PARAMETER(CheckpointFile)
+  DREAM3D_FILTER_WRITE_PARAMETER(ResumeFromCheckpoint)
+  DREAM3D_FILTER_WRITE_PARAMETER(WarmStart)
+  DREAM3D_FILTER_WRITE_PARAMETER(InitialFeatureIdsArrayPath)
+  DREAM3D_FILTER_WRITE_PARAMETER(InitialRecrystallizationTimeArrayPath)
+  DREAM3D_FILTER_WRITE_PARAMETER(WarmStartTimeStep)
+  DREAM3D_FILTER_WRITE_PARAMETER(UseResultCache)
+  DREAM3D_FILTER_WRITE_PARAMETER(ResultCacheDirectory)
+  DREAM3D_FILTER_WRITE_PARAMETER(FrameInterval)
+  DREAM3D_FILTER_WRITE_PARAMETER(FrameFile)
+  DREAM3D_FILTER_WRITE_PARAMETER(MetricsFile)
+  DREAM3D_FILTER_WRITE_PARAMETER(CompressedVolumeFile)
+  DREAM3D_FILTER_WRITE_PARAMETER(DataContainerName)
+  DREAM3D_FILTER_WRITE_PARAMETER(CellAttributeMatrixName)
+  DREAM3D_FILTER_WRITE_PARAMETER(CellFeatureAttributeMatrixName)
+  DREAM3D_FILTER_WRITE_PARAMETER(CellEnsembleAttributeMatrixName)
+  DREAM3D_FILTER_WRITE_PARAMETER(SweepAttributeMatrixName)
+  DREAM3D_FILTER_WRITE_PARAMETER(FeatureIdsArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(RecrystallizationTimeArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(RecrystallizationHistoryArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(ActiveArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(InterfaceAreaArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(GrainCountArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(ScalingStudyArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(AvramiArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(FeatureStatistics)
+  DREAM3D_FILTER_WRITE_PARAMETER(TargetFraction)
+  DREAM3D_FILTER_WRITE_PARAMETER(MaxTimeStep)
+  DREAM3D_FILTER_WRITE_PARAMETER(WallClockLimit)
+  DREAM3D_FILTER_WRITE_PARAMETER(AvramiTolerance)
+  DREAM3D_FILTER_WRITE_PARAMETER(FillRemainder)
+  DREAM3D_FILTER_WRITE_PARAMETER(WeightedAvramiFit)
+  DREAM3D_FILTER_WRITE_PARAMETER(GrainGrowthSteps)
+  DREAM3D_FILTER_WRITE_PARAMETER(HeterogeneousNucleation)
+  DREAM3D_FILTER_WRITE_PARAMETER(NucleationWeightsArrayPath)
+  DREAM3D_FILTER_WRITE_PARAMETER(UseMask)
+  DREAM3D_FILTER_WRITE_PARAMETER(MaskArrayPath)
+  DREAM3D_FILTER_WRITE_PARAMETER(MemoryLimit)
+  DREAM3D_FILTER_WRITE_PARAMETER(NumCellsArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(VolumesArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(NucleationTimeArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(NucleationSiteArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(CentroidsArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(BoundingBoxArrayName)
+  DREAM3D_FILTER_WRITE_PARAMETER(Dimensions)
+  DREAM3D_FILTER_WRITE_PARAMETER(Resolution)
+  DREAM3D_FILTER_WRITE_PARAMETER(Origin)
+  writer->closeFilterGroup();
+  return ++index; // we want to return the next index that was just written to
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RecrystalizeVolume::dataCheck()
+{
+  setErrorCondition(0);
+
+  // Create the output Data Container
+  DataContainer::Pointer m = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getDataContainerName());
+  if(getErrorCondition() < 0) { return; }
+
+  // Sanity Check the Dimensions and Resolution
+  INIT_SYNTH_VOLUME_CHECK(Dimensions.x, -5000);
+  INIT_SYNTH_VOLUME_CHECK(Dimensions.y, -5001);
+  INIT_SYNTH_VOLUME_CHECK(Dimensions.z, -5002);
+  INIT_SYNTH_VOLUME_CHECK(Resolution.x, -5003);
+  INIT_SYNTH_VOLUME_CHECK(Resolution.y, -5004);
+  INIT_SYNTH_VOLUME_CHECK(Resolution.z, -5005);
+  if(getErrorCondition() < 0) { return; }
+  if(!m_ParameterSweep && !checkPlanarNeighborhood(m_Neighborhood)) { return; }
+  if(m_Engine > CellularAutomata::SerialEngine)
+  {
+    QString ss = QObject::tr("Engine must be 0 (Auto), 1 (Parallel) or 2 (Serial)");
+    setErrorCondition(-5020);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  //threads and tasks only change how fast a simulation runs, a scaling study times a uniform simulation from scratch
+  {
+    QString ss;
+    if(m_MaximumThreads < 0 || m_TaskGrainSize < 0 || m_ScalingStudySteps < 0)
+    { ss = QObject::tr("Maximum Threads, Blocks Per Task and Scaling Study Steps must be >= 0"); }
+    else if(m_ScalingStudySteps > 0 && (m_ParameterSweep || m_UseMask || m_HeterogeneousNucleation))
+    { ss = QObject::tr("A Scaling Study can't be combined with Parameter Sweep, a Mask or Heterogeneous Nucleation"); }
+    if(!ss.isEmpty())
+    {
+      setErrorCondition(-5024);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+  }
+
+  //checkpoints hold the grain ids of a single simulation
+  if(m_CheckpointInterval < 0)
+  {
+    QString ss = QObject::tr("Checkpoint Interval must be >= 0");
+    setErrorCondition(-5008);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  if(m_CheckpointInterval > 0 || m_ResumeFromCheckpoint)
+  {
+    QString ss;
+    if(m_CheckpointFile.isEmpty())
+    { ss = QObject::tr("A Checkpoint File must be set to write or resume from checkpoints"); }
+    else if(m_KineticsOnly || m_ParameterSweep)
+    { ss = QObject::tr("Checkpoints are only supported for single simulations that track grain ids (not Kinetics Only or Parameter Sweep)"); }
+    else if(m_ResumeFromCheckpoint && !QFile::exists(m_CheckpointFile))
+    { ss = QObject::tr("Checkpoint File '%1' does not exist").arg(m_CheckpointFile); }
+    if(!ss.isEmpty())
+    {
+      setErrorCondition(-5009);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+  }
+
+  //cached results are only reproducible for an explicit seed and a simulation that starts from an empty volume
+  if(m_UseResultCache)
+  {
+    QString ss;
+    if(m_ResultCacheDirectory.isEmpty())
+    { ss = QObject::tr("A Result Cache Directory must be set to use the result cache"); }
+    else if(!m_FixedSeed)
+    { ss = QObject::tr("The result cache requires a Fixed Random Seed"); }
+    else if(m_KineticsOnly || m_ParameterSweep || m_WarmStart || m_ResumeFromCheckpoint)
+    { ss = QObject::tr("The result cache can't be combined with Kinetics Only, Parameter Sweep, Warm Start or Resume From Checkpoint"); }
+    else if(m_TargetFraction < 1.0f || m_MaxTimeStep > 0 || m_WallClockLimit > 0 || m_AvramiTolerance > 0)
+    { ss = QObject::tr("The result cache only holds complete simulations and can't be combined with stop criteria"); }
+    if(!ss.isEmpty())
+    {
+      setErrorCondition(-5012);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+  }
+
+  //frames record the grain ids of a single simulation
+  if(m_FrameInterval != 0)
+  {
+    QString ss;
+    if(m_FrameInterval < 0)
+    { ss = QObject::tr("Frame Interval must be >= 0"); }
+    else if(m_FrameFile.isEmpty())
+    { ss = QObject::tr("A Frame File must be set to write frames"); }
+    else if(m_KineticsOnly || m_ParameterSweep)
+    { ss = QObject::tr("Frames are only written for single simulations that track grain ids (not Kinetics Only or Parameter Sweep)"); }
+    if(!ss.isEmpty())
+    {
+      setErrorCondition(-5013);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+  }
+
+  //metrics follow a single simulation
+  if(!m_MetricsFile.isEmpty() && m_ParameterSweep)
+  {
+    QString ss = QObject::tr("A Metrics File can't be combined with Parameter Sweep");
+    setErrorCondition(-5025);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  //the compressed volume holds the grain ids of a single simulation
+  if(!m_CompressedVolumeFile.isEmpty() && (m_KineticsOnly || m_ParameterSweep))
+  {
+    QString ss = QObject::tr("A Compressed Volume File is only written for single simulations that track grain ids (not Kinetics Only or Parameter Sweep)");
+    setErrorCondition(-5026);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  //a simulation can end before every cell is recrystallized
+  {
+    QString ss;
+    if(m_TargetFraction <= 0.0f || m_TargetFraction > 1.0f)
+    { ss = QObject::tr("Stop at Recrystallized Fraction must be > 0 and <= 1"); }
+    else if(m_MaxTimeStep < 0 || m_WallClockLimit < 0 || m_AvramiTolerance < 0)
+    { ss = QObject::tr("Maximum Time Steps, Wall Clock Limit and Avrami Convergence Tolerance must be >= 0"); }
+    else if(m_AvramiTolerance > 0 && (m_KineticsOnly || m_ParameterSweep))
+    { ss = QObject::tr("Avrami convergence is only checked for single simulations that track grain ids (not Kinetics Only or Parameter Sweep)"); }
+    if(!ss.isEmpty())
+    {
+      setErrorCondition(-5014);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+  }
+
+  //grain growth continues the grain ids of a single simulation of the whole volume
+  {
+    QString ss;
+    if(m_GrainGrowthSteps < 0)
+    { ss = QObject::tr("Grain Growth Steps must be >= 0"); }
+    else if(m_GrainGrowthSteps > 0 && (m_KineticsOnly || m_ParameterSweep || m_UseMask))
+    { ss = QObject::tr("Grain Growth can't be combined with Kinetics Only, Parameter Sweep or a Mask"); }
+    if(!ss.isEmpty())
+    {
+      setErrorCondition(-5023);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+  }
+
+  //heterogeneous nucleation draws sites from a weight per cell of an existing volume with the same dimensions
+  if(m_HeterogeneousNucleation)
+  {
+    QString ss;
+    if(m_KineticsOnly || m_ParameterSweep || m_UseResultCache)
+    { ss = QObject::tr("Heterogeneous Nucleation can't be combined with Kinetics Only, Parameter Sweep or the result cache"); }
+    if(!ss.isEmpty())
+    {
+      setErrorCondition(-5015);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+
+    QVector<size_t> cDims(1, 1);
+    m_NucleationWeightsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getNucleationWeightsArrayPath(), cDims);
+    if( NULL != m_NucleationWeightsPtr.lock().get() )
+    { m_NucleationWeights = m_NucleationWeightsPtr.lock()->getPointer(0); }
+    if(getErrorCondition() < 0) { return; }
+
+    size_t numCells = static_cast<size_t>(m_Dimensions.x) * m_Dimensions.y * m_Dimensions.z;
+    if(m_NucleationWeightsPtr.lock()->getNumberOfTuples() != numCells)
+    {
+      ss = QObject::tr("The Nucleation Weights array must have one value for each of the %1 cells").arg(numCells);
+      setErrorCondition(-5016);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+  }
+
+  //a mask restricts a single simulation to part of the volume
+  if(m_UseMask)
+  {
+    QString ss;
+    if(m_KineticsOnly || m_ParameterSweep || m_WarmStart || m_UseResultCache)
+    { ss = QObject::tr("A Mask can't be combined with Kinetics Only, Parameter Sweep, Warm Start or the result cache"); }
+    if(!ss.isEmpty())
+    {
+      setErrorCondition(-5017);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+
+    QVector<size_t> cDims(1, 1);
+    m_MaskPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<bool>, AbstractFilter>(this, getMaskArrayPath(), cDims);
+    if( NULL != m_MaskPtr.lock().get() )
+    { m_Mask = m_MaskPtr.lock()->getPointer(0); }
+    if(getErrorCondition() < 0) { return; }
+
+    size_t numCells = static_cast<size_t>(m_Dimensions.x) * m_Dimensions.y * m_Dimensions.z;
+    if(m_MaskPtr.lock()->getNumberOfTuples() != numCells)
+    {
+      ss = QObject::tr("The Mask array must have one value for each of the %1 cells").arg(numCells);
+      setErrorCondition(-5018);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+  }
+
+  //a warm start continues the grain ids of an existing volume with the same dimensions
+  if(m_WarmStart)
+  {
+    QString ss;
+    if(m_KineticsOnly || m_ParameterSweep || m_ResumeFromCheckpoint)
+    { ss = QObject::tr("Warm Start can't be combined with Kinetics Only, Parameter Sweep or Resume From Checkpoint"); }
+    else if(m_WarmStartTimeStep < 0)
+    { ss = QObject::tr("Warm Start Time Step must be >= 0"); }
+    if(!ss.isEmpty())
+    {
+      setErrorCondition(-5010);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+
+    QVector<size_t> cDims(1, 1);
+    m_InitialFeatureIdsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getInitialFeatureIdsArrayPath(), cDims);
+    if( NULL != m_InitialFeatureIdsPtr.lock().get() )
+    { m_InitialFeatureIds = m_InitialFeatureIdsPtr.lock()->getPointer(0); }
+
+    m_InitialRecrystallizationTimePtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<uint32_t>, AbstractFilter>(this, getInitialRecrystallizationTimeArrayPath(), cDims);
+    if( NULL != m_InitialRecrystallizationTimePtr.lock().get() )
+    { m_InitialRecrystallizationTime = m_InitialRecrystallizationTimePtr.lock()->getPointer(0); }
+    if(getErrorCondition() < 0) { return; }
+
+    size_t numCells = static_cast<size_t>(m_Dimensions.x) * m_Dimensions.y * m_Dimensions.z;
+    if(m_InitialFeatureIdsPtr.lock()->getNumberOfTuples() != numCells || m_InitialRecrystallizationTimePtr.lock()->getNumberOfTuples() != numCells)
+    {
+      ss = QObject::tr("The Initial Feature Ids and Initial Recrystallization Time arrays must have one value for each of the %1 cells").arg(numCells);
+      setErrorCondition(-5011);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+  }
+
+  //size the simulation before anything is allocated, the mask's cells are only known once it can be read (until then every
+  //cell counts, which is reported but not refused)
+  if(m_MemoryLimit < 0)
+  {
+    QString ss = QObject::tr("Memory Limit must be >= 0");
+    setErrorCondition(-5021);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  {
+    CellularAutomata::EnginePlan plan;
+    CellularAutomata::ResourceEstimate estimate;
+    if(!fitResources(getActiveCells(), plan, estimate)) { return; }
+  }
+
+  // Create the image geometry and set teh Dimensions, Resolution and Origin of the output data container
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  m->setGeometry(image);
+  image->setDimensions(m_Dimensions.x, m_Dimensions.y, m_Dimensions.z);
+  image->setResolution(m_Resolution.x, m_Resolution.y, m_Resolution.z);
+  image->setOrigin(m_Origin.x, m_Origin.y, m_Origin.z);
+
+  // Create our output Attribute Matrix objects
+  QVector<size_t> tDims(3, 0);
+  AttributeMatrix::Pointer cellAttrMat = m->createNonPrereqAttributeMatrix<AbstractFilter>(this, getCellAttributeMatrixName(), tDims, DREAM3D::AttributeMatrixType::Cell);
+  if(getErrorCondition() < 0) { return; }
+
+  QVector<size_t> cDims(1, 1);
+  AttributeMatrix::Pointer cellFeatureAttrMat = m->createNonPrereqAttributeMatrix<AbstractFilter>(this, getCellFeatureAttributeMatrixName(), cDims, DREAM3D::AttributeMatrixType::CellFeature);
+  if(getErrorCondition() < 0) { return; }
+
+  AttributeMatrix::Pointer CellEnsembleAttrMat = m->createNonPrereqAttributeMatrix<AbstractFilter>(this, getCellEnsembleAttributeMatrixName(), cDims, DREAM3D::AttributeMatrixType::CellEnsemble);
+  if(getErrorCondition() < 0) { return; }
+
+  //create arrays
+  QVector<size_t> dims(1, 1);
+  DataArrayPath tempPath;
+
+  //a parameter sweep only produces the table of avrami parameters for every combination
+  if(m_ParameterSweep)
+  {
+    QVector<float> nucleationRates;
+    QVector<int32_t> neighborhoods;
+    if(!parseSweepParameters(nucleationRates, neighborhoods)) { return; }
+
+    QVector<size_t> sweepDims(1, nucleationRates.size() * neighborhoods.size());
+    AttributeMatrix::Pointer sweepAttrMat = m->createNonPrereqAttributeMatrix<AbstractFilter>(this, getSweepAttributeMatrixName(), sweepDims, DREAM3D::AttributeMatrixType::Generic);
+    if(getErrorCondition() < 0) { return; }
+
+    tempPath.update(getDataContainerName(), getSweepAttributeMatrixName(), "NucleationRate" );
+    m_SweepNucleationRatePtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, dims);
+    if( NULL != m_SweepNucleationRatePtr.lock().get() )
+    { m_SweepNucleationRate = m_SweepNucleationRatePtr.lock()->getPointer(0); }
+
+    tempPath.update(getDataContainerName(), getSweepAttributeMatrixName(), "Neighborhood" );
+    m_SweepNeighborhoodPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(this, tempPath, 0, dims);
+    if( NULL != m_SweepNeighborhoodPtr.lock().get() )
+    { m_SweepNeighborhood = m_SweepNeighborhoodPtr.lock()->getPointer(0); }
+
+    dims[0] = 2;
+    tempPath.update(getDataContainerName(), getSweepAttributeMatrixName(), getAvramiArrayName() );
+    m_SweepAvramiPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, dims);
+    if( NULL != m_SweepAvramiPtr.lock().get() )
+    { m_SweepAvrami = m_SweepAvramiPtr.lock()->getPointer(0); }
+    return;
+  }
+  //grain ids are not tracked in kinetics only mode
+  if(!m_KineticsOnly)
+  {
+    tempPath.update(getDataContainerName(), getCellAttributeMatrixName(), getFeatureIdsArrayName() );
+    m_FeatureIdsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(this, tempPath, 0, dims);
+    if( NULL != m_FeatureIdsPtr.lock().get() )
+    { m_FeatureIds = m_FeatureIdsPtr.lock()->getPointer(0); }
+
+    tempPath.update(getDataContainerName(), getCellAttributeMatrixName(), getRecrystallizationTimeArrayName() );
+    m_RecrystallizationTimePtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<uint32_t>, AbstractFilter, uint32_t>(this, tempPath, 0, dims);
+    if( NULL != m_RecrystallizationTimePtr.lock().get() )
+    { m_RecrystallizationTime = m_RecrystallizationTimePtr.lock()->getPointer(0); }
+
+    tempPath.update(getDataContainerName(), getCellFeatureAttributeMatrixName(), getActiveArrayName() );
+    m_ActivePtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<bool>, AbstractFilter, bool>(this, tempPath, 0, dims);
+    if( NULL != m_ActivePtr.lock().get() )
+    { m_Active = m_ActivePtr.lock()->getPointer(0); }
+
+    tempPath.update(getDataContainerName(), getCellEnsembleAttributeMatrixName(), getInterfaceAreaArrayName() );
+    m_InterfaceAreaPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, dims);
+    if( NULL != m_InterfaceAreaPtr.lock().get() )
+    { m_InterfaceArea = m_InterfaceAreaPtr.lock()->getPointer(0); }
+
+    tempPath.update(getDataContainerName(), getCellEnsembleAttributeMatrixName(), getGrainCountArrayName() );
+    m_GrainCountPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(this, tempPath, 0, dims);
+    if( NULL != m_GrainCountPtr.lock().get() )
+    { m_GrainCount = m_GrainCountPtr.lock()->getPointer(0); }
+
+    if(m_FeatureStatistics)
+    {
+      tempPath.update(getDataContainerName(), getCellFeatureAttributeMatrixName(), getNumCellsArrayName() );
+      m_NumCellsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(this, tempPath, 0, dims);
+      if( NULL != m_NumCellsPtr.lock().get() )
+      { m_NumCells = m_NumCellsPtr.lock()->getPointer(0); }
+
+      tempPath.update(getDataContainerName(), getCellFeatureAttributeMatrixName(), getVolumesArrayName() );
+      m_VolumesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, dims);
+      if( NULL != m_VolumesPtr.lock().get() )
+      { m_Volumes = m_VolumesPtr.lock()->getPointer(0); }
+
+      tempPath.update(getDataContainerName(), getCellFeatureAttributeMatrixName(), getNucleationTimeArrayName() );
+      m_NucleationTimePtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<uint32_t>, AbstractFilter, uint32_t>(this, tempPath, 0, dims);
+      if( NULL != m_NucleationTimePtr.lock().get() )
+      { m_NucleationTime = m_NucleationTimePtr.lock()->getPointer(0); }
+
+      QVector<size_t> vecDims(1, 3);
+      tempPath.update(getDataContainerName(), getCellFeatureAttributeMatrixName(), getNucleationSiteArrayName() );
+      m_NucleationSitePtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, vecDims);
+      if( NULL != m_NucleationSitePtr.lock().get() )
+      { m_NucleationSite = m_NucleationSitePtr.lock()->getPointer(0); }
+
+      tempPath.update(getDataContainerName(), getCellFeatureAttributeMatrixName(), getCentroidsArrayName() );
+      m_CentroidsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, vecDims);
+      if( NULL != m_CentroidsPtr.lock().get() )
+      { m_Centroids = m_CentroidsPtr.lock()->getPointer(0); }
+
+      QVector<size_t> boxDims(1, 6);
+      tempPath.update(getDataContainerName(), getCellFeatureAttributeMatrixName(), getBoundingBoxArrayName() );
+      m_BoundingBoxPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, boxDims);
+      if( NULL != m_BoundingBoxPtr.lock().get() )
+      { m_BoundingBox = m_BoundingBoxPtr.lock()->getPointer(0); }
+    }
+  }
+
+  tempPath.update(getDataContainerName(), getCellEnsembleAttributeMatrixName(), getRecrystallizationHistoryArrayName() );
+  m_RecrystallizationHistoryPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, dims);
+  if( NULL != m_RecrystallizationHistoryPtr.lock().get() )
+  { m_RecrystallizationHistory = m_RecrystallizationHistoryPtr.lock()->getPointer(0); }
+
+  dims[0] = 2;
+  tempPath.update(getDataContainerName(), getCellEnsembleAttributeMatrixName(), getAvramiArrayName() );
+  m_AvramiPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, dims);
+  if( NULL != m_AvramiPtr.lock().get() )
+  { m_Avrami = m_AvramiPtr.lock()->getPointer(0); }
+
+  //one row per thread count timed: threads, seconds, speedup, efficiency, weak scaling efficiency
+  if(m_ScalingStudySteps > 0)
+  {
+    QVector<size_t> studyDims(2, CellularAutomata::ScalingColumns);
+    studyDims[0] = CellularAutomata::ScalingThreadCounts(getThreadLimit()).size();
+    tempPath.update(getDataContainerName(), getCellEnsembleAttributeMatrixName(), getScalingStudyArrayName() );
+    m_ScalingStudyPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, studyDims);
+    if( NULL != m_ScalingStudyPtr.lock().get() )
+    { m_ScalingStudy = m_ScalingStudyPtr.lock()->getPointer(0); }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RecrystalizeVolume::preflight()
+{
+  // These are the REQUIRED lines of CODE to make sure the filter behaves correctly
+  setInPreflight(true); // Set the fact that we are preflighting.
+  emit preflightAboutToExecute(); // Emit this signal so that other widgets can do one file update
+  emit updateFilterParameters(this); // Emit this signal to have the widgets push their values down to the filter
+  dataCheck(); // Run our DataCheck to make sure everthing is setup correctly
+  emit preflightExecuted(); // We are done preflighting this filter
+  setInPreflight(false); // Inform the system this filter is NOT in preflight mode anymore.
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString RecrystalizeVolume::getCompiledLibraryName()
+{
+  return CellularAutomata::CellularAutomataBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString RecrystalizeVolume::getGroupName()
+{
+  return "CellularAutomata";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString RecrystalizeVolume::getHumanLabel()
+{
+  return "RecrystalizeVolume";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString RecrystalizeVolume::getSubGroupName()
+{
+  return "Misc";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RecrystalizeVolume::execute()
+{
+  int err = 0;
+  // typically run your dataCheck function to make sure you can get that far and all your variables are initialized
+  dataCheck();
+  // Check to make sure you made it through the data check. Errors would have been reported already so if something
+  // happens to fail in the dataCheck() then we simply return
+  if(getErrorCondition() < 0) { return; }
+  setErrorCondition(0);
+
+  //pick the memory strategy before anything is allocated
+  CellularAutomata::EnginePlan plan;
+  CellularAutomata::ResourceEstimate estimate;
+  if(!fitResources(getActiveCells(), plan, estimate)) { return; }
+  notifyStatusMessage(getHumanLabel(), QObject::tr("Estimated memory: %1, runtime: %2").arg(m_EstimatedMemory).arg(m_EstimatedRuntime));
+
+  //time the first steps at increasing thread counts (each in an arena of its own) before the simulation itself
+  if(m_ScalingStudySteps > 0)
+  {
+    executeScalingStudy();
+    if(getCancel()) { return; }
+  }
+
+  //the simulation runs in an arena of at most the thread limit, so it doesn't take the threads of other work in the process
+  CellularAutomata::ThreadArena arena(getThreadLimit());
+  arena.execute(*this, &RecrystalizeVolume::executeSimulation, plan);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RecrystalizeVolume::executeSimulation(CellularAutomata::EnginePlan& plan)
+{
+  if(m_ParameterSweep)
+  {
+    executeParameterSweep();
+    return;
+  }
+
+  //get cretaed data container
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_DataContainerName);
+
+  //get created cell attribute matricies
+  AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(m_CellAttributeMatrixName);
+  AttributeMatrix::Pointer cellFeatureAttrMat = m->getAttributeMatrix(m_CellFeatureAttributeMatrixName);
+  AttributeMatrix::Pointer cellEnsembleAttrMat = m->getAttributeMatrix(m_CellEnsembleAttributeMatrixName);
+
+  // Resize the cell attribute matric
+  QVector<size_t> cellDims(3, 0);
+  cellDims[0] = m->getGeometryAs<ImageGeom>()->getXPoints();
+  cellDims[1] = m->getGeometryAs<ImageGeom>()->getYPoints();
+  cellDims[2] = m->getGeometryAs<ImageGeom>()->getZPoints();
+  cellAttrMat->resizeAttributeArrays(cellDims);
+
+  //resizing reallocates the cell arrays
+  if(!m_KineticsOnly)
+  {
+    m_FeatureIds = m_FeatureIdsPtr.lock()->getPointer(0);
+    m_RecrystallizationTime = m_RecrystallizationTimePtr.lock()->getPointer(0);
+  }
+
+  //convert nucleation rate to probabilty / voxel / timestep
+  float pNuc = m_NucleationRate * m_Resolution.x * m_Resolution.y * m_Resolution.z;
+
+  //determine number of cells and create helper object for indicies
+  size_t numCells = static_cast<size_t>(m_Dimensions.x) * m_Dimensions.y * m_Dimensions.z;
+  CellularAutomata::Lattice lattice(m_Dimensions.x, m_Dimensions.y, m_Dimensions.z);
+
+  //recrystallized fraction at each time step + running sums to fit avrami equation parameters
+  std::vector<float> recrystallizationHistory;
+  CellularAutomata::AvramiRegression regression(m_WeightedAvramiFit);
+
+  //cached results are written in the background
+  QString cachePath;
+  QScopedPointer<CellularAutomata::CheckpointWriter> cacheWriter;
+
+  //so are the metrics of every step
+  QScopedPointer<CellularAutomata::MetricsWriter> metrics;
+  if(!m_MetricsFile.isEmpty())
+  { metrics.reset(new CellularAutomata::MetricsWriter(m_MetricsFile)); }
+
+  QVector<size_t> cDims(1, 1);
+  if(m_KineticsOnly)
+  {
+    //create bit sliced state arrays
+    UInt64ArrayType::Pointer currentState = UInt64ArrayType::CreateArray(numCells, cDims, "CurrentState");
+    UInt64ArrayType::Pointer workingState = UInt64ArrayType::CreateArray(numCells, cDims, "WorkingState");
+
+    //make sure allocation was sucessful
+    if(UInt64ArrayType::NullPointer() == currentState || UInt64ArrayType::NullPointer() == workingState)
+    {
+      QString ss = QObject::tr("Unable to allocate memory for bit sliced state arrays");
+      setErrorCondition(-2);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+
+    notifyStatusMessage(getHumanLabel(), QObject::tr("Engine: %1").arg(plan.summary()));
+    SimulateBitSliced(lattice, currentState->getPointer(0), workingState->getPointer(0), m_Neighborhood, pNuc, getRunSeed(), getStopCriteria(), recrystallizationHistory, regression, plan, metrics.data(), this);
+  }
+  else
+  {
+    //restrict the simulation to the masked cells (compact working copies replace the lattice sized working array)
+    QScopedPointer<CellularAutomata::Domain> domain;
+    if(m_UseMask)
+    {
+      domain.reset(new CellularAutomata::Domain(lattice, m_Mask, RecrystalizeVolumeImpl::DomainWidth(m_Neighborhood)));
+      if(0 == domain->size())
+      {
+        QString ss = QObject::tr("The Mask must select at least 1 cell");
+        setErrorCondition(-7);
+        notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+        return;
+      }
+    }
+
+    //create working array to hold grain ids (unless the plan steps through a working window)
+    Int32ArrayType::Pointer workingIDs = Int32ArrayType::NullPointer();
+    if(domain.isNull() && 0 == plan.windowBlocks)
+    {
+      workingIDs = Int32ArrayType::CreateArray(numCells, cDims, getFeatureIdsArrayName());
+
+      //make sure allocation was sucessful
+      if(Int32ArrayType::NullPointer() == workingIDs)
+      {
+        QString ss = QObject::tr("Unable to allocate memory for working array");
+        setErrorCondition(-1);
+        notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+        return;
+      }
+    }
+
+    //nucleation sites weighted by the input array (built once, sampled every step), cells outside the mask never nucleate
+    QScopedPointer<CellularAutomata::AliasTable> sites;
+    if(m_HeterogeneousNucleation)
+    {
+      const float* weights = m_NucleationWeights;
+      std::vector<float> maskedWeights;
+      if(!domain.isNull())
+      {
+        maskedWeights.assign(m_NucleationWeights, m_NucleationWeights + numCells);
+        for(size_t i = 0; i < numCells; i++)
+        {
+          if(!m_Mask[i]) { maskedWeights[i] = 0.0f; }
+        }
+        weights = &maskedWeights[0];
+      }
+      sites.reset(new CellularAutomata::AliasTable());
+      if(!sites->build(weights, numCells))
+      {
+        QString ss = QObject::tr("Nucleation Weights must be finite and >= 0 with at least one value > 0");
+        setErrorCondition(-6);
+        notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+        return;
+      }
+    }
+
+    //start from scratch or continue from a checkpoint
+    CellularAutomata::SimulationState state;
+    state.seed = getRunSeed();
+    size_t dims[3] = { static_cast<size_t>(m_Dimensions.x), static_cast<size_t>(m_Dimensions.y), static_cast<size_t>(m_Dimensions.z) };
+
+    //checkpoints (and cached results) only continue a simulation with the same parameters, seed, mask and weights
+    CellularAutomata::CheckpointKey key(dims, m_Neighborhood, pNuc);
+    key.fixedSeed = m_FixedSeed;
+    key.seed = state.seed;
+    key.inputs = CellularAutomata::CheckpointInputs(m_UseMask ? m_Mask : NULL, m_HeterogeneousNucleation ? m_NucleationWeights : NULL, numCells);
+    if(m_ResumeFromCheckpoint)
+    {
+      QString ss = CellularAutomata::ReadCheckpoint(m_CheckpointFile, key, state, m_FeatureIds, m_RecrystallizationTime);
+      if(!ss.isEmpty())
+      {
+        setErrorCondition(-4);
+        notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+        return;
+      }
+      notifyStatusMessage(getHumanLabel(), QObject::tr("Resuming from step %1").arg(state.iteration));
+    }
+    else if(m_WarmStart)
+    {
+      std::copy(m_InitialFeatureIds, m_InitialFeatureIds + numCells, m_FeatureIds);
+      std::copy(m_InitialRecrystallizationTime, m_InitialRecrystallizationTime + numCells, m_RecrystallizationTime);
+      QString ss = WarmStartState(m_FeatureIds, m_RecrystallizationTime, numCells, m_WarmStartTimeStep, state);
+      if(!ss.isEmpty())
+      {
+        setErrorCondition(-5);
+        notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+        return;
+      }
+      notifyStatusMessage(getHumanLabel(), QObject::tr("Warm starting from step %1 (%2% recrystallized)").arg(state.timeStep - 1).arg(100 * state.history.back()));
+    }
+
+
+    //per feature statistics (collected during the simulation)
+    CellularAutomata::FeatureStatistics statistics;
+
+    //reuse the result of an identical earlier run if it is cached
+    bool cacheHit = false;
+    if(m_UseResultCache)
+    {
+      float resolution[3] = { m_Resolution.x, m_Resolution.y, m_Resolution.z };
+      float origin[3] = { m_Origin.x, m_Origin.y, m_Origin.z };
+      cachePath = CellularAutomata::ResultCachePath(m_ResultCacheDirectory, dims, resolution, origin, m_NucleationRate, m_Neighborhood, state.seed);
+      if(QFile::exists(cachePath))
+      {
+        QString ss = CellularAutomata::ReadCheckpoint(cachePath, key, state, m_FeatureIds, m_RecrystallizationTime);
+        cacheHit = ss.isEmpty();
+        if(cacheHit)
+        {
+          notifyStatusMessage(getHumanLabel(), QObject::tr("Loaded cached result '%1'").arg(cachePath));
+          if(m_FeatureStatistics)
+          { statistics.rebuild(lattice, m_FeatureIds, m_RecrystallizationTime); }
+        }
+        else
+        {
+          //unreadable entries are simply recomputed (and replaced)
+          notifyWarningMessage(getHumanLabel(), ss, 3);
+          state = CellularAutomata::SimulationState();
+          state.seed = getRunSeed();
+        }
+      }
+    }
+
+    if(!cacheHit)
+    {
+      QScopedPointer<CellularAutomata::CheckpointWriter> checkpoint;
+      if(m_CheckpointInterval > 0)
+      { checkpoint.reset(new CellularAutomata::CheckpointWriter(m_CheckpointFile, key)); }
+
+      QScopedPointer<CellularAutomata::FrameWriter> frames;
+      if(m_FrameInterval > 0)
+      { frames.reset(new CellularAutomata::FrameWriter(m_FrameFile, dims)); }
+
+      notifyStatusMessage(getHumanLabel(), QObject::tr("Engine: %1").arg(plan.summary()));
+      SimulateReference(lattice, domain.data(), m_FeatureIds, Int32ArrayType::NullPointer() != workingIDs ? workingIDs->getPointer(0) : NULL, m_RecrystallizationTime, m_Neighborhood, pNuc, sites.data(), state, checkpoint.data(), m_CheckpointInterval,
+                        frames.data(), m_FrameInterval, m_FeatureStatistics ? &statistics : NULL, getStopCriteria(), m_FillRemainder, regression, plan, metrics.data(), this);
+
+      //clean up working copy
+      workingIDs = Int32ArrayType::NullPointer();
+
+      if(!frames.isNull() && !frames->finish())
+      {
+        QString ss = QObject::tr("Unable to write frame file '%1'").arg(m_FrameFile);
+        notifyWarningMessage(getHumanLabel(), ss, 5);
+      }
+
+      if(!checkpoint.isNull() && !checkpoint->succeeded())
+      {
+        QString ss = QObject::tr("Unable to write checkpoint file '%1'").arg(m_CheckpointFile);
+        notifyWarningMessage(getHumanLabel(), ss, 2);
+      }
+
+      //store the final state in the cache (written while the remaining outputs are assembled, which leave the cell arrays as they are)
+      if(m_UseResultCache)
+      {
+        if(QDir().mkpath(m_ResultCacheDirectory))
+        {
+          cacheWriter.reset(new CellularAutomata::CheckpointWriter(cachePath, key));
+          cacheWriter->writeShared(state, m_FeatureIds, m_RecrystallizationTime);
+        }
+        else
+        {
+          QString ss = QObject::tr("Unable to create Result Cache Directory '%1'").arg(m_ResultCacheDirectory);
+          notifyWarningMessage(getHumanLabel(), ss, 4);
+        }
+      }
+    }
+    recrystallizationHistory = state.history;
+
+    //cached results only hold the recrystallization times
+    if(cacheHit)
+    { RebuildInterfaceHistory(lattice, domain.data(), m_FeatureIds, m_RecrystallizationTime, state); }
+
+    //coarsen the recrystallized grains in place (times, history, interface area and the cached result stay those of the recrystallization)
+    if(m_GrainGrowthSteps > 0)
+    {
+      //the cache is written from the feature ids
+      if(!cacheWriter.isNull()) { cacheWriter->wait(); }
+
+      //canceling stops the growth early, the outputs are still assembled from the grains grown so far
+      CellularAutomata::GrainGrowth growth(lattice, m_FeatureIds);
+      size_t boundaryCells = growth.active().size();
+      int g = 0;
+      for(; g < m_GrainGrowthSteps && !growth.active().empty() && !getCancel(); g++)
+      { growth.step(CellularAutomata::StreamSeed(state.seed, state.iteration + g)); }
+      notifyStatusMessage(getHumanLabel(), QObject::tr("Grain growth: %1 boundary cells after %2 steps (%3 before)").arg(growth.active().size()).arg(g).arg(boundaryCells));
+      if(m_FeatureStatistics)
+      { statistics.recount(lattice, m_FeatureIds); }
+    }
+
+    //archive the final grain ids + times (slabs compressed in parallel straight from the output arrays)
+    if(!m_CompressedVolumeFile.isEmpty())
+    {
+      uint64_t bytes = 0;
+      size_t dims[3] = { static_cast<size_t>(m_Dimensions.x), static_cast<size_t>(m_Dimensions.y), static_cast<size_t>(m_Dimensions.z) };
+      QString ss = CellularAutomata::WriteCompressedVolume(m_CompressedVolumeFile, dims, m_FeatureIds, m_RecrystallizationTime, 0, plan.parallel, bytes);
+      if(ss.isEmpty())
+      { notifyStatusMessage(getHumanLabel(), QObject::tr("Compressed volume: %1 bytes (%2% of the raw arrays)").arg(bytes).arg(100.0 * bytes / (8.0 * numCells))); }
+      else
+      { notifyWarningMessage(getHumanLabel(), ss, 8); }
+    }
+
+    //convert interface faces to area + store grain counts
+    const float faceArea[3] = { m_Resolution.y * m_Resolution.z, m_Resolution.x * m_Resolution.z, m_Resolution.x * m_Resolution.y };
+    cDims[0] = state.grainCounts.size();
+    FloatArrayType::Pointer interfaceArea = FloatArrayType::CreateArray(1, cDims, getInterfaceAreaArrayName());
+    Int32ArrayType::Pointer grainCounts = Int32ArrayType::CreateArray(1, cDims, getGrainCountArrayName());
+    for(size_t i = 0; i < state.grainCounts.size(); i++)
+    {
+      interfaceArea->getPointer(0)[i] = state.interfaceFaces[3 * i] * faceArea[0] + state.interfaceFaces[3 * i + 1] * faceArea[1] + state.interfaceFaces[3 * i + 2] * faceArea[2];
+      grainCounts->getPointer(0)[i] = state.grainCounts[i];
+    }
+    cellEnsembleAttrMat->addAttributeArray(getInterfaceAreaArrayName(), interfaceArea);
+    cellEnsembleAttrMat->addAttributeArray(getGrainCountArrayName(), grainCounts);
+    cDims[0] = 1;
+
+    //resize cell feature attribute matrix
+    QVector<size_t> featureDims(1, state.grainCount + 1);
+    cellFeatureAttrMat->resizeAttributeArrays(featureDims);
+
+    //fill active array with true (except for grain 0)
+    m_ActivePtr.lock()->initializeWithValue(true);
+    m_ActivePtr.lock()->getPointer(0)[0] = false;
+
+    //grains consumed by grain growth are inactive
+    if(m_GrainGrowthSteps > 0)
+    {
+      bool* active = m_ActivePtr.lock()->getPointer(0);
+      std::vector<bool> grown(state.grainCount + 1, false);
+      for(size_t i = 0; i < numCells; i++)
+      { grown[m_FeatureIds[i]] = true; }
+      for(size_t i = 1; i < grown.size(); i++)
+      {
+        if(!grown[i]) { active[i] = false; }
+      }
+    }
+
+    if(m_FeatureStatistics)
+    { writeFeatureStatistics(statistics); }
+
+    //a cached result hasn't been added to the regression yet
+    regression.update(recrystallizationHistory);
+  }
+
+  //fill recrystalization history
+  cDims[0] = recrystallizationHistory.size();
+  FloatArrayType::Pointer history = FloatArrayType::CreateArray(1, cDims, getRecrystallizationHistoryArrayName());
+  float* pHistory = history->getPointer(0);
+  for(size_t i = 0; i < recrystallizationHistory.size(); i++)
+  { pHistory[i] = recrystallizationHistory[i]; }
+  cellEnsembleAttrMat->addAttributeArray(getRecrystallizationHistoryArrayName(), history);
+
+  //fit avrami parameters from the sums accumulated during the simulation
+  double k, n;
+  if(regression.fit(k, n))
+  {
+    m_Avrami[0] = k;
+    m_Avrami[1] = n;
+  }
+  else
+  {
+    QString ss = QObject::tr("Unable to fit Avrami Parameters");
+    notifyWarningMessage(getHumanLabel(), ss, 1);
+  }
+
+  if(!cacheWriter.isNull() && !cacheWriter->succeeded())
+  {
+    QString ss = QObject::tr("Unable to write cached result '%1'").arg(cachePath);
+    notifyWarningMessage(getHumanLabel(), ss, 4);
+  }
+
+  if(!metrics.isNull() && !metrics->finish())
+  {
+    QString ss = QObject::tr("Unable to write metrics file '%1'").arg(m_MetricsFile);
+    notifyWarningMessage(getHumanLabel(), ss, 7);
+  }
+
+  /* Let the GUI know we are done with this filter */
+  notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void RecrystalizeVolume::dataCheck()
+void RecrystalizeVolume::executeParameterSweep()
 {
-  setErrorCondition(0);
+  QVector<float> nucleationRates;
+  QVector<int32_t> neighborhoods;
+  parseSweepParameters(nucleationRates, neighborhoods);
+  size_t combinations = nucleationRates.size() * neighborhoods.size();
 
-  // Create the output Data Container
-  DataContainer::Pointer m = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getDataContainerName());
-  if(getErrorCondition() < 0) { return; }
+  //fill in the parameter columns of the results table
+  for(size_t c = 0; c < combinations; c++)
+  {
+    m_SweepNucleationRate[c] = nucleationRates[c / neighborhoods.size()];
+    m_SweepNeighborhood[c] = neighborhoods[c % neighborhoods.size()];
+  }
 
-  // Sanity Check the Dimensions and Resolution
-  INIT_SYNTH_VOLUME_CHECK(Dimensions.x, -5000);
-  INIT_SYNTH_VOLUME_CHECK(Dimensions.y, -5001);
-  INIT_SYNTH_VOLUME_CHECK(Dimensions.z, -5002);
-  INIT_SYNTH_VOLUME_CHECK(Resolution.x, -5003);
-  INIT_SYNTH_VOLUME_CHECK(Resolution.y, -5004);
-  INIT_SYNTH_VOLUME_CHECK(Resolution.z, -5005);
+  //only run as many simultaneous lattices as fit in the memory limit
+  size_t numCells = static_cast<size_t>(m_Dimensions.x) * m_Dimensions.y * m_Dimensions.z;
+  size_t bytesPerLattice = numCells * (m_KineticsOnly ? 2 * sizeof(uint64_t) : 2 * sizeof(int32_t) + sizeof(uint32_t));
+  size_t concurrentLattices = static_cast<size_t>(getMemoryLimitBytes() / bytesPerLattice);
+  if(0 == concurrentLattices)
+  {
+    QString ss = QObject::tr("Not enough memory for a single %1 x %2 x %3 lattice").arg(m_Dimensions.x).arg(m_Dimensions.y).arg(m_Dimensions.z);
+    setErrorCondition(-5027);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
 
-  // Set teh Dimensions, Resolution and Origin of the output data container
-  /* FIXME: ImageGeom */ m->getGeometryAs<ImageGeom>()->setDimensions(m_Dimensions.x, m_Dimensions.y, m_Dimensions.z);
-  /* FIXME: ImageGeom */ m->getGeometryAs<ImageGeom>()->setResolution(m_Resolution.x, m_Resolution.y, m_Resolution.z);
-  /* FIXME: ImageGeom */ m->getGeometryAs<ImageGeom>()->setOrigin(m_Origin.x, m_Origin.y, m_Origin.z);
+  //run the combinations on at most concurrentLattices lanes, each starting its next combination as soon as one is done. The
+  //serial engine runs a single lane, several lanes step their simulations serially, a single lane plans its steps with the
+  //selected engine
+  size_t lanes = 1;
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  if(CellularAutomata::SerialEngine != m_Engine)
+  { lanes = std::min(std::min(concurrentLattices, getThreadLimit()), combinations); }
+#endif
+  float voxelVolume = m_Resolution.x * m_Resolution.y * m_Resolution.z;
+  std::vector<uint8_t> allocated(combinations, 1);
+  SweepCounter next;
+  SweepCounter completed;
+  next = 0;
+  completed = 0;
+  RecrystalizeVolumeSweepImpl sweep(m_Dimensions.x, m_Dimensions.y, m_Dimensions.z, voxelVolume, nucleationRates, neighborhoods, m_KineticsOnly, getStopCriteria(), m_WeightedAvramiFit, getRunSeed(),
+                                    lanes > 1 ? static_cast<int>(CellularAutomata::SerialEngine) : static_cast<int>(m_Engine), getThreadLimit(), static_cast<size_t>(m_TaskGrainSize), m_SweepAvrami, &allocated[0],
+                                    &next, &completed, this);
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+  if(lanes > 1)
+  { tbb::parallel_for(tbb::blocked_range<size_t>(0, lanes, 1), sweep, tbb::simple_partitioner()); }
+  else
+  { sweep.compute(); }
+#else
+  sweep.compute();
+#endif
+  if(getCancel()) { return; }
 
-  // Create our output Attribute Matrix objects
-  QVector<size_t> tDims(3, 0);
-  AttributeMatrix::Pointer cellAttrMat = m->createNonPrereqAttributeMatrix<AbstractFilter>(this, getCellAttributeMatrixName(), tDims, DREAM3D::AttributeMatrixType::Cell);
-  if(getErrorCondition() < 0) { return; }
+  //report combinations that couldn't run or didn't produce a fit
+  for(size_t c = 0; c < combinations; c++)
+  {
+    if(0 == allocated[c])
+    {
+      QString ss = QObject::tr("Not enough memory for the lattice of nucleation rate %1 with neighborhood %2").arg(m_SweepNucleationRate[c]).arg(m_SweepNeighborhood[c]);
+      notifyWarningMessage(getHumanLabel(), ss, 1);
+    }
+    else if(m_SweepAvrami[2 * c] != m_SweepAvrami[2 * c])//NaN
+    {
+      QString ss = QObject::tr("Unable to fit Avrami Parameters for nucleation rate %1 with neighborhood %2").arg(m_SweepNucleationRate[c]).arg(m_SweepNeighborhood[c]);
+      notifyWarningMessage(getHumanLabel(), ss, 1);
+    }
+  }
 
-  QVector<size_t> cDims(1, 1);
-  AttributeMatrix::Pointer cellFeatureAttrMat = m->createNonPrereqAttributeMatrix<AbstractFilter>(this, getCellFeatureAttributeMatrixName(), cDims, DREAM3D::AttributeMatrixType::CellFeature);
-  if(getErrorCondition() < 0) { return; }
+  /* Let the GUI know we are done with this filter */
+  notifyStatusMessage(getHumanLabel(), "Complete");
+}
 
-  AttributeMatrix::Pointer CellEnsembleAttrMat = m->createNonPrereqAttributeMatrix<AbstractFilter>(this, getCellEnsembleAttributeMatrixName(), cDims, DREAM3D::AttributeMatrixType::CellEnsemble);
-  if(getErrorCondition() < 0) { return; }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RecrystalizeVolume::executeScalingStudy()
+{
+  float pNuc = m_NucleationRate * m_Resolution.x * m_Resolution.y * m_Resolution.z;
+  uint64_t seed = getRunSeed();
+  uint32_t steps = static_cast<uint32_t>(m_ScalingStudySteps);
+  size_t dims[3] = { static_cast<size_t>(m_Dimensions.x), static_cast<size_t>(m_Dimensions.y), static_cast<size_t>(m_Dimensions.z) };
+
+  //weak scaling grows the slowest axis (y on a single slice) with the thread count, as long as the lattice fits the memory limit
+  size_t growAxis = 1 == dims[2] ? 1 : 2;
+  size_t bytesPerCell = m_KineticsOnly ? 2 * sizeof(uint64_t) : 2 * sizeof(int32_t) + sizeof(uint32_t);
+  uint64_t limit = getMemoryLimitBytes();
+
+  std::vector<size_t> counts = CellularAutomata::ScalingThreadCounts(getThreadLimit());
+  std::vector<CellularAutomata::ScalingPoint> points(counts.size());
+  float fraction = 0.0f;
+  for(size_t p = 0; p < counts.size(); p++)
+  {
+    if(getCancel()) { return; }
+    CellularAutomata::ThreadArena arena(counts[p]);
+    CellularAutomata::ScalingPoint& point = points[p];
+    point.threads = counts[p];
+
+    //the same steps on the same lattice reach the same state on any number of threads
+    float reached = 0.0f;
+    ScalingRun strong(dims, m_Neighborhood, pNuc, m_KineticsOnly, seed, steps, point.threads, static_cast<size_t>(m_TaskGrainSize), &point.seconds, &reached);
+    arena.execute(strong);
+    if(0 == p) { fraction = reached; }
+    else if(reached != fraction)
+    {
+      QString ss = QObject::tr("The scaling study reached %1% recrystallized on %2 threads but %3% on 1 thread").arg(100 * reached).arg(point.threads).arg(100 * fraction);
+      notifyWarningMessage(getHumanLabel(), ss, 6);
+    }
 
-  //create arrays
-  QVector<size_t> dims(1, 1);
-  DataArrayPath tempPath;
-  tempPath.update(getDataContainerName(), getCellAttributeMatrixName(), getFeatureIdsArrayName() );
-  m_FeatureIdsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(this, tempPath, 0, dims);
-  if( NULL != m_FeatureIdsPtr.lock().get() )
-  { m_FeatureIds = m_FeatureIdsPtr.lock()->getPointer(0); }
+    size_t weakDims[3] = { dims[0], dims[1], dims[2] };
+    weakDims[growAxis] *= point.threads;
+    if(static_cast<uint64_t>(weakDims[0]) * weakDims[1] * weakDims[2] * bytesPerCell <= limit)
+    {
+      float weakReached = 0.0f;
+      ScalingRun weak(weakDims, m_Neighborhood, pNuc, m_KineticsOnly, seed, steps, point.threads, static_cast<size_t>(m_TaskGrainSize), &point.weakSeconds, &weakReached);
+      arena.execute(weak);
+    }
 
-  tempPath.update(getDataContainerName(), getCellAttributeMatrixName(), getRecrystallizationTimeArrayName() );
-  m_RecrystallizationTimePtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<uint32_t>, AbstractFilter, uint32_t>(this, tempPath, 0, dims);
-  if( NULL != m_RecrystallizationTimePtr.lock().get() )
-  { m_RecrystallizationTime = m_RecrystallizationTimePtr.lock()->getPointer(0); }
+    //unallocatable lattices leave their times negative
+    const CellularAutomata::ScalingPoint& base = points[0];
+    float* row = m_ScalingStudy + CellularAutomata::ScalingColumns * p;
+    row[0] = static_cast<float>(point.threads);
+    row[1] = static_cast<float>(point.seconds);
+    row[2] = static_cast<float>(point.speedup(base));
+    row[3] = static_cast<float>(point.efficiency(base));
+    row[4] = static_cast<float>(point.weakEfficiency(base));
+    QString ss = QObject::tr("Scaling study: %1 threads, %2 s for %3 steps (speedup %4, efficiency %5%, weak scaling efficiency %6%)")
+                 .arg(point.threads).arg(point.seconds).arg(steps).arg(row[2]).arg(100 * row[3]).arg(100 * row[4]);
+    notifyStatusMessage(getHumanLabel(), ss);
+  }
+}
 
-  tempPath.update(getDataContainerName(), getCellFeatureAttributeMatrixName(), getActiveArrayName() );
-  m_ActivePtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<bool>, AbstractFilter, bool>(this, tempPath, 0, dims);
-  if( NULL != m_ActivePtr.lock().get() )
-  { m_Active = m_ActivePtr.lock()->getPointer(0); }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RecrystalizeVolume::writeFeatureStatistics(const CellularAutomata::FeatureStatistics& statistics)
+{
+  //arrays were resized with the feature attribute matrix
+  int32_t* numCells = m_NumCellsPtr.lock()->getPointer(0);
+  float* volumes = m_VolumesPtr.lock()->getPointer(0);
+  uint32_t* nucleationTime = m_NucleationTimePtr.lock()->getPointer(0);
+  float* nucleationSite = m_NucleationSitePtr.lock()->getPointer(0);
+  float* centroids = m_CentroidsPtr.lock()->getPointer(0);
+  float* boundingBox = m_BoundingBoxPtr.lock()->getPointer(0);
+  size_t numFeatures = m_NumCellsPtr.lock()->getNumberOfTuples();
 
-  tempPath.update(getDataContainerName(), getCellEnsembleAttributeMatrixName(), getRecrystallizationHistoryArrayName() );
-  m_RecrystallizationHistoryPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, dims);
-  if( NULL != m_RecrystallizationHistoryPtr.lock().get() )
-  { m_RecrystallizationHistory = m_RecrystallizationHistoryPtr.lock()->getPointer(0); }
+  CellularAutomata::Lattice lattice(m_Dimensions.x, m_Dimensions.y, m_Dimensions.z);
+  const float res[3] = { m_Resolution.x, m_Resolution.y, m_Resolution.z };
+  const float origin[3] = { m_Origin.x, m_Origin.y, m_Origin.z };
+  const float voxelVolume = res[0] * res[1] * res[2];
+  for(size_t i = 0; i < numFeatures; i++)
+  {
+    //positions are cell centers in physical coordinates (grain 0 and any unused ids are left at 0)
+    if(i >= statistics.features.size() || 0 == i || 0 == statistics.features[i].numCells)
+    {
+      numCells[i] = 0;
+      volumes[i] = 0.0f;
+      nucleationTime[i] = 0;
+      for(size_t j = 0; j < 3; j++)
+      {
+        nucleationSite[3 * i + j] = 0.0f;
+        centroids[3 * i + j] = 0.0f;
+        boundingBox[6 * i + j] = 0.0f;
+        boundingBox[6 * i + 3 + j] = 0.0f;
+      }
+      continue;
+    }
 
-  dims[0] = 2;
-  tempPath.update(getDataContainerName(), getCellEnsembleAttributeMatrixName(), getAvramiArrayName() );
-  m_AvramiPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, dims);
-  if( NULL != m_AvramiPtr.lock().get() )
-  { m_Avrami = m_AvramiPtr.lock()->getPointer(0); }
+    const CellularAutomata::FeatureStatistics::Feature& feature = statistics.features[i];
+    numCells[i] = static_cast<int32_t>(feature.numCells);
+    volumes[i] = feature.numCells * voxelVolume;
+    nucleationTime[i] = feature.nucleationTime;
+    size_t site[3];
+    lattice.ToTuple(feature.nucleationSite, site[0], site[1], site[2]);
+    for(size_t j = 0; j < 3; j++)
+    {
+      nucleationSite[3 * i + j] = origin[j] + (site[j] + 0.5f) * res[j];
+      centroids[3 * i + j] = origin[j] + (static_cast<double>(feature.sum[j]) / feature.numCells + 0.5) * res[j];
+      boundingBox[6 * i + j] = origin[j] + feature.min[j] * res[j];
+      boundingBox[6 * i + 3 + j] = origin[j] + (feature.max[j] + 1) * res[j];
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void RecrystalizeVolume::preflight()
+uint64_t RecrystalizeVolume::getRunSeed()
 {
-  // These are the REQUIRED lines of CODE to make sure the filter behaves correctly
-  setInPreflight(true); // Set the fact that we are preflighting.
-  emit preflightAboutToExecute(); // Emit this signal so that other widgets can do one file update
-  emit updateFilterParameters(this); // Emit this signal to have the widgets push their values down to the filter
-  dataCheck(); // Run our DataCheck to make sure everthing is setup correctly
-  emit preflightExecuted(); // We are done preflighting this filter
-  setInPreflight(false); // Inform the system this filter is NOT in preflight mode anymore.
-
-  /* *** THIS FILTER NEEDS TO BE CHECKED *** */
-  setErrorCondition(0xABABABAB);
-  QString ss = QObject::tr("Filter is NOT updated for IGeometry Redesign. A Programmer needs to check this filter. Please report this to the DREAM3D developers.");
-  notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-  /* *** THIS FILTER NEEDS TO BE CHECKED *** */
+  //runs are only reproducible with a fixed seed
+  if(m_FixedSeed)
+  { return static_cast<uint64_t>(m_Seed); }
+  return static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-const QString RecrystalizeVolume::getCompiledLibraryName()
+CellularAutomata::EnginePlan RecrystalizeVolume::getEnginePlan(size_t activeCells)
 {
-  return CellularAutomata::CellularAutomataBaseName;
+  QString kernel;
+  if(m_KineticsOnly) { kernel = "bit-sliced"; }
+  else if(m_UseMask) { kernel = "masked domain"; }
+  else if(1 == m_Dimensions.z) { kernel = "planar"; }
+  else { kernel = "3D"; }
+
+  //the planar kernel maps the 3D neighborhoods of a slice to their square equivalents
+  int neighborhood = m_Neighborhood;
+  if(!m_KineticsOnly && !m_UseMask && 1 == m_Dimensions.z)
+  {
+    CellularAutomata::Lattice slice(m_Dimensions.x, m_Dimensions.y, 1);
+    neighborhood = RecrystalizeVolumeImpl::KernelNeighborhood(slice, NULL, m_Neighborhood);
+  }
+
+  float pNuc = m_NucleationRate * m_Resolution.x * m_Resolution.y * m_Resolution.z;
+  CellularAutomata::EnginePlan plan = CellularAutomata::PlanEngine(m_Engine, kernel, activeCells, m_UseMask, RecrystalizeVolumeImpl::BlockSize, neighborhood, pNuc, getThreadLimit());
+  if(m_TaskGrainSize > 0)
+  { plan.grainSize = static_cast<size_t>(m_TaskGrainSize); }
+#ifndef DREAM3D_USE_PARALLEL_ALGORITHMS
+  plan.parallel = false;
+  plan.probe = false;
+  plan.reason = "built without parallel algorithms";
+#endif
+  return plan;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-const QString RecrystalizeVolume::getGroupName()
+size_t RecrystalizeVolume::getActiveCells()
 {
-  return "CellularAutomata";
+  size_t numCells = static_cast<size_t>(m_Dimensions.x) * m_Dimensions.y * m_Dimensions.z;
+  if(!m_UseMask || getInPreflight() || NULL == m_Mask) { return numCells; }
+  return static_cast<size_t>(std::count(m_Mask, m_Mask + numCells, true));
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-const QString RecrystalizeVolume::getHumanLabel()
+uint64_t RecrystalizeVolume::getMemoryLimitBytes()
 {
-  return "RecrystalizeVolume";
+  if(m_MemoryLimit > 0) { return static_cast<uint64_t>(m_MemoryLimit * 1024.0 * 1024.0 * 1024.0); }
+  return static_cast<uint64_t>(CellularAutomata::AvailableMemory()) / 5 * 4;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-const QString RecrystalizeVolume::getSubGroupName()
+size_t RecrystalizeVolume::getThreadLimit()
 {
-  return "Misc";
+  size_t threads = HardwareThreads();
+  if(m_MaximumThreads > 0) { return std::min(threads, static_cast<size_t>(m_MaximumThreads)); }
+  return threads;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void RecrystalizeVolume::execute()
+bool RecrystalizeVolume::fitResources(size_t activeCells, CellularAutomata::EnginePlan& plan, CellularAutomata::ResourceEstimate& estimate)
 {
-  int err = 0;
-  // typically run your dataCheck function to make sure you can get that far and all your variables are initialized
-  dataCheck();
-  // Check to make sure you made it through the data check. Errors would have been reported already so if something
-  // happens to fail in the dataCheck() then we simply return
-  if(getErrorCondition() < 0) { return; }
-  setErrorCondition(0);
-
-  //get cretaed data container
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_DataContainerName);
-
-  //get created cell attribute matricies
-  AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(m_CellAttributeMatrixName);
-  AttributeMatrix::Pointer cellFeatureAttrMat = m->getAttributeMatrix(m_CellFeatureAttributeMatrixName);
-  AttributeMatrix::Pointer cellEnsembleAttrMat = m->getAttributeMatrix(m_CellEnsembleAttributeMatrixName);
-
-  // Resize the cell attribute matric
-  QVector<size_t> cellDims(3, 0);
-  cellDims[0] = /* FIXME: ImageGeom */ m->getGeometryAs<ImageGeom>()->getXPoints();
-  cellDims[1] = /* FIXME: ImageGeom */ m->getGeometryAs<ImageGeom>()->getYPoints();
-  cellDims[2] = /* FIXME: ImageGeom */ m->getGeometryAs<ImageGeom>()->getZPoints();
-  cellAttrMat->resizeAttributeArrays(cellDims);
-
-  //convert nucleation rate to probabilty / voxel / timestep
-  float pNuc = m_NucleationRate * m_Resolution.x * m_Resolution.y * m_Resolution.z;
-
-  //determine number of cells and create helper object for indicies
-  size_t numCells = m_Dimensions.x * m_Dimensions.y * m_Dimensions.z;
-  CellularAutomata::Lattice lattice(m_Dimensions.x, m_Dimensions.y, m_Dimensions.z);
-
-  //create arrays to hold gradin ids + recrystallization time
-  QVector<size_t> cDims(1, 1);
-  Int32ArrayType::Pointer currentIDs = m_FeatureIdsPtr.lock();
-  Int32ArrayType::Pointer workingIDs = Int32ArrayType::CreateArray(numCells, cDims, getFeatureIdsArrayName());
-  UInt32ArrayType::Pointer recrstTime = m_RecrystallizationTimePtr.lock();
-
-  //make sure allocation was sucessful
-  if(Int32ArrayType::NullPointer() == workingIDs)
+  CellularAutomata::SimulationRequest request;
+  request.dims[0] = m_Dimensions.x;
+  request.dims[1] = m_Dimensions.y;
+  request.dims[2] = m_Dimensions.z;
+  request.activeCells = activeCells;
+  request.nucleationProbability = m_NucleationRate * m_Resolution.x * m_Resolution.y * m_Resolution.z;
+  request.kineticsOnly = m_KineticsOnly;
+  request.masked = m_UseMask;
+  request.weightedSites = m_HeterogeneousNucleation;
+  request.continued = m_ResumeFromCheckpoint || m_WarmStart;
+  request.checkpoints = m_CheckpointInterval > 0;
+  request.frameInterval = m_FrameInterval > 0 ? static_cast<uint64_t>(m_FrameInterval) : 0;
+  request.featureStatistics = m_FeatureStatistics;
+  request.growthSteps = m_GrainGrowthSteps > 0 ? static_cast<uint64_t>(m_GrainGrowthSteps) : 0;
+  request.stop = getStopCriteria();
+  request.threads = getThreadLimit();
+
+  //the planar kernel runs the square equivalents of the 3D neighborhoods it maps
+  request.neighborhood = m_Neighborhood;
+  if(!m_KineticsOnly && !m_UseMask && 1 == m_Dimensions.z)
   {
-    QString ss = QObject::tr("Unable to allocate memory for working array");
-    setErrorCondition(-1);
-    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-    return;
+    CellularAutomata::Lattice slice(m_Dimensions.x, m_Dimensions.y, 1);
+    request.neighborhood = RecrystalizeVolumeImpl::KernelNeighborhood(slice, NULL, m_Neighborhood);
   }
 
-  //initialize arrays
-  currentIDs->initializeWithValue(0);
-  workingIDs->initializeWithValue(0);
-
-  //initialize variables to track recrystallizatino progress
-#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
-  tbb::atomic<size_t> unrecrstallizedCount;
-  unrecrstallizedCount = 1;
-  tbb::atomic<int32_t> grainCount;
-  grainCount = 0;
-#elif
-  size_t unrecrstallizedCount = 1;
-  int32_t grainCount = 1;
-#endif
-
-  uint32_t timeStep = 1;
-  std::vector<float> recrystallizationHistory;
-  recrystallizationHistory.push_back(0);
-
-  //continue time stepping until all cells are recrystallized
-  while(0 != unrecrstallizedCount)
+  if(m_ParameterSweep)
   {
-    //reset count of remaining cells to recrystallize
-    unrecrstallizedCount = 0;
-
-    //perform time step
-#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
-    bool doParallel = true;
-    if (doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, numCells),
-                        RecrystalizeVolumeImpl(&lattice, currentIDs->getPointer(0), workingIDs->getPointer(0), recrstTime->getPointer(0), m_Neighborhood, &unrecrstallizedCount, &timeStep, &grainCount, pNuc), tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      RecrystalizeVolumeImpl serial(&lattice, currentIDs->getPointer(0), workingIDs->getPointer(0), recrstTime->getPointer(0), m_Neighborhood, &unrecrstallizedCount, &timeStep, &grainCount, pNuc);
-      serial.compute(0, numCells);
-    }
-
-    // swap working + current arrays
-    currentIDs.swap(workingIDs);
-
-    //compute recrstallized percent + update progress
-    float percent = 1 - (static_cast<float>(unrecrstallizedCount) / lattice.size());
-    QString ss = QObject::tr("%1% recrystallized").arg(100 * percent);
-    notifyStatusMessage(getHumanLabel(), ss);
-
-    //only add to history/consider as time step if there is at least some recrystallization (low nucleations rates may require multiple timesteps for the first nuclei to form)
-    if(percent > 0)
+    QVector<float> nucleationRates;
+    QVector<int32_t> neighborhoods;
+    if(!parseSweepParameters(nucleationRates, neighborhoods)) { return false; }
+    float voxelVolume = m_Resolution.x * m_Resolution.y * m_Resolution.z;
+    for(int r = 0; r < nucleationRates.size(); r++)
     {
-      timeStep++;
-      recrystallizationHistory.push_back(percent);
+      for(int n = 0; n < neighborhoods.size(); n++)
+      { request.sweep.push_back(std::make_pair(nucleationRates[r] * voxelVolume, static_cast<int>(neighborhoods[n]))); }
     }
   }
+  else
+  { plan = getEnginePlan(activeCells); }
+  request.parallel = plan.parallel || plan.probe;
+
+  uint64_t limit = getMemoryLimitBytes();
+  bool fits = CellularAutomata::FitMemory(request, limit, plan, estimate);
+  m_EstimatedMemory = QObject::tr("%1 of %2 GB").arg(estimate.memorySummary()).arg(limit / (1024.0 * 1024.0 * 1024.0), 0, 'f', 2);
+  if(0 != plan.windowBlocks || !plan.checkpointSnapshots)
+  { m_EstimatedMemory += QObject::tr(" with %1").arg(0 != plan.windowBlocks ? (plan.checkpointSnapshots ? "a working window" : "a working window and foreground checkpoints") : "foreground checkpoints"); }
+  m_EstimatedRuntime = estimate.runtimeSummary();
+
+  //the mask isn't read during preflight and every cell counts, so only an exact estimate is refused
+  if(!fits && (!m_UseMask || !getInPreflight()))
+  {
+    QString ss = QObject::tr("The simulation needs an estimated %1, more than the memory limit of %2 GB").arg(estimate.memorySummary()).arg(limit / (1024.0 * 1024.0 * 1024.0), 0, 'f', 2);
+    setErrorCondition(-5022);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return false;
+  }
+  return true;
+}
 
-  //clean up working copy
-  workingIDs = Int32ArrayType::NullPointer();
-
-  //resize cell feature attribute matrix
-  QVector<size_t> featureDims(1, grainCount + 1);
-  cellFeatureAttrMat->resizeAttributeArrays(featureDims);
-
-  //fill active array with true (except for grain 0)
-  m_ActivePtr.lock()->initializeWithValue(true);
-  m_ActivePtr.lock()->getPointer(0)[0] = false;
-
-  //fill recrystalization history
-  cDims[0] = recrystallizationHistory.size();
-  FloatArrayType::Pointer history = FloatArrayType::CreateArray(numCells, cDims, getRecrystallizationHistoryArrayName());
-  float* pHistory = history->getPointer(0);
-  for(size_t i = 0; i < recrystallizationHistory.size(); i++)
-  { pHistory[i] = recrystallizationHistory[i]; }
-  cellEnsembleAttrMat->addAttributeArray(getRecrystallizationHistoryArrayName(), history);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+CellularAutomata::StopCriteria RecrystalizeVolume::getStopCriteria()
+{
+  CellularAutomata::StopCriteria stop;
+  stop.targetFraction = m_TargetFraction;
+  stop.maxTimeStep = static_cast<uint32_t>(m_MaxTimeStep);
+  stop.wallClockLimit = m_WallClockLimit;
+  stop.avramiTolerance = m_AvramiTolerance;
+  return stop;
+}
 
-  //assemble linear pairs to fit avrami equation parameters
-  recrystallizationHistory.pop_back();//last step is 100% recrystallized
-  std::vector<float> x;
-  std::vector<float> y;
-  for(size_t i = 1; i < recrystallizationHistory.size(); i++)//first step is 0% recrystallized
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool RecrystalizeVolume::parseSweepParameters(QVector<float>& nucleationRates, QVector<int32_t>& neighborhoods)
+{
+  if(!ParseSweepList(getSweepNucleationRates(), nucleationRates))
   {
-    x.push_back(logf(i));
-    y.push_back( logf( -logf(1.0 - recrystallizationHistory[i]) ) );
+    QString ss = QObject::tr("Sweep Nucleation Rates must be a non empty list of numbers");
+    setErrorCondition(-5006);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return false;
   }
 
-  //perform regression
-  double slope, intercept;
-  if(DREAM3DMath::linearRegression<float>(slope, intercept, x, y))
+  QVector<float> values;
+  neighborhoods.clear();
+  bool valid = ParseSweepList(getSweepNeighborhoods(), values);
+  for(QVector<float>::iterator iter = values.begin(); iter != values.end(); ++iter)
   {
-    m_Avrami[0] = exp(intercept);//k
-    m_Avrami[1] = slope;//n
+    int32_t neighborhood = static_cast<int32_t>(*iter);
+    if(neighborhood != *iter || neighborhood < RecrystalizeVolumeImpl::VON_NEUMAN || neighborhood > RecrystalizeVolumeImpl::HEXAGONAL)
+    { valid = false; }
+    neighborhoods.push_back(neighborhood);
   }
-  else
+  if(!valid)
   {
-    QString ss = QObject::tr("Unable to fit Avrami Parameters");
-    notifyWarningMessage(getHumanLabel(), ss, 1);
+    QString ss = QObject::tr("Sweep Neighborhoods must be a non empty list of neighborhood types (0 - 8)");
+    setErrorCondition(-5007);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return false;
   }
+  for(QVector<int32_t>::iterator iter = neighborhoods.begin(); iter != neighborhoods.end(); ++iter)
+  {
+    if(!checkPlanarNeighborhood(*iter)) { return false; }
+  }
+  return true;
+}
 
-  /* Let the GUI know we are done with this filter */
-  notifyStatusMessage(getHumanLabel(), "Complete");
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool RecrystalizeVolume::checkPlanarNeighborhood(int32_t neighborhood)
+{
+  if(!RecrystalizeVolumeImpl::IsPlanar(neighborhood)) { return true; }
+
+  QString ss;
+  if(1 != m_Dimensions.z)
+  { ss = QObject::tr("The 4 cell, 8 cell and hexagonal neighborhoods require a single slice (z Dimension of 1)"); }
+  else if(RecrystalizeVolumeImpl::HEXAGONAL == neighborhood && 0 != m_Dimensions.y % 2)
+  { ss = QObject::tr("The hexagonal neighborhood requires an even y Dimension (rows alternate between two offsets)"); }
+  if(!ss.isEmpty())
+  {
+    setErrorCondition(-5019);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString RecrystalizeVolume::getEstimatedMemory()
+{
+  return m_EstimatedMemory;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString RecrystalizeVolume::getEstimatedRuntime()
+{
+  return m_EstimatedRuntime;
 }
 
 // -----------------------------------------------------------------------------
@@ -11,6 +11,13 @@
 #include "DREAM3DLib/Common/DREAM3DSetGetMacros.h"
 #include "DREAM3DLib/Common/AbstractFilter.h"
 
+namespace CellularAutomata
+{
+  class FeatureStatistics;
+  struct StopCriteria;
+  struct EnginePlan;
+  struct ResourceEstimate;
+}
 
 /**
  * @class RecrystalizeVolume RecrystalizeVolume.h CellularAutomata/CellularAutomataFilters/RecrystalizeVolume.h
@@ -57,6 +64,33 @@ class RecrystalizeVolume : public AbstractFilter
     DREAM3D_FILTER_PARAMETER(QString, ActiveArrayName)
     Q_PROPERTY(QString ActiveArrayName READ getActiveArrayName WRITE setActiveArrayName)
 
+    DREAM3D_FILTER_PARAMETER(QString, InterfaceAreaArrayName)
+    Q_PROPERTY(QString InterfaceAreaArrayName READ getInterfaceAreaArrayName WRITE setInterfaceAreaArrayName)
+
+    DREAM3D_FILTER_PARAMETER(QString, GrainCountArrayName)
+    Q_PROPERTY(QString GrainCountArrayName READ getGrainCountArrayName WRITE setGrainCountArrayName)
+
+    DREAM3D_FILTER_PARAMETER(QString, ScalingStudyArrayName)
+    Q_PROPERTY(QString ScalingStudyArrayName READ getScalingStudyArrayName WRITE setScalingStudyArrayName)
+
+    DREAM3D_FILTER_PARAMETER(QString, NumCellsArrayName)
+    Q_PROPERTY(QString NumCellsArrayName READ getNumCellsArrayName WRITE setNumCellsArrayName)
+
+    DREAM3D_FILTER_PARAMETER(QString, VolumesArrayName)
+    Q_PROPERTY(QString VolumesArrayName READ getVolumesArrayName WRITE setVolumesArrayName)
+
+    DREAM3D_FILTER_PARAMETER(QString, NucleationTimeArrayName)
+    Q_PROPERTY(QString NucleationTimeArrayName READ getNucleationTimeArrayName WRITE setNucleationTimeArrayName)
+
+    DREAM3D_FILTER_PARAMETER(QString, NucleationSiteArrayName)
+    Q_PROPERTY(QString NucleationSiteArrayName READ getNucleationSiteArrayName WRITE setNucleationSiteArrayName)
+
+    DREAM3D_FILTER_PARAMETER(QString, CentroidsArrayName)
+    Q_PROPERTY(QString CentroidsArrayName READ getCentroidsArrayName WRITE setCentroidsArrayName)
+
+    DREAM3D_FILTER_PARAMETER(QString, BoundingBoxArrayName)
+    Q_PROPERTY(QString BoundingBoxArrayName READ getBoundingBoxArrayName WRITE setBoundingBoxArrayName)
+
     DREAM3D_FILTER_PARAMETER(IntVec3_t, Dimensions)
     Q_PROPERTY(IntVec3_t Dimensions READ getDimensions WRITE setDimensions)
 
@@ -72,6 +106,123 @@ class RecrystalizeVolume : public AbstractFilter
     DREAM3D_FILTER_PARAMETER(unsigned int, Neighborhood)
     Q_PROPERTY(unsigned int Neighborhood READ getNeighborhood WRITE setNeighborhood)
 
+    DREAM3D_FILTER_PARAMETER(unsigned int, Engine)
+    Q_PROPERTY(unsigned int Engine READ getEngine WRITE setEngine)
+
+    DREAM3D_FILTER_PARAMETER(int, MaximumThreads)
+    Q_PROPERTY(int MaximumThreads READ getMaximumThreads WRITE setMaximumThreads)
+
+    DREAM3D_FILTER_PARAMETER(int, TaskGrainSize)
+    Q_PROPERTY(int TaskGrainSize READ getTaskGrainSize WRITE setTaskGrainSize)
+
+    DREAM3D_FILTER_PARAMETER(int, ScalingStudySteps)
+    Q_PROPERTY(int ScalingStudySteps READ getScalingStudySteps WRITE setScalingStudySteps)
+
+    DREAM3D_FILTER_PARAMETER(bool, KineticsOnly)
+    Q_PROPERTY(bool KineticsOnly READ getKineticsOnly WRITE setKineticsOnly)
+
+    DREAM3D_FILTER_PARAMETER(bool, ParameterSweep)
+    Q_PROPERTY(bool ParameterSweep READ getParameterSweep WRITE setParameterSweep)
+
+    DREAM3D_FILTER_PARAMETER(QString, SweepNucleationRates)
+    Q_PROPERTY(QString SweepNucleationRates READ getSweepNucleationRates WRITE setSweepNucleationRates)
+
+    DREAM3D_FILTER_PARAMETER(QString, SweepNeighborhoods)
+    Q_PROPERTY(QString SweepNeighborhoods READ getSweepNeighborhoods WRITE setSweepNeighborhoods)
+
+    DREAM3D_FILTER_PARAMETER(QString, SweepAttributeMatrixName)
+    Q_PROPERTY(QString SweepAttributeMatrixName READ getSweepAttributeMatrixName WRITE setSweepAttributeMatrixName)
+
+    DREAM3D_FILTER_PARAMETER(bool, FixedSeed)
+    Q_PROPERTY(bool FixedSeed READ getFixedSeed WRITE setFixedSeed)
+
+    DREAM3D_FILTER_PARAMETER(int, Seed)
+    Q_PROPERTY(int Seed READ getSeed WRITE setSeed)
+
+    DREAM3D_FILTER_PARAMETER(int, CheckpointInterval)
+    Q_PROPERTY(int CheckpointInterval READ getCheckpointInterval WRITE setCheckpointInterval)
+
+    DREAM3D_FILTER_PARAMETER(QString, CheckpointFile)
+    Q_PROPERTY(QString CheckpointFile READ getCheckpointFile WRITE setCheckpointFile)
+
+    DREAM3D_FILTER_PARAMETER(bool, ResumeFromCheckpoint)
+    Q_PROPERTY(bool ResumeFromCheckpoint READ getResumeFromCheckpoint WRITE setResumeFromCheckpoint)
+
+    DREAM3D_FILTER_PARAMETER(bool, WarmStart)
+    Q_PROPERTY(bool WarmStart READ getWarmStart WRITE setWarmStart)
+
+    DREAM3D_FILTER_PARAMETER(DataArrayPath, InitialFeatureIdsArrayPath)
+    Q_PROPERTY(DataArrayPath InitialFeatureIdsArrayPath READ getInitialFeatureIdsArrayPath WRITE setInitialFeatureIdsArrayPath)
+
+    DREAM3D_FILTER_PARAMETER(DataArrayPath, InitialRecrystallizationTimeArrayPath)
+    Q_PROPERTY(DataArrayPath InitialRecrystallizationTimeArrayPath READ getInitialRecrystallizationTimeArrayPath WRITE setInitialRecrystallizationTimeArrayPath)
+
+    DREAM3D_FILTER_PARAMETER(int, WarmStartTimeStep)
+    Q_PROPERTY(int WarmStartTimeStep READ getWarmStartTimeStep WRITE setWarmStartTimeStep)
+
+    DREAM3D_FILTER_PARAMETER(bool, UseResultCache)
+    Q_PROPERTY(bool UseResultCache READ getUseResultCache WRITE setUseResultCache)
+
+    DREAM3D_FILTER_PARAMETER(QString, ResultCacheDirectory)
+    Q_PROPERTY(QString ResultCacheDirectory READ getResultCacheDirectory WRITE setResultCacheDirectory)
+
+    DREAM3D_FILTER_PARAMETER(int, FrameInterval)
+    Q_PROPERTY(int FrameInterval READ getFrameInterval WRITE setFrameInterval)
+
+    DREAM3D_FILTER_PARAMETER(QString, FrameFile)
+    Q_PROPERTY(QString FrameFile READ getFrameFile WRITE setFrameFile)
+
+    DREAM3D_FILTER_PARAMETER(QString, MetricsFile)
+    Q_PROPERTY(QString MetricsFile READ getMetricsFile WRITE setMetricsFile)
+
+    DREAM3D_FILTER_PARAMETER(QString, CompressedVolumeFile)
+    Q_PROPERTY(QString CompressedVolumeFile READ getCompressedVolumeFile WRITE setCompressedVolumeFile)
+
+    DREAM3D_FILTER_PARAMETER(bool, FeatureStatistics)
+    Q_PROPERTY(bool FeatureStatistics READ getFeatureStatistics WRITE setFeatureStatistics)
+
+    DREAM3D_FILTER_PARAMETER(float, TargetFraction)
+    Q_PROPERTY(float TargetFraction READ getTargetFraction WRITE setTargetFraction)
+
+    DREAM3D_FILTER_PARAMETER(int, MaxTimeStep)
+    Q_PROPERTY(int MaxTimeStep READ getMaxTimeStep WRITE setMaxTimeStep)
+
+    DREAM3D_FILTER_PARAMETER(double, WallClockLimit)
+    Q_PROPERTY(double WallClockLimit READ getWallClockLimit WRITE setWallClockLimit)
+
+    DREAM3D_FILTER_PARAMETER(float, AvramiTolerance)
+    Q_PROPERTY(float AvramiTolerance READ getAvramiTolerance WRITE setAvramiTolerance)
+
+    DREAM3D_FILTER_PARAMETER(bool, FillRemainder)
+    Q_PROPERTY(bool FillRemainder READ getFillRemainder WRITE setFillRemainder)
+
+    DREAM3D_FILTER_PARAMETER(bool, WeightedAvramiFit)
+    Q_PROPERTY(bool WeightedAvramiFit READ getWeightedAvramiFit WRITE setWeightedAvramiFit)
+
+    DREAM3D_FILTER_PARAMETER(int, GrainGrowthSteps)
+    Q_PROPERTY(int GrainGrowthSteps READ getGrainGrowthSteps WRITE setGrainGrowthSteps)
+
+    DREAM3D_FILTER_PARAMETER(bool, HeterogeneousNucleation)
+    Q_PROPERTY(bool HeterogeneousNucleation READ getHeterogeneousNucleation WRITE setHeterogeneousNucleation)
+
+    DREAM3D_FILTER_PARAMETER(DataArrayPath, NucleationWeightsArrayPath)
+    Q_PROPERTY(DataArrayPath NucleationWeightsArrayPath READ getNucleationWeightsArrayPath WRITE setNucleationWeightsArrayPath)
+
+    DREAM3D_FILTER_PARAMETER(bool, UseMask)
+    Q_PROPERTY(bool UseMask READ getUseMask WRITE setUseMask)
+
+    DREAM3D_FILTER_PARAMETER(DataArrayPath, MaskArrayPath)
+    Q_PROPERTY(DataArrayPath MaskArrayPath READ getMaskArrayPath WRITE setMaskArrayPath)
+
+    DREAM3D_FILTER_PARAMETER(double, MemoryLimit)
+    Q_PROPERTY(double MemoryLimit READ getMemoryLimit WRITE setMemoryLimit)
+
+    QString getEstimatedMemory();
+    Q_PROPERTY(QString EstimatedMemory READ getEstimatedMemory)
+
+    QString getEstimatedRuntime();
+    Q_PROPERTY(QString EstimatedRuntime READ getEstimatedRuntime)
+
     /* Place your input parameters here using the DREAM3D macros to declare the Filter Parameters
      * or other instance variables
      */
@@ -181,6 +332,84 @@ class RecrystalizeVolume : public AbstractFilter
     */
     void dataCheck();
 
+    /**
+    * @brief Runs the simulation (or the parameter sweep) of execute() once the plan is known, in the filter's thread arena
+    * @param plan Execution strategy of the simulation
+    */
+    void executeSimulation(CellularAutomata::EnginePlan& plan);
+
+    /**
+    * @brief Runs every combination of the sweep nucleation rates and neighborhoods and fills the sweep results table
+    */
+    void executeParameterSweep();
+
+    /**
+    * @brief Times the first Scaling Study Steps of the simulation on 1, 2, 4 ... up to the thread limit (the same lattice, and
+    * one grown with the thread count) and fills the scaling study table
+    */
+    void executeScalingStudy();
+
+    /**
+    * @brief Parses the sweep nucleation rate and neighborhood lists, setting the error condition if either is invalid
+    * @param nucleationRates Parsed nucleation rates
+    * @param neighborhoods Parsed neighborhood types
+    * @return false if either list is invalid
+    */
+    bool parseSweepParameters(QVector<float>& nucleationRates, QVector<int32_t>& neighborhoods);
+
+    /**
+    * @brief Checks that a single slice neighborhood (4 cell, 8 cell or hexagonal) is only used on a single slice, setting the error condition if not
+    * @param neighborhood Neighborhood type
+    * @return false if the neighborhood can't be used with the dimensions
+    */
+    bool checkPlanarNeighborhood(int32_t neighborhood);
+
+    /**
+    * @brief Returns the seed for this run (the fixed seed if set, otherwise one derived from the clock)
+    */
+    uint64_t getRunSeed();
+
+    /**
+    * @brief Returns the execution strategy for a single simulation (the selected one, or the one picked by the Auto engine)
+    * @param activeCells Number of simulated cells (the lattice, or the cells selected by the mask)
+    */
+    CellularAutomata::EnginePlan getEnginePlan(size_t activeCells);
+
+    /**
+    * @brief Returns the conditions to end a simulation before every cell is recrystallized
+    */
+    CellularAutomata::StopCriteria getStopCriteria();
+
+    /**
+    * @brief Returns the number of simulated cells (the lattice, or the cells selected by the mask once it can be read)
+    */
+    size_t getActiveCells();
+
+    /**
+    * @brief Returns the memory a simulation may use in bytes (the Memory Limit, or 80% of the available memory if it is 0)
+    */
+    uint64_t getMemoryLimitBytes();
+
+    /**
+    * @brief Returns the number of threads a simulation may use (the Maximum Threads, or every hardware thread if it is 0)
+    */
+    size_t getThreadLimit();
+
+    /**
+    * @brief Estimates the peak memory and runtime of the simulation, updates the estimate shown by the filter and picks
+    * the memory strategy of its plan, setting the error condition if no strategy fits the memory limit
+    * @param activeCells Number of simulated cells
+    * @param plan Execution strategy of the simulation (a working window and foreground checkpoints if they are needed)
+    * @param estimate Memory and runtime of the plan
+    * @return false if the simulation doesn't fit
+    */
+    bool fitResources(size_t activeCells, CellularAutomata::EnginePlan& plan, CellularAutomata::ResourceEstimate& estimate);
+
+    /**
+    * @brief Fills the feature statistics arrays (which must already be sized to the number of features)
+    */
+    void writeFeatureStatistics(const CellularAutomata::FeatureStatistics& statistics);
+
   private:
     /* Your private class instance variables go here. You can use several preprocessor macros to help
      * make sure you have all the variables defined correctly. Those are "DEFINE_REQUIRED_DATAARRAY_VARIABLE()"
@@ -191,6 +420,25 @@ class RecrystalizeVolume : public AbstractFilter
     DEFINE_CREATED_DATAARRAY_VARIABLE(bool, Active)
     DEFINE_CREATED_DATAARRAY_VARIABLE(float, RecrystallizationHistory)
     DEFINE_CREATED_DATAARRAY_VARIABLE(float, Avrami)
+    DEFINE_CREATED_DATAARRAY_VARIABLE(float, SweepNucleationRate)
+    DEFINE_CREATED_DATAARRAY_VARIABLE(int32_t, SweepNeighborhood)
+    DEFINE_CREATED_DATAARRAY_VARIABLE(float, SweepAvrami)
+    DEFINE_REQUIRED_DATAARRAY_VARIABLE(int32_t, InitialFeatureIds)
+    DEFINE_REQUIRED_DATAARRAY_VARIABLE(uint32_t, InitialRecrystallizationTime)
+    DEFINE_REQUIRED_DATAARRAY_VARIABLE(float, NucleationWeights)
+    DEFINE_REQUIRED_DATAARRAY_VARIABLE(bool, Mask)
+    DEFINE_CREATED_DATAARRAY_VARIABLE(int32_t, NumCells)
+    DEFINE_CREATED_DATAARRAY_VARIABLE(float, Volumes)
+    DEFINE_CREATED_DATAARRAY_VARIABLE(uint32_t, NucleationTime)
+    DEFINE_CREATED_DATAARRAY_VARIABLE(float, NucleationSite)
+    DEFINE_CREATED_DATAARRAY_VARIABLE(float, Centroids)
+    DEFINE_CREATED_DATAARRAY_VARIABLE(float, BoundingBox)
+    DEFINE_CREATED_DATAARRAY_VARIABLE(float, InterfaceArea)
+    DEFINE_CREATED_DATAARRAY_VARIABLE(int32_t, GrainCount)
+    DEFINE_CREATED_DATAARRAY_VARIABLE(float, ScalingStudy)
+
+    QString m_EstimatedMemory;
+    QString m_EstimatedRuntime;
 
     RecrystalizeVolume(const RecrystalizeVolume&); // Copy Constructor Not Implemented
     void operator=(const RecrystalizeVolume&); // Operator '=' Not Implemented
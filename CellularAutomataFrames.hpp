@@ -0,0 +1,248 @@
+#ifndef _CellularAutomataFrames_H_
+#define _CellularAutomataFrames_H_
+
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+#include <deque>
+
+#include <QtCore/QString>
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QThread>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QWaitCondition>
+
+namespace CellularAutomata
+{
+	/*
+	 * Frame file layout (native byte order): FrameFileHeader followed by frames. Each frame is a FrameHeader followed by
+	 * a zlib (qCompress) block holding the cells that changed since the previous frame as pairs of varints: the distance
+	 * to the previous changed cell index and the new grain id. The first frame is relative to an empty volume, so any
+	 * frame is reconstructed by applying every frame up to it in order.
+	 */
+	struct FrameFileHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t reserved;
+		uint64_t dims[3];
+	};
+
+	struct FrameHeader
+	{
+		uint64_t iteration;//simulation step the frame was taken after
+		uint32_t timeStep;//recrystallization time of the frame (see RecrystallizationTime)
+		uint32_t compressedBytes;
+		uint64_t changedCells;
+	};
+
+	static const char FrameMagic[8] = {'C', 'A', 'R', 'X', 'F', 'R', 'M', 'S'};
+	static const uint32_t FrameVersion = 1;
+
+	inline void AppendVarint(QByteArray& buffer, uint64_t value)
+	{
+		while(value >= 0x80)
+		{
+			buffer.append(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		buffer.append(static_cast<char>(value));
+	}
+
+	inline bool ReadVarint(const char*& pos, const char* end, uint64_t& value)
+	{
+		value = 0;
+		for(int shift = 0; pos != end && shift < 64; shift += 7)
+		{
+			uint8_t byte = static_cast<uint8_t>(*pos++);
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if(0 == (byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+
+	//encodes + writes frames on a background thread, the step loop only hands over the (sorted) changed cells
+	class FrameWriter : public QThread
+	{
+		struct Frame
+		{
+			uint64_t iteration;
+			uint32_t timeStep;
+			std::vector<size_t> indices;
+			std::vector<int32_t> ids;
+		};
+
+		QFile m_file;
+		FrameFileHeader m_header;
+		std::deque<Frame> m_queue;
+		QMutex m_mutex;
+		QWaitCondition m_changed;
+		bool m_finished;
+		bool m_ok;
+
+		//frames waiting to be written before the step loop is throttled
+		static const size_t MaxQueuedFrames = 4;
+
+	public:
+		FrameWriter(const QString& path, const size_t dims[3]) :
+			m_file(path),
+			m_finished(false),
+			m_ok(true)
+		{
+			memset(&m_header, 0, sizeof(m_header));
+			memcpy(m_header.magic, FrameMagic, sizeof(FrameMagic));
+			m_header.version = FrameVersion;
+			m_header.dims[0] = dims[0];
+			m_header.dims[1] = dims[1];
+			m_header.dims[2] = dims[2];
+			m_ok = m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+			       && sizeof(m_header) == m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+			if(m_ok)
+				start();
+		}
+
+		virtual ~FrameWriter()
+		{
+			finish();
+		}
+
+		//queues a frame, indices must be sorted (swapped out of the arguments to avoid a copy)
+		void write(uint64_t iteration, uint32_t timeStep, std::vector<size_t>& indices, std::vector<int32_t>& ids)
+		{
+			QMutexLocker lock(&m_mutex);
+			while(m_ok && m_queue.size() >= MaxQueuedFrames)
+				m_changed.wait(&m_mutex);
+			if(!m_ok)
+				return;
+			m_queue.push_back(Frame());
+			m_queue.back().iteration = iteration;
+			m_queue.back().timeStep = timeStep;
+			m_queue.back().indices.swap(indices);
+			m_queue.back().ids.swap(ids);
+			m_changed.wakeAll();
+		}
+
+		//writes the remaining frames and closes the file, returns true if every frame was written
+		bool finish()
+		{
+			{
+				QMutexLocker lock(&m_mutex);
+				m_finished = true;
+				m_changed.wakeAll();
+			}
+			wait();
+			if(m_file.isOpen())
+				m_file.close();
+			return m_ok;
+		}
+
+	protected:
+		virtual void run()
+		{
+			for(;;)
+			{
+				Frame frame;
+				{
+					QMutexLocker lock(&m_mutex);
+					while(m_queue.empty() && !m_finished)
+						m_changed.wait(&m_mutex);
+					if(m_queue.empty())
+						return;
+					frame.iteration = m_queue.front().iteration;
+					frame.timeStep = m_queue.front().timeStep;
+					frame.indices.swap(m_queue.front().indices);
+					frame.ids.swap(m_queue.front().ids);
+					m_queue.pop_front();
+					m_changed.wakeAll();
+				}
+
+				//delta encode the indices (sorted) and compress
+				QByteArray raw;
+				raw.reserve(static_cast<int>(frame.indices.size() * 4));
+				size_t previous = 0;
+				for(size_t i = 0; i < frame.indices.size(); i++)
+				{
+					AppendVarint(raw, frame.indices[i] - previous);
+					AppendVarint(raw, static_cast<uint32_t>(frame.ids[i]));
+					previous = frame.indices[i];
+				}
+				QByteArray compressed = qCompress(raw);
+
+				FrameHeader header;
+				header.iteration = frame.iteration;
+				header.timeStep = frame.timeStep;
+				header.compressedBytes = static_cast<uint32_t>(compressed.size());
+				header.changedCells = frame.indices.size();
+				bool ok = sizeof(header) == m_file.write(reinterpret_cast<const char*>(&header), sizeof(header))
+				          && compressed.size() == m_file.write(compressed.constData(), compressed.size());
+				if(!ok)
+				{
+					QMutexLocker lock(&m_mutex);
+					m_ok = false;
+					m_queue.clear();
+					m_changed.wakeAll();
+					return;
+				}
+			}
+		}
+	};
+
+	//replays a frame file onto a grain id array
+	class FrameReader
+	{
+		QFile m_file;
+		FrameFileHeader m_header;
+
+	public:
+		FrameReader(const QString& path) :
+			m_file(path)
+		{
+			memset(&m_header, 0, sizeof(m_header));
+		}
+
+		//returns an error message (empty on success)
+		QString open()
+		{
+			if(!m_file.open(QIODevice::ReadOnly))
+				return QString("Unable to open frame file '%1'").arg(m_file.fileName());
+			if(sizeof(m_header) != m_file.read(reinterpret_cast<char*>(&m_header), sizeof(m_header)) || 0 != memcmp(m_header.magic, FrameMagic, sizeof(FrameMagic)))
+				return QString("'%1' is not a frame file").arg(m_file.fileName());
+			if(FrameVersion != m_header.version)
+				return QString("Frame file '%1' has unsupported version %2").arg(m_file.fileName()).arg(m_header.version);
+			return QString();
+		}
+
+		size_t numberOfCells() const
+		{
+			return static_cast<size_t>(m_header.dims[0] * m_header.dims[1] * m_header.dims[2]);
+		}
+
+		//applies the next frame to ids (which must hold the previous frame, initially all 0), returns false at the end of the file or on corrupt data
+		bool next(int32_t* ids, FrameHeader& header)
+		{
+			if(sizeof(header) != m_file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+				return false;
+			QByteArray raw = qUncompress(m_file.read(header.compressedBytes));
+			const char* pos = raw.constData();
+			const char* end = pos + raw.size();
+			size_t index = 0;
+			size_t numCells = numberOfCells();
+			for(uint64_t i = 0; i < header.changedCells; i++)
+			{
+				uint64_t delta, id;
+				if(!ReadVarint(pos, end, delta) || !ReadVarint(pos, end, id))
+					return false;
+				index += static_cast<size_t>(delta);
+				if(index >= numCells)
+					return false;
+				ids[index] = static_cast<int32_t>(id);
+			}
+			return true;
+		}
+	};
+}
+
+#endif
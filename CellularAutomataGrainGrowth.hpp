@@ -0,0 +1,188 @@
+#ifndef _CellularAutomataGrainGrowth_H_
+#define _CellularAutomataGrainGrowth_H_
+
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+
+#include "CellularAutomataHelpers.hpp"
+#include "CellularAutomataRandom.hpp"
+
+namespace CellularAutomata
+{
+	//in plane members of the first 18 Moore neighbors (on a single slice the others are the cell itself)
+	static const size_t SliceMooreNeighbors[8] = {0, 1, 2, 3, 14, 15, 16, 17};
+
+	//Moore neighbors of a cell (26, or the 8 in plane ones on a single slice), returns the number of neighbors
+	inline size_t MooreNeighbors(const Lattice& lattice, size_t index, size_t* neighbors)
+	{
+		if(!lattice.Is2D())
+		{
+			lattice.Neighbors(index, 26, neighbors);
+			return 26;
+		}
+		size_t moore[18];
+		lattice.Neighbors(index, 18, moore);
+		for(size_t n = 0; n < 8; n++)
+			neighbors[n] = moore[SliceMooreNeighbors[n]];
+		return 8;
+	}
+
+	//number of unlike (recrystallized or not) Moore neighbor pairs of ids, each counted from both sides
+	inline uint64_t BoundaryEnergy(const Lattice& lattice, const int32_t* ids)
+	{
+		uint64_t energy = 0;
+		size_t neighbors[26];
+		for(size_t i = 0; i < lattice.size(); i++)
+		{
+			size_t count = MooreNeighbors(lattice, i, neighbors);
+			for(size_t n = 0; n < count; n++)
+			{
+				if(ids[neighbors[n]] != ids[i])
+					energy++;
+			}
+		}
+		return energy;
+	}
+
+	/*
+	 * Curvature driven grain growth of a recrystallized volume: a zero temperature Potts model on the Moore neighborhood (26
+	 * cells, 8 on a single slice) that updates the ids in place. A step visits the cells of the active boundary list in index
+	 * order, each proposes the id of a random unlike neighbor and takes it if that lowers the number of unlike neighbors
+	 * (ties with probability 1/2). Only cells with a neighbor of another grain are listed: flipped cells add their neighbors
+	 * and cells that became interior are dropped after each step, so the interior of the grains is never visited. Cells
+	 * that aren't recrystallized (id <= 0) neither flip nor spread.
+	 */
+	class GrainGrowth
+	{
+		Lattice m_lattice;
+		int32_t* m_ids;
+		std::vector<uint8_t> m_listed;//cell is in the active list (or added to it during the current step)
+		std::vector<size_t> m_active;//sorted
+		std::vector<size_t> m_added;
+
+		//true if a recrystallized cell has a neighbor of another grain
+		bool boundary(size_t index) const
+		{
+			int32_t id = m_ids[index];
+			if(id <= 0)
+				return false;
+			size_t neighborList[26];
+			size_t count = MooreNeighbors(m_lattice, index, neighborList);
+			for(size_t n = 0; n < count; n++)
+			{
+				if(m_ids[neighborList[n]] != id)
+					return true;
+			}
+			return false;
+		}
+
+		//keeps the cells of list that are on a boundary (unlisting the others)
+		void prune(std::vector<size_t>& list)
+		{
+			size_t kept = 0;
+			for(size_t i = 0; i < list.size(); i++)
+			{
+				if(boundary(list[i]))
+					list[kept++] = list[i];
+				else
+					m_listed[list[i]] = 0;
+			}
+			list.resize(kept);
+		}
+
+	public:
+		//lists the boundary cells of ids (a full scan, the only one)
+		GrainGrowth(const Lattice& lattice, int32_t* ids) :
+			m_lattice(lattice),
+			m_ids(ids),
+			m_listed(lattice.size(), 0)
+		{
+			for(size_t i = 0; i < m_lattice.size(); i++)
+			{
+				if(boundary(i))
+				{
+					m_listed[i] = 1;
+					m_active.push_back(i);
+				}
+			}
+		}
+
+		//cells on a grain boundary (sorted)
+		const std::vector<size_t>& active() const
+		{
+			return m_active;
+		}
+
+		//updates the active cells once with the random numbers of stepSeed (block wise, as the recrystallization kernels draw them), returns the number of flips
+		size_t step(uint64_t stepSeed)
+		{
+			size_t flips = 0;
+			size_t neighborList[26];
+			int32_t candidates[26];
+			size_t block = static_cast<size_t>(-1);
+			VariateStream generator(0);
+			for(std::vector<size_t>::const_iterator iter = m_active.begin(); iter != m_active.end(); ++iter)
+			{
+				size_t index = *iter;
+				if(index / RandomBlockSize != block)
+				{
+					block = index / RandomBlockSize;
+					generator = VariateStream(StreamSeed(stepSeed, block));
+				}
+
+				//propose a random unlike recrystallized neighbor (a listed cell may have become interior during this step)
+				int32_t id = m_ids[index];
+				size_t count = MooreNeighbors(m_lattice, index, neighborList);
+				size_t numCandidates = 0;
+				size_t like = 0;
+				for(size_t n = 0; n < count; n++)
+				{
+					int32_t neighbor = m_ids[neighborList[n]];
+					if(neighbor == id)
+						like++;
+					else if(neighbor > 0)
+						candidates[numCandidates++] = neighbor;
+				}
+				if(0 == numCandidates)
+					continue;
+				int32_t candidate = candidates[generator.below(static_cast<uint32_t>(numCandidates))];
+
+				//energy change = unlike neighbors after - before = like before - like after
+				size_t likeCandidate = 0;
+				for(size_t n = 0; n < numCandidates; n++)
+				{
+					if(candidates[n] == candidate)
+						likeCandidate++;
+				}
+				if(likeCandidate < like || (likeCandidate == like && 0 != generator.below(2)))
+					continue;
+
+				//flip and list the neighbors that may have become boundary cells (visited from the next step on)
+				m_ids[index] = candidate;
+				flips++;
+				for(size_t n = 0; n < count; n++)
+				{
+					size_t neighbor = neighborList[n];
+					if(0 == m_listed[neighbor] && m_ids[neighbor] > 0)
+					{
+						m_listed[neighbor] = 1;
+						m_added.push_back(neighbor);
+					}
+				}
+			}
+
+			//drop the cells that became interior and merge the new boundary cells
+			prune(m_active);
+			prune(m_added);
+			std::sort(m_added.begin(), m_added.end());
+			size_t middle = m_active.size();
+			m_active.insert(m_active.end(), m_added.begin(), m_added.end());
+			std::inplace_merge(m_active.begin(), m_active.begin() + middle, m_active.end());
+			m_added.clear();
+			return flips;
+		}
+	};
+}
+
+#endif
@@ -1,19 +1,22 @@
 #ifndef _CellularAutomataHelpers_H_
 #define _CellularAutomataHelpers_H_
 
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
 namespace CellularAutomata
 {
-	//helper class to get neighbors with periodic boundary conditions
+	//helper class to get neighbors with periodic boundary conditions (indices are 64 bit, volumes with fewer than 2^32 cells can
+	//store them in 32 bit tables, see Fits32Bit and Neighbors)
 	class Lattice
 	{
 		size_t dims[3];
-		size_t yDim;
-		size_t zDim;
 		size_t sliceSize;
 		size_t numCells;
 
 		//function to get directional neighbors with periodic boundary conditions
-		inline size_t next(size_t i, size_t direction)
+		inline size_t next(size_t i, size_t direction) const
 		{
 			i++;
 			if(dims[direction] == i)
@@ -21,7 +24,7 @@ namespace CellularAutomata
 			return i;
 		}
 
-		inline size_t prev(size_t i, size_t direction)
+		inline size_t prev(size_t i, size_t direction) const
 		{
 			if(0 == i)
 				i = dims[direction];
@@ -29,7 +32,23 @@ namespace CellularAutomata
 			return i;
 		}
 
+		//wraps a coordinate + offset into [0, dims[direction])
+		inline size_t wrap(size_t i, int64_t offset, size_t direction) const
+		{
+			int64_t dim = static_cast<int64_t>(dims[direction]);
+			int64_t wrapped = (static_cast<int64_t>(i) + offset) % dim;
+			if(wrapped < 0)
+				wrapped += dim;
+			return static_cast<size_t>(wrapped);
+		}
+
 	public:
+		//largest number of cells whose indices (and one padding index) fit in 32 bits
+		static const size_t Max32BitCells = 0xFFFFFFFFu;
+
+		//cells of the 2 shell neighborhood (see ExtendedNeighbors)
+		static const size_t MaxExtendedNeighbors = 124;
+
 		Lattice(size_t x, size_t y, size_t z)
 		{
 			dims[0] = x;
@@ -39,71 +58,204 @@ namespace CellularAutomata
 			numCells = sliceSize * z;
 		}
 
-		size_t size()
+		size_t size() const
 		{
-			return dims[0] * dims[1] * dims[2];
+			return numCells;
+		}
+
+		size_t dimension(size_t direction) const
+		{
+			return dims[direction];
+		}
+
+		//true for a single slice (z = 1), which takes the 2D fast paths
+		bool Is2D() const
+		{
+			return 1 == dims[2];
+		}
+
+		//true if every cell index fits in a 32 bit index table
+		bool Fits32Bit() const
+		{
+			return numCells < Max32BitCells;
 		}
 
 		//given an (x,y,z) tuple compute the index
-		inline size_t ToIndex(size_t x, size_t y, size_t z)
+		inline size_t ToIndex(size_t x, size_t y, size_t z) const
 		{
 			return z * sliceSize + y * dims[0] + x;
 		}
 
 		//given an index compute the (x,y,z) tuple
-		inline void ToTuple(size_t index, size_t& x, size_t& y, size_t& z)
+		inline void ToTuple(size_t index, size_t& x, size_t& y, size_t& z) const
 		{
-			z = index / sliceSize;
-			index -= z * sliceSize;
+			if(1 == dims[2])
+			{
+				z = 0;
+			}
+			else
+			{
+				z = index / sliceSize;
+				index -= z * sliceSize;
+			}
 			y = index / dims[0];
 			x = index - y * dims[0];
 		}
 
 		//given an (x, y, z) tuple and neighbor offset, compute the corresponding neighbor index (with periodic boundary conditions)
-		inline size_t operator() (int x, int y, int z, int dx, int dy, int dz)
+		inline size_t operator() (size_t x, size_t y, size_t z, int64_t dx, int64_t dy, int64_t dz) const
 		{
-			//get neighbor indicies
-			int neighborX = x + dx;
-			int neighborY = y + dy;
-			int neighborZ = z + dz;
-
-			//apply periodic boundary conditions
-			while(neighborX < 0)
-				neighborX += dims[0];
-			while(neighborX >= dims[0])
-				neighborX -= dims[0];
-
-			while(neighborY < 0)
-				neighborY += dims[0];
-			while(neighborY >= dims[0])
-				neighborY -= dims[0];
-
-			while(neighborZ < 0)
-				neighborZ += dims[0];
-			while(neighborZ >= dims[0])
-				neighborZ -= dims[0];
-
-			//convert to index + return
-			return this->ToIndex(neighborX, neighborY, neighborZ);
+			return ToIndex(wrap(x, dx, 0), wrap(y, dy, 1), wrap(z, dz, 2));
 		}
 
 		//given an index and offset, compute the corresponding neighbor index (with periodic boundary conditions)
-		inline size_t operator() (size_t index, int dx, int dy, int dz)
+		inline size_t operator() (size_t index, int64_t dx, int64_t dy, int64_t dz) const
 		{
 			//convert index to tuple
 			size_t x, y, z;
-			this->ToTuple(index, x, y, z);
+			ToTuple(index, x, y, z);
 
 			//return neighbor index
-			return (x, y, z, dx, dy, dz);
+			return (*this)(x, y, z, dx, dy, dz);
+		}
+
+		//writes the first count (6, 18 or 26) neighbors of the Moore order (faces, edges, corners as listed in Moore) to
+		//neighbors, IndexType is uint32_t for volumes that Fits32Bit or uint64_t / size_t for any volume
+		template<typename IndexType>
+		void Neighbors(size_t index, size_t count, IndexType* neighbors) const
+		{
+			size_t x, y, z;
+			ToTuple(index, x, y, z);
+			size_t xPrev = prev(x, 0);
+			size_t xNext = next(x, 0);
+			size_t yPrev = prev(y, 1);
+			size_t yNext = next(y, 1);
+
+			//rows of the 3 slices around the cell (in 2D all 3 are the cell's own slice)
+			size_t rows[3][3];
+			size_t slices[3] = {z * sliceSize, z * sliceSize, z * sliceSize};
+			if(1 != dims[2])
+			{
+				slices[0] = prev(z, 2) * sliceSize;
+				slices[2] = next(z, 2) * sliceSize;
+			}
+			for(size_t k = 0; k < 3; k++)
+			{
+				rows[k][0] = slices[k] + yPrev * dims[0];
+				rows[k][1] = slices[k] + y * dims[0];
+				rows[k][2] = slices[k] + yNext * dims[0];
+			}
+
+			//faces
+			neighbors[0] = static_cast<IndexType>(rows[1][1] + xPrev);
+			neighbors[1] = static_cast<IndexType>(rows[1][1] + xNext);
+			neighbors[2] = static_cast<IndexType>(rows[1][0] + x);
+			neighbors[3] = static_cast<IndexType>(rows[1][2] + x);
+			neighbors[4] = static_cast<IndexType>(rows[0][1] + x);
+			neighbors[5] = static_cast<IndexType>(rows[2][1] + x);
+			if(count <= 6)
+				return;
+
+			//edges
+			neighbors[6] = static_cast<IndexType>(rows[0][0] + x);
+			neighbors[7] = static_cast<IndexType>(rows[2][0] + x);
+			neighbors[8] = static_cast<IndexType>(rows[0][2] + x);
+			neighbors[9] = static_cast<IndexType>(rows[2][2] + x);
+
+			neighbors[10] = static_cast<IndexType>(rows[0][1] + xPrev);
+			neighbors[11] = static_cast<IndexType>(rows[2][1] + xPrev);
+			neighbors[12] = static_cast<IndexType>(rows[0][1] + xNext);
+			neighbors[13] = static_cast<IndexType>(rows[2][1] + xNext);
+
+			neighbors[14] = static_cast<IndexType>(rows[1][0] + xPrev);
+			neighbors[15] = static_cast<IndexType>(rows[1][2] + xPrev);
+			neighbors[16] = static_cast<IndexType>(rows[1][0] + xNext);
+			neighbors[17] = static_cast<IndexType>(rows[1][2] + xNext);
+			if(count <= 18)
+				return;
+
+			//corners
+			neighbors[18] = static_cast<IndexType>(rows[0][0] + xPrev);
+			neighbors[19] = static_cast<IndexType>(rows[2][0] + xPrev);
+			neighbors[20] = static_cast<IndexType>(rows[0][2] + xPrev);
+			neighbors[21] = static_cast<IndexType>(rows[2][2] + xPrev);
+
+			neighbors[22] = static_cast<IndexType>(rows[0][0] + xNext);
+			neighbors[23] = static_cast<IndexType>(rows[2][0] + xNext);
+			neighbors[24] = static_cast<IndexType>(rows[0][2] + xNext);
+			neighbors[25] = static_cast<IndexType>(rows[2][2] + xNext);
+		}
+
+		//writes the 2 shells of 26 connectivity around (x, y, z) to neighbors in the order of ExtendedMoore (124 cells, the 24
+		//cells of the 5 x 5 square on a single slice) and returns their number
+		size_t ExtendedNeighbors(size_t x, size_t y, size_t z, size_t* neighbors) const
+		{
+			size_t xIndicies[5];
+			size_t yIndicies[5];
+			size_t zIndicies[5];
+
+			xIndicies[1] = prev(x, 0);
+			xIndicies[0] = prev(xIndicies[1], 0);
+			xIndicies[2] = x;
+			xIndicies[3] = next(x, 0);
+			xIndicies[4] = next(xIndicies[3], 0);
+
+			yIndicies[1] = prev(y, 1);
+			yIndicies[0] = prev(yIndicies[1], 1);
+			yIndicies[2] = y;
+			yIndicies[3] = next(y, 1);
+			yIndicies[4] = next(yIndicies[3], 1);
+
+			//a single slice has no z neighbors, only the 24 cells of the 5x5 square around the cell are needed
+			size_t count = 0;
+			if(1 == dims[2])
+			{
+				for(size_t i = 0; i < 5; i++)
+				{
+					for(size_t j = 0; j < 5; j++)
+					{
+						if(i == 2 && j == 2)
+							continue;
+						neighbors[count++] = ToIndex(xIndicies[i], yIndicies[j], z);
+					}
+				}
+				return count;
+			}
+
+			zIndicies[1] = prev(z, 2);
+			zIndicies[0] = prev(zIndicies[1], 2);
+			zIndicies[2] = z;
+			zIndicies[3] = next(z, 2);
+			zIndicies[4] = next(zIndicies[3], 2);
+
+			for(size_t i = 0; i < 5; i++)
+			{
+				for(size_t j = 0; j < 5; j++)
+				{
+					for(size_t k = 0; k < 5; k++)
+					{
+						if(i == 2 && j == 2 && k == 2)
+							continue;
+						neighbors[count++] = ToIndex(xIndicies[i], yIndicies[j], zIndicies[k]);
+					}
+				}
+			}
+			return count;
 		}
-		
+
+		size_t ExtendedNeighbors(size_t index, size_t* neighbors) const
+		{
+			size_t x, y, z;
+			ToTuple(index, x, y, z);
+			return ExtendedNeighbors(x, y, z, neighbors);
+		}
+
 		/*
 		 * Functions to get the neighhors of a pixel
 		 */
 
 		 	//6/face connected
-			std::vector<size_t> VonNeumann(size_t x, size_t y, size_t z)
+			std::vector<size_t> VonNeumann(size_t x, size_t y, size_t z) const
 			{
 				//get neighbor indicies
 				size_t xPrev = prev(x, 0);
@@ -123,15 +275,15 @@ namespace CellularAutomata
 				neighbors[5] = ToIndex(x, y, zNext);
 				return neighbors;
 			}
-			std::vector<size_t> VonNeumann(size_t index)
+			std::vector<size_t> VonNeumann(size_t index) const
 			{
-				size_t x, y, z;
-				ToTuple(index, x, y, z);
-				return VonNeumann(x, y, z);
+				std::vector<size_t> neighbors(6, 0);
+				Neighbors(index, 6, &neighbors[0]);
+				return neighbors;
 			}
 
 			//18/face+edge connected
-			std::vector<size_t> EighteenCell(size_t x, size_t y, size_t z)
+			std::vector<size_t> EighteenCell(size_t x, size_t y, size_t z) const
 			{
 				//get neighbor indicies
 				size_t xPrev = prev(x, 0);
@@ -169,15 +321,15 @@ namespace CellularAutomata
 				neighbors[17] = ToIndex(xNext, yNext, z);
 				return neighbors;
 			}
-			std::vector<size_t> EighteenCell(size_t index)
+			std::vector<size_t> EighteenCell(size_t index) const
 			{
-				size_t x, y, z;
-				ToTuple(index, x, y, z);
-				return EighteenCell(x, y, z);
+				std::vector<size_t> neighbors(18, 0);
+				Neighbors(index, 18, &neighbors[0]);
+				return neighbors;
 			}
 
 			//26/face+edge+corner connected
-			std::vector<size_t> Moore(size_t x, size_t y, size_t z)
+			std::vector<size_t> Moore(size_t x, size_t y, size_t z) const
 			{
 				//get neighbor indicies
 				size_t xPrev = prev(x, 0);
@@ -226,59 +378,21 @@ namespace CellularAutomata
 				neighbors[25] = ToIndex(xNext, yNext, zNext);
 				return neighbors;
 			}
-			std::vector<size_t> Moore(size_t index)
+			std::vector<size_t> Moore(size_t index) const
 			{
-				size_t x, y, z;
-				ToTuple(index, x, y, z);
-				return Moore(x, y, z);
+				std::vector<size_t> neighbors(26, 0);
+				Neighbors(index, 26, &neighbors[0]);
+				return neighbors;
 			}
 
 			//2 shells of 26 connectivity (26 connected neighborhood of all 26 connected neighbors)
-			std::vector<size_t> ExtendedMoore(size_t x, size_t y, size_t z)
+			std::vector<size_t> ExtendedMoore(size_t x, size_t y, size_t z) const
 			{
-				//get neighbor indicies
-				size_t xIndicies[5];
-				size_t yIndicies[5];
-				size_t zIndicies[5];
-
-				xIndicies[1] = prev(x, 0);
-				xIndicies[0] = prev(xIndicies[1], 0);
-				xIndicies[2] = x;
-				xIndicies[3] = next(x, 0);
-				xIndicies[4] = next(xIndicies[3], 0);
-
-				yIndicies[1] = prev(y, 0);
-				yIndicies[0] = prev(yIndicies[1], 0);
-				yIndicies[2] = y;
-				yIndicies[3] = next(y, 0);
-				yIndicies[4] = next(yIndicies[3], 0);
-
-				zIndicies[1] = prev(z, 0);
-				zIndicies[0] = prev(zIndicies[1], 0);
-				zIndicies[2] = z;
-				zIndicies[3] = next(z, 0);
-				zIndicies[4] = next(zIndicies[3], 0);
-
-				//compute neigbors
-				std::vector<size_t> neighbors;
-				neighbors.reserve(124);
-
-				//get all neighbors
-				for(size_t i = 0; i < 5; i++)
-				{
-					for(size_t j = 0; j < 5; j++)
-					{
-						for(size_t k = 0; k < 5; k++)
-						{
-							if(i == 2 && j == 2 && k == 2)
-								continue;
-							neighbors.push_back( ToIndex(xIndicies[i], yIndicies[j], zIndicies[k]) );
-						}
-					}
-				}				
-				return neighbors;
+				size_t neighbors[MaxExtendedNeighbors];
+				size_t count = ExtendedNeighbors(x, y, z, neighbors);
+				return std::vector<size_t>(neighbors, neighbors + count);
 			}
-			std::vector<size_t> ExtendedMoore(size_t index)
+			std::vector<size_t> ExtendedMoore(size_t index) const
 			{
 				size_t x, y, z;
 				ToTuple(index, x, y, z);
@@ -287,7 +401,7 @@ namespace CellularAutomata
 
 			//face connected + 2 opposing edge connected (~spherical)
 			//Eight cell has 6 variants in 3d (6 opposing pairs of edges)
-			std::vector<size_t> EightCell(size_t x, size_t y, size_t z, size_t variant)
+			std::vector<size_t> EightCell(size_t x, size_t y, size_t z, size_t variant) const
 			{
 				//get neighbor indicies
 				size_t xPrev = prev(x, 0);
@@ -343,7 +457,7 @@ namespace CellularAutomata
 				}
 				return neighbors;
 			}
-			std::vector<size_t> EightCell(size_t index, size_t variant)
+			std::vector<size_t> EightCell(size_t index, size_t variant) const
 			{
 				size_t x, y, z;
 				ToTuple(index, x, y, z);
@@ -353,7 +467,7 @@ namespace CellularAutomata
 
 			//6 connected + 2 opposing corner connected + adjacent edge connected
 			//Fourteen cell has 4 variants in 3d (4 opposing pairs of corners)
-			std::vector<size_t> FourteenCell(size_t x, size_t y, size_t z, size_t variant)
+			std::vector<size_t> FourteenCell(size_t x, size_t y, size_t z, size_t variant) const
 			{
 				//get neighbor indicies
 				size_t xPrev = prev(x, 0);
@@ -423,7 +537,7 @@ namespace CellularAutomata
 				}				
 				return neighbors;
 			}
-			std::vector<size_t> FourteenCell(size_t index, size_t variant)
+			std::vector<size_t> FourteenCell(size_t index, size_t variant) const
 			{
 				size_t x, y, z;
 				ToTuple(index, x, y, z);
@@ -432,7 +546,7 @@ namespace CellularAutomata
 
 			//face connected + edge connected + 2 opposing corner connected
 			//Twnety cell has 4 variants in 3d (4 opposing pairs of corners)
-			std::vector<size_t> TwentyCell(size_t x, size_t y, size_t z, size_t variant)
+			std::vector<size_t> TwentyCell(size_t x, size_t y, size_t z, size_t variant) const
 			{
 				//get neighbor indicies
 				size_t xPrev = prev(x, 0);
@@ -495,13 +609,18 @@ namespace CellularAutomata
 				
 				return neighbors;
 			}
-			std::vector<size_t> TwentyCell(size_t index, size_t variant)
+			std::vector<size_t> TwentyCell(size_t index, size_t variant) const
 			{
 				size_t x, y, z;
 				ToTuple(index, x, y, z);
 				return TwentyCell(x, y, z, variant);
 			}
 	};
+
+	//indicies into the Moore neighbor list (see Lattice::Neighbors) for the randomly selected parts of the variant neighborhoods
+	static const size_t EightCellEdges[6][2] = { {14, 17}, {15, 16}, {10, 13}, {11, 12}, {6, 9}, {7, 8} };
+	static const size_t FourteenCellCorners[4][8] = { {18, 6, 10, 14, 25, 9, 13, 17}, {19, 7, 11, 14, 24, 8, 12, 17}, {20, 8, 10, 15, 23, 7, 13, 16}, {21, 9, 11, 15, 22, 6, 12, 16} };
+	static const size_t TwentyCellCorners[4][2] = { {18, 25}, {19, 24}, {20, 23}, {21, 22} };
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,169 @@
+#ifndef _CellularAutomataKinetics_H_
+#define _CellularAutomataKinetics_H_
+
+#include <stdint.h>
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+
+namespace CellularAutomata
+{
+	//running sums of the linearized avrami pairs log(t), log(-log(1 - f)) so K and n are available after every step. The
+	//weighted sums weight each pair by the inverse of its variance (binomial variance of f propagated through the
+	//linearization, w = (1 - f) log(1 - f)^2 / f), which keeps the noisy first and last steps from dominating the fit.
+	class AvramiRegression
+	{
+		struct Sums
+		{
+			Sums() : weight(0), x(0), y(0), xy(0), xx(0) {}
+
+			void add(double w, double px, double py)
+			{
+				weight += w;
+				x += w * px;
+				y += w * py;
+				xy += w * px * py;
+				xx += w * px * px;
+			}
+
+			bool fit(double& k, double& n) const
+			{
+				double denominator = weight * xx - x * x;
+				if(weight <= 0 || denominator <= 0)
+					return false;
+				n = (weight * xy - x * y) / denominator;
+				k = std::exp((y - n * x) / weight);
+				return true;
+			}
+
+			double weight;
+			double x;
+			double y;
+			double xy;
+			double xx;
+		};
+
+		bool m_weighted;
+		size_t m_count;
+		size_t m_nextState;
+		Sums m_sums;
+		Sums m_weightedSums;
+
+	public:
+		AvramiRegression(bool weighted = false) : m_weighted(weighted), m_count(0), m_nextState(0) {}
+
+		//adds the recrystallized fraction f at time t (fractions of 0 or 1 have no linearized value and are skipped)
+		void add(double t, double f)
+		{
+			if(t <= 0 || f <= 0 || f >= 1)
+				return;
+			double x = std::log(t);
+			double y = std::log(-std::log(1.0 - f));
+			double w = (1.0 - f) * std::log(1.0 - f) * std::log(1.0 - f) / f;
+			m_count++;
+			m_sums.add(1.0, x, y);
+			m_weightedSums.add(w, x, y);
+		}
+
+		//adds the states of a history (fraction recrystallized at each step, starting from the empty volume) that haven't been added yet
+		void update(const std::vector<float>& history)
+		{
+			for(; m_nextState < history.size(); m_nextState++)
+				add(static_cast<double>(m_nextState), history[m_nextState]);
+		}
+
+		size_t count() const
+		{
+			return m_count;
+		}
+
+		//least squares fit (weighted if requested at construction), returns false if there are too few (distinct) points
+		bool fit(double& k, double& n) const
+		{
+			if(m_count < 2)
+				return false;
+			return m_weighted ? m_weightedSums.fit(k, n) : m_sums.fit(k, n);
+		}
+	};
+
+	//conditions to end a simulation before every cell is recrystallized (0 disables a limit)
+	struct StopCriteria
+	{
+		StopCriteria() : targetFraction(1.0f), maxTimeStep(0), wallClockLimit(0.0), avramiTolerance(0.0f) {}
+
+		float targetFraction;//recrystallized fraction
+		uint32_t maxTimeStep;//recorded time steps (steps before the first nucleation aren't counted)
+		double wallClockLimit;//seconds
+		float avramiTolerance;//relative change of K and n between steps
+	};
+
+	enum StopReason
+	{
+		NotStopped = 0,
+		Completed,
+		TargetFractionReached,
+		MaxTimeStepReached,
+		WallClockLimitReached,
+		AvramiConverged
+	};
+
+	//checks the stop criteria against the recrystallization history after every step (the history is also added to regression)
+	class StopMonitor
+	{
+		StopCriteria m_criteria;
+		AvramiRegression& m_regression;
+		QElapsedTimer m_timer;
+		size_t m_fitted;
+		double m_k;
+		double m_n;
+		size_t m_stableSteps;
+
+		//consecutive steps the avrami parameters have to stay within tolerance
+		static const size_t StableSteps = 3;
+
+	public:
+		StopMonitor(const StopCriteria& criteria, AvramiRegression& regression) :
+			m_criteria(criteria),
+			m_regression(regression),
+			m_fitted(0),
+			m_k(0),
+			m_n(0),
+			m_stableSteps(0)
+		{
+			m_timer.start();
+		}
+
+		//history holds the recrystallized fraction of every recorded state (the first is the empty volume)
+		StopReason update(const std::vector<float>& history)
+		{
+			m_regression.update(history);
+			bool added = m_regression.count() != m_fitted;
+			m_fitted = m_regression.count();
+
+			//completion is decided by the caller (the fraction of a large volume can round to 1 before the last cell is done)
+			float fraction = history.empty() ? 0.0f : history.back();
+			if(m_criteria.targetFraction < 1.0f && fraction >= m_criteria.targetFraction)
+				return TargetFractionReached;
+			if(0 != m_criteria.maxTimeStep && history.size() > m_criteria.maxTimeStep)
+				return MaxTimeStepReached;
+			if(m_criteria.wallClockLimit > 0 && m_timer.elapsed() > m_criteria.wallClockLimit * 1000.0)
+				return WallClockLimitReached;
+
+			//the estimate has converged once K and n change less than the tolerance for several steps in a row
+			double k, n;
+			if(m_criteria.avramiTolerance > 0 && added && m_regression.fit(k, n))
+			{
+				bool stable = m_k > 0 && std::fabs(k - m_k) <= m_criteria.avramiTolerance * m_k && std::fabs(n - m_n) <= m_criteria.avramiTolerance * std::fabs(m_n);
+				m_stableSteps = stable ? m_stableSteps + 1 : 0;
+				m_k = k;
+				m_n = n;
+				if(m_stableSteps >= StableSteps)
+					return AvramiConverged;
+			}
+			return NotStopped;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef _CellularAutomataLaneMasks_H_
+#define _CellularAutomataLaneMasks_H_
+
+#include <stdint.h>
+#include <cstddef>
+
+//the 3D kernel checks 8 cells at once with AVX2 when compiled for it, otherwise GCC / Clang / MSVC on x86-64 compile an
+//AVX2 variant alongside and pick it at run time if the processor supports it
+#if defined(__AVX2__)
+#define CELLULAR_AUTOMATA_AVX2
+#define CELLULAR_AUTOMATA_AVX2_TARGET
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CELLULAR_AUTOMATA_AVX2
+#define CELLULAR_AUTOMATA_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define CELLULAR_AUTOMATA_AVX2
+#define CELLULAR_AUTOMATA_AVX2_TARGET
+#endif
+
+#ifdef CELLULAR_AUTOMATA_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace CellularAutomata
+{
+	//cells whose state is checked at once by the frontier check of a row
+	static const size_t RowLanes = 8;
+
+	//true if the AVX2 lane masks can run on this processor (and operating system)
+	inline bool HasAVX2()
+	{
+#if defined(__AVX2__)
+		return true;
+#elif defined(CELLULAR_AUTOMATA_AVX2) && defined(__GNUC__)
+		static const bool avx2 = 0 != __builtin_cpu_supports("avx2");
+		return avx2;
+#elif defined(CELLULAR_AUTOMATA_AVX2)
+		//cpuid leaf 7 reports AVX2, the operating system has to save the ymm registers (OSXSAVE + XCR0 bits 1, 2)
+		int info[4];
+		__cpuid(info, 0);
+		if(info[0] < 7)
+			return false;
+		__cpuid(info, 1);
+		if(0 == (info[2] & (1 << 27)) || 0 == (info[2] & (1 << 28)) || 6 != (_xgetbv(0) & 6))
+			return false;
+		__cpuidex(info, 7, 0);
+		return 0 != (info[1] & (1 << 5));
+#else
+		return false;
+#endif
+	}
+
+	/*
+	 * Lane masks of the frontier check. window holds the 3 x 3 x rows around a row (slot (dy + 1) + 3 * (dz + 1)), reach
+	 * gives for each slot the columns a neighborhood can reach around a cell's column: 0 none, 1 the column itself, 3 the
+	 * column +- 1.
+	 */
+
+	//recrystallized (own) and reachable (a neighborhood could include a recrystallized cell) bits of the cells
+	//x .. x + lanes - 1 of a row, columns wrap around the row
+	inline void LaneMasks(const int32_t* const* window, const size_t* reach, size_t x, size_t lanes, size_t dimX, uint32_t& own, uint32_t& reachable)
+	{
+		own = 0;
+		reachable = 0;
+		for(size_t lane = 0; lane < lanes; lane++)
+		{
+			size_t column = x + lane;
+			size_t columns[3] = { 0 == column ? dimX - 1 : column - 1, column, dimX - 1 == column ? 0 : column + 1 };
+			int32_t any = 0;
+			for(size_t slot = 0; slot < 9; slot++)
+			{
+				if(1 == reach[slot])
+					any |= window[slot][column];
+				else if(3 == reach[slot])
+					any |= window[slot][columns[0]] | window[slot][columns[1]] | window[slot][columns[2]];
+			}
+			if(0 != window[4][column])
+				own |= 1u << lane;
+			if(0 != any)
+				reachable |= 1u << lane;
+		}
+	}
+
+#ifdef CELLULAR_AUTOMATA_AVX2
+	//LaneMasks for RowLanes (8) cells that don't touch the ends of the row (1 <= x, x + 9 <= dimX), only call if HasAVX2()
+	CELLULAR_AUTOMATA_AVX2_TARGET inline void LaneMasksAVX2(const int32_t* const* window, const size_t* reach, size_t x, uint32_t& own, uint32_t& reachable)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		__m256i any = zero;
+		for(size_t slot = 0; slot < 9; slot++)
+		{
+			if(0 == reach[slot])
+				continue;
+			const int32_t* row = window[slot] + x;
+			any = _mm256_or_si256(any, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row)));
+			if(3 == reach[slot])
+			{
+				any = _mm256_or_si256(any, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row - 1)));
+				any = _mm256_or_si256(any, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + 1)));
+			}
+		}
+		__m256i center = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(window[4] + x));
+		own = ~static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(center, zero)))) & 0xFFu;
+		reachable = ~static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(any, zero)))) & 0xFFu;
+	}
+#endif
+}
+
+#endif
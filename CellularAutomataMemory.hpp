@@ -0,0 +1,112 @@
+#ifndef _CellularAutomataMemory_H_
+#define _CellularAutomataMemory_H_
+
+#include <cstddef>
+#include <cstdio>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <sys/types.h>
+#include <sys/sysctl.h>
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace CellularAutomata
+{
+	//total physical memory in bytes (0 if unknown)
+	inline size_t PhysicalMemory()
+	{
+#if defined(_WIN32)
+		MEMORYSTATUSEX status;
+		status.dwLength = sizeof(status);
+		if(!GlobalMemoryStatusEx(&status))
+			return 0;
+		return static_cast<size_t>(status.ullTotalPhys);
+#elif defined(__APPLE__)
+		int mib[2] = {CTL_HW, HW_MEMSIZE};
+		int64_t memory = 0;
+		size_t length = sizeof(memory);
+		if(0 != sysctl(mib, 2, &memory, &length, NULL, 0))
+			return 0;
+		return static_cast<size_t>(memory);
+#else
+		long pages = sysconf(_SC_PHYS_PAGES);
+		long pageSize = sysconf(_SC_PAGE_SIZE);
+		if(pages <= 0 || pageSize <= 0)
+			return 0;
+		return static_cast<size_t>(pages) * static_cast<size_t>(pageSize);
+#endif
+	}
+
+	//physical memory in bytes that can be allocated without swapping (falls back to the total physical memory if unknown)
+	inline size_t AvailableMemory()
+	{
+#if defined(_WIN32)
+		MEMORYSTATUSEX status;
+		status.dwLength = sizeof(status);
+		if(!GlobalMemoryStatusEx(&status))
+			return 0;
+		return static_cast<size_t>(status.ullAvailPhys);
+#elif defined(__APPLE__)
+		return PhysicalMemory();
+#else
+		//MemAvailable accounts for reclaimable page cache, free pages alone underestimate
+		FILE* meminfo = fopen("/proc/meminfo", "r");
+		if(NULL != meminfo)
+		{
+			char line[256];
+			unsigned long long kiloBytes = 0;
+			while(NULL != fgets(line, sizeof(line), meminfo))
+			{
+				if(1 == sscanf(line, "MemAvailable: %llu kB", &kiloBytes))
+				{
+					fclose(meminfo);
+					return static_cast<size_t>(kiloBytes) * 1024;
+				}
+			}
+			fclose(meminfo);
+		}
+		long pages = sysconf(_SC_AVPHYS_PAGES);
+		long pageSize = sysconf(_SC_PAGE_SIZE);
+		if(pages <= 0 || pageSize <= 0)
+			return PhysicalMemory();
+		return static_cast<size_t>(pages) * static_cast<size_t>(pageSize);
+#endif
+	}
+
+	//resident memory of this process in bytes (0 if unknown)
+	inline size_t ResidentMemory()
+	{
+#if defined(_WIN32)
+		PROCESS_MEMORY_COUNTERS counters;
+		if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return 0;
+		return static_cast<size_t>(counters.WorkingSetSize);
+#elif defined(__APPLE__)
+		mach_task_basic_info_data_t info;
+		mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+		if(KERN_SUCCESS != task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count))
+			return 0;
+		return static_cast<size_t>(info.resident_size);
+#else
+		//the second field of statm is the number of resident pages
+		FILE* statm = fopen("/proc/self/statm", "r");
+		if(NULL == statm)
+			return 0;
+		unsigned long long pages = 0, resident = 0;
+		int fields = fscanf(statm, "%llu %llu", &pages, &resident);
+		fclose(statm);
+		long pageSize = sysconf(_SC_PAGE_SIZE);
+		if(2 != fields || pageSize <= 0)
+			return 0;
+		return static_cast<size_t>(resident) * static_cast<size_t>(pageSize);
+#endif
+	}
+}
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef _CellularAutomataMetrics_H_
+#define _CellularAutomataMetrics_H_
+
+#include <stdint.h>
+#include <deque>
+#include <limits>
+
+#include <QtCore/QString>
+#include <QtCore/QByteArray>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QWaitCondition>
+#include <QtCore/QElapsedTimer>
+
+#include "CellularAutomataMemory.hpp"
+
+namespace CellularAutomata
+{
+	//health of a running simulation after a step
+	struct SimulationMetrics
+	{
+		SimulationMetrics() : iteration(0), timeStep(0), fraction(0.0f), cellsPerSecond(0.0), grainCount(-1), residentBytes(0), etaSeconds(-1.0), finished(false) {}
+
+		uint64_t iteration;//steps taken
+		uint64_t timeStep;//recorded time steps
+		float fraction;//recrystallized
+		double cellsPerSecond;//cell updates of the last step
+		int64_t grainCount;//negative if not tracked
+		size_t residentBytes;//of the process (filled in by the writer)
+		double etaSeconds;//until the target fraction is reached, negative while unknown
+		bool finished;
+	};
+
+	//appends a metric in the Prometheus text exposition format (NaN marks an unknown value)
+	inline void AppendMetric(QByteArray& text, const char* name, const char* type, const char* help, double value)
+	{
+		text.append("# HELP ").append(name).append(' ').append(help).append('\n');
+		text.append("# TYPE ").append(name).append(' ').append(type).append('\n');
+		text.append(name).append(' ');
+		if(value != value)
+			text.append("NaN");
+		else
+			text.append(QByteArray::number(value, 'g', 15));
+		text.append('\n');
+	}
+
+	//metrics as a Prometheus text file (e.g. for the textfile collector of a node exporter)
+	inline QByteArray FormatMetrics(const SimulationMetrics& metrics)
+	{
+		const double unknown = std::numeric_limits<double>::quiet_NaN();
+		QByteArray text;
+		AppendMetric(text, "recrystallization_steps_total", "counter", "Simulation steps taken.", static_cast<double>(metrics.iteration));
+		AppendMetric(text, "recrystallization_time_step", "gauge", "Recorded time steps (steps before the first nucleation aren't recorded).", static_cast<double>(metrics.timeStep));
+		AppendMetric(text, "recrystallization_fraction", "gauge", "Recrystallized fraction of the volume.", metrics.fraction);
+		AppendMetric(text, "recrystallization_cells_per_second", "gauge", "Cell updates per second of the last step.", metrics.cellsPerSecond);
+		if(metrics.grainCount >= 0)
+			AppendMetric(text, "recrystallization_grain_count", "gauge", "Grains nucleated so far.", static_cast<double>(metrics.grainCount));
+		AppendMetric(text, "process_resident_memory_bytes", "gauge", "Resident memory size in bytes.", static_cast<double>(metrics.residentBytes));
+		AppendMetric(text, "recrystallization_eta_seconds", "gauge", "Estimated seconds until the target fraction is reached.", metrics.etaSeconds < 0.0 ? unknown : metrics.etaSeconds);
+		AppendMetric(text, "recrystallization_finished", "gauge", "1 once the simulation has stopped.", metrics.finished ? 1.0 : 0.0);
+		return text;
+	}
+
+	/*
+	 * Throughput and remaining time of a running simulation from the wall clock time of its steps. The front moves one
+	 * cell per step, so the recrystallized fraction gained per second over the last Window steps is the current volume
+	 * swept by the front (its area times its velocity); the remaining fraction is extrapolated at that rate. The estimate
+	 * follows the slowing of the front as grains impinge, and is unknown until the front has moved.
+	 */
+	class ProgressEstimate
+	{
+		float m_targetFraction;
+		QElapsedTimer m_timer;
+		double m_previous;//seconds at the previous step
+		std::deque<double> m_seconds;
+		std::deque<float> m_fractions;
+
+	public:
+		static const size_t Window = 8;
+
+		explicit ProgressEstimate(float targetFraction) :
+			m_targetFraction(targetFraction),
+			m_previous(0.0)
+		{
+			m_timer.start();
+		}
+
+		//records a step that updated cells cells and reached fraction, and fills the throughput and remaining time of metrics
+		void step(size_t cells, float fraction, SimulationMetrics& metrics)
+		{
+			double now = m_timer.nsecsElapsed() * 1.0e-9;
+			metrics.cellsPerSecond = now > m_previous ? cells / (now - m_previous) : 0.0;
+			m_previous = now;
+
+			m_seconds.push_back(now);
+			m_fractions.push_back(fraction);
+			if(m_seconds.size() > Window + 1)
+			{
+				m_seconds.pop_front();
+				m_fractions.pop_front();
+			}
+			double rate = now > m_seconds.front() ? (fraction - m_fractions.front()) / (now - m_seconds.front()) : 0.0;
+			if(fraction >= m_targetFraction)
+				metrics.etaSeconds = 0.0;
+			else
+				metrics.etaSeconds = rate > 0.0 ? (m_targetFraction - fraction) / rate : -1.0;
+		}
+	};
+
+	/*
+	 * Writes the latest metrics of a simulation to a file on a background thread, replacing the file atomically so a
+	 * scraper never reads a partial one. Publishing never waits for the file: samples published while one is written
+	 * replace each other and only the newest is written next. The resident memory is read on the writer's thread too.
+	 */
+	class MetricsWriter : public QThread
+	{
+		QString m_path;
+		SimulationMetrics m_pending;
+		bool m_published;
+		QMutex m_mutex;
+		QWaitCondition m_changed;
+		bool m_finished;
+		bool m_ok;
+
+	public:
+		MetricsWriter(const QString& path) :
+			m_path(path),
+			m_published(false),
+			m_finished(false),
+			m_ok(true)
+		{
+			start();
+		}
+
+		virtual ~MetricsWriter()
+		{
+			finish();
+		}
+
+		//hands over the metrics of a step
+		void publish(const SimulationMetrics& metrics)
+		{
+			QMutexLocker lock(&m_mutex);
+			m_pending = metrics;
+			m_published = true;
+			m_changed.wakeAll();
+		}
+
+		//writes the last metrics published and stops, returns true if every write succeeded
+		bool finish()
+		{
+			{
+				QMutexLocker lock(&m_mutex);
+				m_finished = true;
+				m_changed.wakeAll();
+			}
+			wait();
+			return m_ok;
+		}
+
+		QString getPath() const
+		{
+			return m_path;
+		}
+
+	protected:
+		virtual void run()
+		{
+			for(;;)
+			{
+				SimulationMetrics metrics;
+				{
+					QMutexLocker lock(&m_mutex);
+					while(!m_published && !m_finished)
+						m_changed.wait(&m_mutex);
+					if(!m_published)
+						return;
+					metrics = m_pending;
+					m_published = false;
+				}
+
+				//QSaveFile only replaces the previous file once the new one is completely written
+				metrics.residentBytes = ResidentMemory();
+				QByteArray text = FormatMetrics(metrics);
+				QSaveFile file(m_path);
+				bool ok = file.open(QIODevice::WriteOnly)
+				          && text.size() == file.write(text.constData(), text.size())
+				          && file.commit();
+				if(!ok)
+				{
+					QMutexLocker lock(&m_mutex);
+					m_ok = false;
+					return;
+				}
+			}
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef _CellularAutomataNucleation_H_
+#define _CellularAutomataNucleation_H_
+
+#include <stdint.h>
+#include <cmath>
+#include <vector>
+
+namespace CellularAutomata
+{
+	//Walker / Vose alias table over the cells with a positive weight, draws cell i with probability weight[i] / sum(weights)
+	//in constant time (built once in linear time)
+	class AliasTable
+	{
+		std::vector<size_t> m_sites;//cell index of each candidate
+		std::vector<double> m_probability;//probability of keeping a candidate's own column (vs its alias)
+		std::vector<size_t> m_alias;
+		double m_totalWeight;
+
+	public:
+		AliasTable() : m_totalWeight(0) {}
+
+		//builds the table from one weight per cell, returns false if there are no candidates (or a weight is negative / not finite)
+		bool build(const float* weights, size_t numCells)
+		{
+			m_sites.clear();
+			m_totalWeight = 0;
+			for(size_t i = 0; i < numCells; i++)
+			{
+				if(!(weights[i] >= 0) || weights[i] > 3.0e38f)
+					return false;
+				if(weights[i] > 0)
+				{
+					m_sites.push_back(i);
+					m_totalWeight += weights[i];
+				}
+			}
+			size_t count = m_sites.size();
+			if(0 == count)
+				return false;
+
+			//scale so the average column is 1, then pair each underfull column with an overfull one
+			m_probability.resize(count);
+			m_alias.resize(count);
+			std::vector<size_t> small, large;
+			for(size_t i = 0; i < count; i++)
+			{
+				m_probability[i] = weights[m_sites[i]] * count / m_totalWeight;
+				m_alias[i] = i;
+				if(m_probability[i] < 1.0)
+					small.push_back(i);
+				else
+					large.push_back(i);
+			}
+			while(!small.empty() && !large.empty())
+			{
+				size_t s = small.back();
+				small.pop_back();
+				size_t l = large.back();
+				m_alias[s] = l;
+				m_probability[l] -= 1.0 - m_probability[s];
+				if(m_probability[l] < 1.0)
+				{
+					large.pop_back();
+					small.push_back(l);
+				}
+			}
+
+			//whatever is left is full up to rounding
+			for(size_t i = 0; i < small.size(); i++)
+				m_probability[small[i]] = 1.0;
+			for(size_t i = 0; i < large.size(); i++)
+				m_probability[large[i]] = 1.0;
+			return true;
+		}
+
+		size_t size() const
+		{
+			return m_sites.size();
+		}
+
+		double totalWeight() const
+		{
+			return m_totalWeight;
+		}
+
+		//cell for a uniform random number u in [0, 1) (the integer part of u * size picks the column, the fraction picks column or alias)
+		size_t sample(double u) const
+		{
+			double scaled = u * m_sites.size();
+			size_t column = static_cast<size_t>(scaled);
+			if(column >= m_sites.size())
+				column = m_sites.size() - 1;
+			return m_sites[scaled - column < m_probability[column] ? column : m_alias[column]];
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef _CellularAutomataRandom_H_
+#define _CellularAutomataRandom_H_
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace CellularAutomata
+{
+	//cells per random stream of a time step: streams are keyed by (step seed, index / RandomBlockSize), so any partition of the
+	//cells into whole blocks (threads, processes) draws the same numbers for every cell
+	static const size_t RandomBlockSize = 4096;
+
+	//splitmix64 finalizer (decorrelates nearby seeds)
+	inline uint64_t MixSeed(uint64_t x)
+	{
+		x += 0x9E3779B97F4A7C15ULL;
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+		return x ^ (x >> 31);
+	}
+
+	//seed of the independent random stream identified by (seed, a, b), e.g. (run seed, time step, block of cells)
+	inline uint64_t StreamSeed(uint64_t seed, uint64_t a, uint64_t b = 0)
+	{
+		return MixSeed(MixSeed(MixSeed(seed) ^ a) ^ b);
+	}
+
+	//murmur3 32 bit finalizer
+	inline uint32_t Mix32(uint32_t x)
+	{
+		x = (x ^ (x >> 16)) * 0x85EBCA6BU;
+		x = (x ^ (x >> 13)) * 0xC2B2AE35U;
+		return x ^ (x >> 16);
+	}
+
+	//threshold of a probability for 32 bit variates: a variate passes with probability p if it is below the threshold
+	//(nonzero probabilities below 2^-32 round up to the smallest threshold instead of disabling nucleation)
+	inline uint64_t ProbabilityThreshold(double p)
+	{
+		if(p <= 0.0) { return 0; }
+		if(p >= 1.0) { return static_cast<uint64_t>(1) << 32; }
+		uint64_t threshold = static_cast<uint64_t>(p * 4294967296.0);
+		return 0 == threshold ? 1 : threshold;
+	}
+
+	/*
+	 * Counter based stream of uniform 32 bit variates: variate i is a keyed hash of i, so the stream is filled a buffer at
+	 * a time by a loop without dependencies between iterations (which the compiler vectorizes) instead of advancing a
+	 * generator state per draw. A stream is meant to live on the stack of the thread drawing from it (e.g. one per block of
+	 * cells, keyed by StreamSeed).
+	 */
+	class VariateStream
+	{
+	public:
+		static const size_t BufferSize = 256;
+
+		//uniform random number generator interface, so boost distributions can draw from a stream
+		typedef uint32_t result_type;
+		static uint32_t (min)() { return 0; }
+		static uint32_t (max)() { return 0xFFFFFFFFU; }
+
+		explicit VariateStream(uint64_t seed) :
+			m_key0(static_cast<uint32_t>(seed)),
+			m_key1(static_cast<uint32_t>(seed >> 32) | 1U),
+			m_counter(0),
+			m_next(BufferSize)
+		{}
+
+		uint32_t operator()()
+		{
+			if(BufferSize == m_next) { refill(); }
+			return m_buffer[m_next++];
+		}
+
+		//uniform integer in [0, n) (multiply + shift, the bias is below n / 2^32)
+		uint32_t below(uint32_t n)
+		{
+			return static_cast<uint32_t>((static_cast<uint64_t>((*this)()) * n) >> 32);
+		}
+
+		//uniform real in (0, 1)
+		double uniform()
+		{
+			return (static_cast<double>((*this)()) + 0.5) * (1.0 / 4294967296.0);
+		}
+
+		//true with the probability of a ProbabilityThreshold
+		bool passes(uint64_t threshold)
+		{
+			return static_cast<uint64_t>((*this)()) < threshold;
+		}
+
+	private:
+		void refill()
+		{
+			const uint32_t key0 = m_key0;
+			const uint32_t key1 = m_key1;
+			const uint32_t counter = m_counter;
+			for(uint32_t i = 0; i < BufferSize; i++)
+			{ m_buffer[i] = Mix32(Mix32((counter + i) ^ key0) * key1 + key0); }
+			m_counter += BufferSize;
+			m_next = 0;
+		}
+
+		uint32_t m_key0;
+		uint32_t m_key1;
+		uint32_t m_counter;
+		size_t m_next;
+		uint32_t m_buffer[BufferSize];
+	};
+}
+
+#endif
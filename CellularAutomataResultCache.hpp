@@ -0,0 +1,51 @@
+#ifndef _CellularAutomataResultCache_H_
+#define _CellularAutomataResultCache_H_
+
+#include <stdint.h>
+#include <cstring>
+
+#include <QtCore/QString>
+#include <QtCore/QByteArray>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+
+#include "CellularAutomataCheckpoint.hpp"
+
+namespace CellularAutomata
+{
+	//parameters that completely determine the result of a simulation
+	struct ResultCacheKey
+	{
+		uint32_t engineVersion;
+		uint32_t neighborhood;
+		uint64_t dims[3];
+		float resolution[3];
+		float origin[3];
+		float nucleationRate;
+		uint32_t reserved;
+		uint64_t seed;
+	};
+
+	//path of the cached result for a set of parameters (completed simulations are stored as checkpoints of their final state)
+	inline QString ResultCachePath(const QString& directory, const size_t dims[3], const float resolution[3], const float origin[3], float nucleationRate, int neighborhood, uint64_t seed)
+	{
+		ResultCacheKey key;
+		memset(&key, 0, sizeof(key));
+		key.engineVersion = EngineVersion;
+		key.neighborhood = neighborhood;
+		for(size_t i = 0; i < 3; i++)
+		{
+			key.dims[i] = dims[i];
+			key.resolution[i] = resolution[i];
+			key.origin[i] = origin[i];
+		}
+		key.nucleationRate = nucleationRate;
+		key.seed = seed;
+
+		QCryptographicHash hash(QCryptographicHash::Sha1);
+		hash.addData(reinterpret_cast<const char*>(&key), sizeof(key));
+		return QDir(directory).filePath(QString("recrystallization_%1.ckpt").arg(QString::fromLatin1(hash.result().toHex().constData())));
+	}
+}
+
+#endif
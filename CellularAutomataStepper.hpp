@@ -0,0 +1,569 @@
+#ifndef _CellularAutomataStepper_H_
+#define _CellularAutomataStepper_H_
+
+#include <stdint.h>
+#include <algorithm>
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
+#include <QtCore/QElapsedTimer>
+
+#include "CellularAutomataHelpers.hpp"
+#include "CellularAutomataRandom.hpp"
+#include "CellularAutomataDomain.hpp"
+#include "CellularAutomataEngine.hpp"
+#include "CellularAutomataLaneMasks.hpp"
+
+namespace CellularAutomata
+{
+	//per thread copies of T (a single copy in serial builds)
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+	template<typename T>
+	class ThreadLocal : public tbb::enumerable_thread_specific<T> {};
+#else
+	template<typename T>
+	class ThreadLocal
+	{
+	public:
+		typedef T* iterator;
+		T& local() { return m_value; }
+		iterator begin() { return &m_value; }
+		iterator end() { return &m_value + 1; }
+	private:
+		T m_value;
+	};
+#endif
+
+	//row (slot (dy + 1) + 3 * (dz + 1) of the 3 x 3 window of x rows around a row) and column (dx + 1) of each Moore neighbor,
+	//in the order of Lattice::Neighbors
+	static const size_t MooreRowSlots[26] = { 4, 4, 3, 5, 1, 7, 0, 6, 2, 8, 1, 7, 1, 7, 3, 5, 3, 5, 0, 6, 2, 8, 0, 6, 2, 8 };
+	static const size_t MooreColumns[26] = { 0, 2, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 0, 0, 2, 2, 2, 2 };
+
+	//indicies into the Moore neighbor list of the in plane neighbors of a single slice: the 4 edges + 4 corners of a square and
+	//the 6 neighbors of a hexagon on even / odd rows (odd rows are shifted half a cell in +x)
+	static const size_t SquareEightNeighbors[8] = { 0, 1, 2, 3, 14, 15, 16, 17 };
+	static const size_t HexagonalNeighbors[2][6] = { {0, 1, 2, 3, 14, 15}, {0, 1, 2, 3, 16, 17} };
+
+	/*
+	 * Neighborhood policies of a Stepper. A policy picks its neighbors from a cell's Moore list (moore[n] is the index of
+	 * Moore neighbor n, evaluated only for the neighbors it picks): select() writes them to neighbors and returns their number,
+	 * drawing the variant of a randomized neighborhood from the cell's stream first, and skip() makes the same draws for a
+	 * cell that doesn't need its neighbors. reach() gives, for each row slot of the 3 x 3 window, the columns around the
+	 * cell the neighborhood (any variant) can include: 0 none, 1 the cell's own column, 3 the column +- 1. Faces come first
+	 * (2 per axis), single slice neighborhoods only reach the cell's own plane.
+	 */
+	struct VonNeumannNeighborhood
+	{
+		static const size_t MaxNeighbors = 6;
+		static const size_t MooreCount = 6;//Moore neighbors a masked domain's table needs
+		static const bool RowParity = false;//the neighbors depend on the parity of the cell's row
+		static const bool Frontier = true;//only parent cells in reach of a transformed cell get a neighbor list
+		static const size_t* reach() { static const size_t r[9] = {0, 1, 0, 1, 3, 1, 0, 1, 0}; return r; }
+		static void skip(VariateStream&) {}
+
+		template<typename Moore>
+		static size_t select(const Moore& moore, size_t, VariateStream&, size_t* neighbors)
+		{
+			for(size_t n = 0; n < 6; n++)
+				neighbors[n] = moore[n];
+			return 6;
+		}
+	};
+
+	//faces + 2 opposite edges picked at random
+	struct EightCellNeighborhood
+	{
+		static const size_t MaxNeighbors = 8;
+		static const size_t MooreCount = 18;
+		static const bool RowParity = false;
+		static const bool Frontier = true;
+		static const size_t* reach() { static const size_t r[9] = {1, 3, 1, 3, 3, 3, 1, 3, 1}; return r; }
+		static void skip(VariateStream& generator) { generator(); }
+
+		template<typename Moore>
+		static size_t select(const Moore& moore, size_t, VariateStream& generator, size_t* neighbors)
+		{
+			const size_t* edges = EightCellEdges[generator.below(6)];
+			for(size_t n = 0; n < 6; n++)
+				neighbors[n] = moore[n];
+			neighbors[6] = moore[edges[0]];
+			neighbors[7] = moore[edges[1]];
+			return 8;
+		}
+	};
+
+	//faces + 4 edges and 4 corners picked at random
+	struct FourteenCellNeighborhood
+	{
+		static const size_t MaxNeighbors = 14;
+		static const size_t MooreCount = 26;
+		static const bool RowParity = false;
+		static const bool Frontier = true;
+		static const size_t* reach() { static const size_t r[9] = {3, 3, 3, 3, 3, 3, 3, 3, 3}; return r; }
+		static void skip(VariateStream& generator) { generator(); }
+
+		template<typename Moore>
+		static size_t select(const Moore& moore, size_t, VariateStream& generator, size_t* neighbors)
+		{
+			const size_t* corners = FourteenCellCorners[generator.below(4)];
+			for(size_t n = 0; n < 6; n++)
+				neighbors[n] = moore[n];
+			for(size_t n = 0; n < 8; n++)
+				neighbors[6 + n] = moore[corners[n]];
+			return 14;
+		}
+	};
+
+	//faces + edges
+	struct EighteenCellNeighborhood
+	{
+		static const size_t MaxNeighbors = 18;
+		static const size_t MooreCount = 18;
+		static const bool RowParity = false;
+		static const bool Frontier = true;
+		static const size_t* reach() { static const size_t r[9] = {1, 3, 1, 3, 3, 3, 1, 3, 1}; return r; }
+		static void skip(VariateStream&) {}
+
+		template<typename Moore>
+		static size_t select(const Moore& moore, size_t, VariateStream&, size_t* neighbors)
+		{
+			for(size_t n = 0; n < 18; n++)
+				neighbors[n] = moore[n];
+			return 18;
+		}
+	};
+
+	//faces + edges + 2 opposite corners picked at random
+	struct TwentyCellNeighborhood
+	{
+		static const size_t MaxNeighbors = 20;
+		static const size_t MooreCount = 26;
+		static const bool RowParity = false;
+		static const bool Frontier = true;
+		static const size_t* reach() { static const size_t r[9] = {3, 3, 3, 3, 3, 3, 3, 3, 3}; return r; }
+		static void skip(VariateStream& generator) { generator(); }
+
+		template<typename Moore>
+		static size_t select(const Moore& moore, size_t, VariateStream& generator, size_t* neighbors)
+		{
+			const size_t* corners = TwentyCellCorners[generator.below(4)];
+			for(size_t n = 0; n < 18; n++)
+				neighbors[n] = moore[n];
+			neighbors[18] = moore[corners[0]];
+			neighbors[19] = moore[corners[1]];
+			return 20;
+		}
+	};
+
+	struct MooreNeighborhood
+	{
+		static const size_t MaxNeighbors = 26;
+		static const size_t MooreCount = 26;
+		static const bool RowParity = false;
+		static const bool Frontier = true;
+		static const size_t* reach() { static const size_t r[9] = {3, 3, 3, 3, 3, 3, 3, 3, 3}; return r; }
+		static void skip(VariateStream&) {}
+
+		template<typename Moore>
+		static size_t select(const Moore& moore, size_t, VariateStream&, size_t* neighbors)
+		{
+			for(size_t n = 0; n < 26; n++)
+				neighbors[n] = moore[n];
+			return 26;
+		}
+	};
+
+	//edges of a square (single slices)
+	struct SquareFourNeighborhood
+	{
+		static const size_t MaxNeighbors = 4;
+		static const size_t MooreCount = 6;
+		static const bool RowParity = false;
+		static const bool Frontier = false;//listing the 4 - 8 in plane neighbors is cheaper than the check
+		static const size_t* reach() { static const size_t r[9] = {0, 0, 0, 1, 3, 1, 0, 0, 0}; return r; }
+		static void skip(VariateStream&) {}
+
+		template<typename Moore>
+		static size_t select(const Moore& moore, size_t, VariateStream&, size_t* neighbors)
+		{
+			for(size_t n = 0; n < 4; n++)
+				neighbors[n] = moore[n];
+			return 4;
+		}
+	};
+
+	//edges + corners of a square (single slices)
+	struct SquareEightNeighborhood
+	{
+		static const size_t MaxNeighbors = 8;
+		static const size_t MooreCount = 18;
+		static const bool RowParity = false;
+		static const bool Frontier = false;
+		static const size_t* reach() { static const size_t r[9] = {0, 0, 0, 3, 3, 3, 0, 0, 0}; return r; }
+		static void skip(VariateStream&) {}
+
+		template<typename Moore>
+		static size_t select(const Moore& moore, size_t, VariateStream&, size_t* neighbors)
+		{
+			for(size_t n = 0; n < 8; n++)
+				neighbors[n] = moore[SquareEightNeighbors[n]];
+			return 8;
+		}
+	};
+
+	//hexagon of a slice whose odd rows are shifted half a cell in +x
+	struct HexagonalNeighborhood
+	{
+		static const size_t MaxNeighbors = 6;
+		static const size_t MooreCount = 18;
+		static const bool RowParity = true;
+		static const bool Frontier = false;
+		static const size_t* reach() { static const size_t r[9] = {0, 0, 0, 3, 3, 3, 0, 0, 0}; return r; }
+		static void skip(VariateStream&) {}
+
+		template<typename Moore>
+		static size_t select(const Moore& moore, size_t rowParity, VariateStream&, size_t* neighbors)
+		{
+			for(size_t n = 0; n < 6; n++)
+				neighbors[n] = moore[HexagonalNeighbors[rowParity][n]];
+			return 6;
+		}
+	};
+
+	//Moore list of a lattice cell located in the window of rows around its row
+	struct WindowMoore
+	{
+		const int32_t* const* window;
+		const int32_t* states;
+		const size_t* columns;
+
+		size_t operator[](size_t n) const
+		{
+			return (window[MooreRowSlots[n]] - states) + columns[MooreColumns[n]];
+		}
+	};
+
+	//Moore list of a masked domain cell (a row of the domain's neighbor table)
+	template<typename IndexType>
+	struct TableMoore
+	{
+		const IndexType* row;
+
+		size_t operator[](size_t n) const
+		{
+			return row[n];
+		}
+	};
+
+	//cells a step visited by how they were handled, and the time it took
+	struct StepCounters
+	{
+		StepCounters() : transformed(0), isolated(0), frontier(0), nanoseconds(0) {}
+
+		void merge(const StepCounters& other)
+		{
+			transformed += other.transformed;
+			isolated += other.isolated;
+			frontier += other.frontier;
+			nanoseconds += other.nanoseconds;
+		}
+
+		uint64_t cells() const
+		{
+			return transformed + isolated + frontier;
+		}
+
+		uint64_t transformed;//cells in a transformed state
+		uint64_t isolated;//parent cells no transformed cell could reach
+		uint64_t frontier;//parent cells whose neighbors were listed
+		int64_t nanoseconds;
+	};
+
+	/*
+	 * Steps of a cellular automaton whose cells hold int32_t states, 0 being the parent state that transformed states (grains
+	 * of a recrystallization, solid, a product phase) grow into. The Stepper owns the traversal: cells are processed in fixed
+	 * blocks of RandomBlockSize cells with one random stream each (keyed by the step seed and the block, so the result
+	 * doesn't depend on the threads or the grain size), blocks run in parallel as the engine plan says, and the rows of an
+	 * unmasked lattice are checked RowLanes cells at a time so only parent cells that a transformed cell could reach get a
+	 * neighbor list (the frontier, for neighborhoods whose Frontier is set). Masked domains list the neighbors of every parent
+	 * cell from the domain's table.
+	 *
+	 * A Rule decides the next state of each cell (and writes it, the Stepper doesn't keep buffers):
+	 *   typedef ... Reduction;//per step results, default constructed empty and combined with void merge(const Reduction&)
+	 *   const int32_t* states() const;//current states (indexed by lattice or domain cell)
+	 *   void transformed(size_t index, VariateStream& generator, Reduction& reduction) const;//state != 0
+	 *   void isolated(size_t index, VariateStream& generator, Reduction& reduction) const;//parent out of the neighborhood's reach
+	 *   void update(size_t index, const size_t* neighbors, size_t count, VariateStream& generator, Reduction& reduction) const;
+	 * Cells are visited in index order within a block, each drawing from the block's stream, so a rule's draws are the
+	 * same however the blocks are scheduled. StepperBase is the interface of a Stepper whose neighborhood is picked at run time.
+	 */
+	template<typename Rule>
+	class StepperBase
+	{
+	public:
+		typedef typename Rule::Reduction Reduction;
+
+		virtual ~StepperBase() {}
+
+		//advances cells [start, end) (start a multiple of RandomBlockSize) with the random streams of stepSeed
+		virtual Reduction run(const Rule& rule, uint64_t stepSeed, size_t start, size_t end) = 0;
+
+		//counters of the last run and of every run so far
+		const StepCounters& last() const
+		{
+			return m_last;
+		}
+
+		const StepCounters& total() const
+		{
+			return m_total;
+		}
+
+	protected:
+		StepCounters m_last;
+		StepCounters m_total;
+	};
+
+	template<typename Rule, typename Neighborhood>
+	class Stepper : public StepperBase<Rule>
+	{
+	public:
+		typedef typename Rule::Reduction Reduction;
+
+	private:
+		//results of a task (or of a thread's tasks)
+		struct Partial
+		{
+			Reduction reduction;
+			StepCounters counters;
+
+			void merge(const Partial& other)
+			{
+				reduction.merge(other.reduction);
+				counters.merge(other.counters);
+			}
+		};
+
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+		//a range of blocks run by a task, collected into the thread's partial results
+		class Task
+		{
+			const Stepper* m_stepper;
+			const Rule* m_rule;
+			uint64_t m_seed;
+			size_t m_end;
+			ThreadLocal<Partial>* m_partials;
+
+		public:
+			Task(const Stepper* stepper, const Rule* rule, uint64_t seed, size_t end, ThreadLocal<Partial>* partials) :
+				m_stepper(stepper),
+				m_rule(rule),
+				m_seed(seed),
+				m_end(end),
+				m_partials(partials)
+			{
+			}
+
+			void operator()(const tbb::blocked_range<size_t>& r) const
+			{
+				Partial partial;
+				m_stepper->compute(*m_rule, m_seed, r.begin() * RandomBlockSize, std::min(r.end() * RandomBlockSize, m_end), partial);
+				m_partials->local().merge(partial);
+			}
+		};
+#endif
+
+		const Lattice& m_lattice;
+		const Domain* m_domain;
+		const EnginePlan& m_plan;
+		bool m_avx2;
+		ThreadLocal<Partial> m_partials;
+
+		//LaneMasks of a neighborhood without the frontier check (every parent cell is reachable)
+		static inline void parentMasks(const int32_t* const* window, size_t x, size_t lanes, uint32_t& own, uint32_t& reachable)
+		{
+			own = 0;
+			for(size_t lane = 0; lane < lanes; lane++)
+			{
+				if(0 != window[4][x + lane])
+					own |= 1u << lane;
+			}
+			reachable = ~own;
+		}
+
+		//unmasked lattice: walks the x rows of [start, end) with the 3 x 3 window of rows around each row located once per row
+		//(on a single slice all 3 planes are the slice) and only lists the neighbors of frontier cells
+		void walkRows(const Rule& rule, size_t start, size_t end, VariateStream& generator, Partial& partial) const
+		{
+			const size_t dimX = m_lattice.dimension(0);
+			const size_t dimY = m_lattice.dimension(1);
+			const size_t dimZ = m_lattice.dimension(2);
+			const int32_t* states = rule.states();
+
+			const int32_t* window[9];
+			size_t neighbors[Neighborhood::MaxNeighbors];
+			for(size_t rowStart = start; rowStart < end;)
+			{
+				//locate the window once per row
+				size_t row = rowStart / dimX;
+				size_t y = row % dimY;
+				size_t z = row / dimY;
+				size_t rows[3] = { 0 == y ? dimY - 1 : y - 1, y, dimY - 1 == y ? 0 : y + 1 };
+				size_t planes[3] = { 0 == z ? dimZ - 1 : z - 1, z, dimZ - 1 == z ? 0 : z + 1 };
+				for(size_t slot = 0; slot < 9; slot++)
+					window[slot] = states + (planes[slot / 3] * dimY + rows[slot % 3]) * dimX;
+				size_t rowBase = row * dimX;
+				size_t rowEnd = std::min(end, rowBase + dimX);
+
+				for(size_t x = rowStart - rowBase; x < rowEnd - rowBase; x += RowLanes)
+				{
+					size_t lanes = std::min(RowLanes, rowEnd - rowBase - x);
+					uint32_t own, reachable;
+					if(!Neighborhood::Frontier)
+						parentMasks(window, x, lanes, own, reachable);
+#ifdef CELLULAR_AUTOMATA_AVX2
+					else if(m_avx2 && RowLanes == lanes && x >= 1 && x + RowLanes + 1 <= dimX)
+						LaneMasksAVX2(window, Neighborhood::reach(), x, own, reachable);
+#endif
+					else
+						LaneMasks(window, Neighborhood::reach(), x, lanes, dimX, own, reachable);
+
+					for(size_t lane = 0; lane < lanes; lane++)
+					{
+						size_t i = rowBase + x + lane;
+						if(0 != (own & (1u << lane)))
+						{
+							partial.counters.transformed++;
+							rule.transformed(i, generator, partial.reduction);
+							continue;
+						}
+
+						//cells out of reach of every transformed cell get no neighbor list (variants are drawn either way)
+						if(0 == (reachable & (1u << lane)))
+						{
+							partial.counters.isolated++;
+							Neighborhood::skip(generator);
+							rule.isolated(i, generator, partial.reduction);
+							continue;
+						}
+
+						size_t column = x + lane;
+						size_t columns[3] = { 0 == column ? dimX - 1 : column - 1, column, dimX - 1 == column ? 0 : column + 1 };
+						WindowMoore moore = { window, states, columns };
+						size_t count = Neighborhood::select(moore, y % 2, generator, neighbors);
+						partial.counters.frontier++;
+						rule.update(i, neighbors, count, generator, partial.reduction);
+					}
+				}
+				rowStart = rowEnd;
+			}
+		}
+
+		//masked domain: cells are compact indices and neighbors come from the domain's table
+		template<typename IndexType>
+		void walkTable(const Rule& rule, size_t start, size_t end, VariateStream& generator, const IndexType* table, Partial& partial) const
+		{
+			const int32_t* states = rule.states();
+			const size_t width = m_domain->width();
+			size_t neighbors[Neighborhood::MaxNeighbors];
+			for(size_t i = start; i < end; i++)
+			{
+				if(0 != states[i])
+				{
+					partial.counters.transformed++;
+					rule.transformed(i, generator, partial.reduction);
+					continue;
+				}
+
+				size_t rowParity = 0;
+				if(Neighborhood::RowParity)
+				{
+					size_t x, y, z;
+					m_domain->ToTuple(i, x, y, z);
+					rowParity = y % 2;
+				}
+				TableMoore<IndexType> moore = { table + i * width };
+				size_t count = Neighborhood::select(moore, rowParity, generator, neighbors);
+				partial.counters.frontier++;
+				rule.update(i, neighbors, count, generator, partial.reduction);
+			}
+		}
+
+	public:
+		Stepper(const Lattice& lattice, const Domain* domain, const EnginePlan& plan) :
+			m_lattice(lattice),
+			m_domain(domain),
+			m_plan(plan),
+			m_avx2(HasAVX2())
+		{
+		}
+
+		//cells [start, end) block by block with the block's random stream (start must be a multiple of RandomBlockSize)
+		void compute(const Rule& rule, uint64_t stepSeed, size_t start, size_t end, Partial& partial) const
+		{
+			for(size_t blockStart = start; blockStart < end; blockStart += RandomBlockSize)
+			{
+				size_t blockEnd = std::min(blockStart + RandomBlockSize, end);
+				VariateStream generator(StreamSeed(stepSeed, blockStart / RandomBlockSize));
+				if(NULL == m_domain)
+					walkRows(rule, blockStart, blockEnd, generator, partial);
+				else if(m_domain->wide())
+					walkTable(rule, blockStart, blockEnd, generator, m_domain->wideNeighbors(0), partial);
+				else
+					walkTable(rule, blockStart, blockEnd, generator, m_domain->neighbors(0), partial);
+			}
+		}
+
+		//runs the blocks of [start, end) serially or in parallel (tasks of the plan's grain size) and reduces their results
+		Reduction run(const Rule& rule, uint64_t stepSeed, size_t start, size_t end)
+		{
+			QElapsedTimer timer;
+			timer.start();
+			Partial result;
+#ifdef DREAM3D_USE_PARALLEL_ALGORITHMS
+			if(m_plan.parallel)
+			{
+				size_t blockEnd = (end + RandomBlockSize - 1) / RandomBlockSize;
+				tbb::parallel_for(tbb::blocked_range<size_t>(start / RandomBlockSize, blockEnd, m_plan.grainSize), Task(this, &rule, stepSeed, end, &m_partials), tbb::auto_partitioner());
+				for(typename ThreadLocal<Partial>::iterator iter = m_partials.begin(); iter != m_partials.end(); ++iter)
+				{
+					result.merge(*iter);
+					*iter = Partial();
+				}
+			}
+			else
+#endif
+				compute(rule, stepSeed, start, end, result);
+			result.counters.nanoseconds = timer.nsecsElapsed();
+			this->m_last = result.counters;
+			this->m_total.merge(result.counters);
+			return result.reduction;
+		}
+	};
+
+	//a Stepper for a neighborhood type as numbered by RecrystalizeVolume (0 - 8)
+	template<typename Rule>
+	StepperBase<Rule>* NewStepper(int neighborhood, const Lattice& lattice, const Domain* domain, const EnginePlan& plan)
+	{
+		switch(neighborhood)
+		{
+			case 0: return new Stepper<Rule, VonNeumannNeighborhood>(lattice, domain, plan);
+			case 1: return new Stepper<Rule, EightCellNeighborhood>(lattice, domain, plan);
+			case 2: return new Stepper<Rule, FourteenCellNeighborhood>(lattice, domain, plan);
+			case 3: return new Stepper<Rule, EighteenCellNeighborhood>(lattice, domain, plan);
+			case 4: return new Stepper<Rule, TwentyCellNeighborhood>(lattice, domain, plan);
+			case 5: return new Stepper<Rule, MooreNeighborhood>(lattice, domain, plan);
+			case 6: return new Stepper<Rule, SquareFourNeighborhood>(lattice, domain, plan);
+			case 7: return new Stepper<Rule, SquareEightNeighborhood>(lattice, domain, plan);
+			case 8: return new Stepper<Rule, HexagonalNeighborhood>(lattice, domain, plan);
+		}
+		return NULL;
+	}
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "UnitTestSupport.hpp"
+
+#include "CellularAutomataCompressedVolume.hpp"
+
+#include "CelluarAutomataTestFileLocations.h"
+
+// -----------------------------------------------------------------------------
+// Compressed volumes read back exactly, as a whole or one slab at a time
+// -----------------------------------------------------------------------------
+void TestCompressedVolume()
+{
+  //grains of 8 x 8 x 8 cells (some unrecrystallized) with times growing away from a corner of each
+  const size_t dims[3] = { 37, 23, 11 };
+  size_t numCells = dims[0] * dims[1] * dims[2];
+  std::vector<int32_t> ids(numCells);
+  std::vector<uint32_t> times(numCells);
+  for(size_t z = 0; z < dims[2]; z++)
+  {
+    for(size_t y = 0; y < dims[1]; y++)
+    {
+      for(size_t x = 0; x < dims[0]; x++)
+      {
+        size_t i = (z * dims[1] + y) * dims[0] + x;
+        ids[i] = static_cast<int32_t>(1 + x / 8 + 5 * (y / 8) + 15 * (z / 8));
+        times[i] = static_cast<uint32_t>(1 + x % 8 + y % 8 + z % 8);
+        if(0 == ids[i] % 4) { ids[i] = times[i] = 0; }
+      }
+    }
+  }
+
+  QString path = UnitTest::TestTempDir + "/CellularAutomataVolume.cavol";
+  const size_t slabRows[] = { 0, 1, 7 };
+  const size_t slabs[] = { 1, 253, 37 };
+  for(size_t r = 0; r < 3; r++)
+  {
+    uint64_t bytes = 0;
+    DREAM3D_REQUIRE(CellularAutomata::WriteCompressedVolume(path, dims, &ids[0], &times[0], slabRows[r], 0 != r % 2, bytes).isEmpty())
+    DREAM3D_REQUIRE(bytes < 8 * numCells)
+
+    CellularAutomata::CompressedVolumeReader reader(path);
+    DREAM3D_REQUIRE(reader.open().isEmpty())
+    DREAM3D_REQUIRE_EQUAL(reader.slabs(), slabs[r])
+    DREAM3D_REQUIRE_EQUAL(reader.dims()[2], dims[2])
+
+    size_t s = reader.slabs() / 2;
+    std::vector<int32_t> slabIds(reader.slabCells(s), -1);
+    std::vector<uint32_t> slabTimes(reader.slabCells(s), 0);
+    DREAM3D_REQUIRE(reader.readSlab(s, &slabIds[0], &slabTimes[0]))
+    DREAM3D_REQUIRE(std::equal(slabIds.begin(), slabIds.end(), ids.begin() + reader.firstCell(s)))
+    DREAM3D_REQUIRE(std::equal(slabTimes.begin(), slabTimes.end(), times.begin() + reader.firstCell(s)))
+
+    std::vector<int32_t> readIds(numCells, -1);
+    std::vector<uint32_t> readTimes(numCells, 0);
+    DREAM3D_REQUIRE(reader.read(&readIds[0], &readTimes[0]))
+    DREAM3D_REQUIRE(readIds == ids)
+    DREAM3D_REQUIRE(readTimes == times)
+  }
+
+  CellularAutomata::CompressedVolumeReader missing(path + ".missing");
+  DREAM3D_REQUIRE(!missing.open().isEmpty())
+#if REMOVE_TEST_FILES
+  QFile::remove(path);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("CompressedVolumeTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( TestCompressedVolume() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
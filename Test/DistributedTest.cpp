@@ -0,0 +1,105 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+
+#include "UnitTestSupport.hpp"
+
+#include "CellularAutomataHelpers.hpp"
+#include "CellularAutomataDistributed.hpp"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestSlabPartition()
+{
+  const size_t lattices[][3] = { {64, 64, 64}, {37, 29, 23}, {200, 150, 3}, {5, 7, 300} };
+  const size_t processes[] = { 1, 2, 3, 5, 8 };
+  for(size_t l = 0; l < sizeof(lattices) / sizeof(lattices[0]); l++)
+  {
+    CellularAutomata::Lattice lattice(lattices[l][0], lattices[l][1], lattices[l][2]);
+    size_t planeSize = lattice.dimension(0) * lattice.dimension(1);
+    size_t dimZ = lattice.dimension(2);
+    for(size_t p = 0; p < sizeof(processes) / sizeof(processes[0]); p++)
+    {
+      //contiguous ranges of whole random number blocks covering the lattice
+      CellularAutomata::SlabPartition partition(lattice, processes[p]);
+      DREAM3D_REQUIRE_EQUAL(partition.begin(0), 0)
+      DREAM3D_REQUIRE_EQUAL(partition.end(processes[p] - 1), lattice.size())
+      std::vector<size_t> kept(processes[p] * lattice.size(), 0);
+      for(size_t r = 0; r < processes[p]; r++)
+      {
+        DREAM3D_REQUIRE(partition.begin(r) <= partition.end(r))
+        DREAM3D_REQUIRE_EQUAL(partition.begin(r) % CellularAutomata::RandomBlockSize, 0)
+        if(r + 1 < processes[p]) { DREAM3D_REQUIRE_EQUAL(partition.end(r), partition.begin(r + 1)) }
+        for(size_t i = partition.begin(r); i < partition.end(r); i += 97) { DREAM3D_REQUIRE_EQUAL(partition.owner(i), r) }
+
+        //windows hold the own planes and 2 halo planes on each side (or the whole lattice)
+        size_t firstPlane, planeCount;
+        partition.window(r, firstPlane, planeCount);
+        if(partition.begin(r) == partition.end(r))
+        {
+          DREAM3D_REQUIRE_EQUAL(planeCount, 0)
+          continue;
+        }
+        DREAM3D_REQUIRE(planeCount <= dimZ)
+        for(size_t k = 0; k < planeCount; k++)
+        {
+          size_t plane = (firstPlane + k) % dimZ;
+          std::fill(kept.begin() + r * lattice.size() + plane * planeSize, kept.begin() + r * lattice.size() + (plane + 1) * planeSize, 1);
+        }
+        size_t first = partition.begin(r) / planeSize;
+        size_t last = (partition.end(r) - 1) / planeSize;
+        for(size_t z = first + dimZ - CellularAutomata::HaloPlanes; z <= last + dimZ + CellularAutomata::HaloPlanes; z++)
+        {
+          DREAM3D_REQUIRE_EQUAL(kept[r * lattice.size() + (z % dimZ) * planeSize], 1)
+        }
+      }
+
+      //the transfers deliver every kept cell owned by another process exactly once
+      std::vector<CellularAutomata::HaloTransfer> transfers = partition.transfers();
+      for(size_t t = 0; t < transfers.size(); t++)
+      {
+        DREAM3D_REQUIRE(transfers[t].from != transfers[t].to)
+        for(size_t i = transfers[t].begin; i < transfers[t].end; i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(partition.owner(i), transfers[t].from)
+          DREAM3D_REQUIRE_EQUAL(kept[transfers[t].to * lattice.size() + i], 1)
+          kept[transfers[t].to * lattice.size() + i] = 2;
+        }
+      }
+      for(size_t r = 0; r < processes[p]; r++)
+      {
+        for(size_t i = 0; i < lattice.size(); i++)
+        {
+          size_t expected = 0 == kept[r * lattice.size() + i] ? 0 : (partition.owner(i) == r ? 1 : 2);
+          DREAM3D_REQUIRE_EQUAL(kept[r * lattice.size() + i], expected)
+        }
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("DistributedTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( TestSlabPartition() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,121 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <utility>
+
+#include <QtCore/QCoreApplication>
+
+#include "UnitTestSupport.hpp"
+
+#include "CellularAutomataEstimate.hpp"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestEstimate()
+{
+  //a large lattice with checkpoints: working array + snapshots, then a working window, then also foreground checkpoints
+  CellularAutomata::SimulationRequest request;
+  request.dims[0] = 1500;
+  request.dims[1] = 1500;
+  request.dims[2] = 1500;
+  request.activeCells = request.cells();
+  request.nucleationProbability = 1.0e-6f;
+  request.checkpoints = true;
+  request.threads = 8;
+  request.parallel = true;
+  uint64_t numCells = request.cells();
+
+  CellularAutomata::ResourceEstimate full = CellularAutomata::EstimateResources(request, 0, true, 0);
+  DREAM3D_REQUIRE(full.outputBytes >= 8 * numCells)
+  DREAM3D_REQUIRE_EQUAL(full.workingBytes, 4 * numCells)
+  DREAM3D_REQUIRE_EQUAL(full.snapshotBytes, 8 * numCells)
+  DREAM3D_REQUIRE_EQUAL(full.peakBytes(), full.outputBytes + full.workingBytes + full.snapshotBytes + full.auxiliaryBytes)
+  DREAM3D_REQUIRE(full.grains >= 1 && full.grains <= numCells)
+  DREAM3D_REQUIRE(full.steps > 0 && full.seconds > 0)
+
+  CellularAutomata::EnginePlan plan;
+  plan.parallel = true;
+  plan.threads = 8;
+  CellularAutomata::ResourceEstimate estimate;
+  DREAM3D_REQUIRE(CellularAutomata::FitMemory(request, full.peakBytes(), plan, estimate))
+  DREAM3D_REQUIRE_EQUAL(plan.windowBlocks, 0)
+  DREAM3D_REQUIRE(plan.checkpointSnapshots)
+
+  DREAM3D_REQUIRE(CellularAutomata::FitMemory(request, full.peakBytes() - 1, plan, estimate))
+  DREAM3D_REQUIRE(plan.windowBlocks >= CellularAutomata::WorkingWindowBlocks(request.dims, 8))
+  DREAM3D_REQUIRE(plan.checkpointSnapshots)
+  DREAM3D_REQUIRE(estimate.workingBytes < full.workingBytes / 100)
+  CellularAutomata::ResourceEstimate windowed = estimate;
+
+  DREAM3D_REQUIRE(CellularAutomata::FitMemory(request, windowed.peakBytes() - 1, plan, estimate))
+  DREAM3D_REQUIRE(0 != plan.windowBlocks)
+  DREAM3D_REQUIRE(!plan.checkpointSnapshots)
+  DREAM3D_REQUIRE_EQUAL(estimate.snapshotBytes, 0)
+  DREAM3D_REQUIRE(!CellularAutomata::FitMemory(request, estimate.peakBytes() - 1, plan, estimate))
+
+  //the window holds a chunk, the 3 planes before it and the 2 first planes
+  size_t planeSize = request.dims[0] * request.dims[1];
+  size_t blocks = CellularAutomata::WorkingWindowBlocks(request.dims, 8);
+  DREAM3D_REQUIRE(blocks * CellularAutomata::RandomBlockSize >= CellularAutomata::WindowPlanes * planeSize)
+  DREAM3D_REQUIRE_EQUAL(CellularAutomata::WorkingWindowCells(request.dims, blocks), blocks * CellularAutomata::RandomBlockSize + 5 * planeSize)
+
+  //masked domains, weighted sites and thin lattices have no window, so the fallback fails
+  CellularAutomata::SimulationRequest masked = request;
+  masked.masked = true;
+  masked.activeCells = numCells / 2;
+  DREAM3D_REQUIRE(!CellularAutomata::FitMemory(masked, full.peakBytes() - 1, plan, estimate))
+  DREAM3D_REQUIRE_EQUAL(plan.windowBlocks, 0)
+  CellularAutomata::SimulationRequest thin = request;
+  thin.dims[2] = 3;
+  CellularAutomata::ResourceEstimate thinFull = CellularAutomata::EstimateResources(thin, 0, false, 0);
+  DREAM3D_REQUIRE(!CellularAutomata::FitMemory(thin, thinFull.peakBytes() - 1, plan, estimate))
+  DREAM3D_REQUIRE_EQUAL(plan.windowBlocks, 0)
+
+  //slower nucleation takes longer and gives fewer grains, a step limit caps the steps
+  CellularAutomata::SimulationRequest slower = request;
+  slower.nucleationProbability = 1.0e-7f;
+  CellularAutomata::ResourceEstimate slow = CellularAutomata::EstimateResources(slower, 0, true, 0);
+  DREAM3D_REQUIRE(slow.steps > full.steps)
+  DREAM3D_REQUIRE(slow.grains < full.grains)
+  slower.stop.maxTimeStep = 10;
+  DREAM3D_REQUIRE(CellularAutomata::EstimateResources(slower, 0, true, 0).steps <= 1.0 / (1.0e-7 * numCells) + 10.0)
+
+  //a parameter sweep runs as many lattices at once as fit
+  CellularAutomata::SimulationRequest sweep = request;
+  sweep.dims[2] = 100;
+  for(int n = 0; n < 6; n++) { sweep.sweep.push_back(std::make_pair(1.0e-5f, n)); }
+  uint64_t latticeBytes = sweep.cells() * 12;
+  DREAM3D_REQUIRE(CellularAutomata::FitMemory(sweep, 3 * latticeBytes, plan, estimate))
+  DREAM3D_REQUIRE_EQUAL(estimate.concurrentRuns, 3)
+  DREAM3D_REQUIRE(!CellularAutomata::FitMemory(sweep, latticeBytes - 1, plan, estimate))
+
+  //grain growth takes time per boundary cell, its list replaces the released working array
+  CellularAutomata::SimulationRequest growth = request;
+  growth.growthSteps = 100;
+  CellularAutomata::ResourceEstimate grown = CellularAutomata::EstimateResources(growth, 0, true, 0);
+  DREAM3D_REQUIRE(grown.seconds > full.seconds)
+  DREAM3D_REQUIRE(grown.peakBytes() >= full.peakBytes())
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("EstimateTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( TestEstimate() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
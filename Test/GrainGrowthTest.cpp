@@ -0,0 +1,97 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+
+#include "UnitTestSupport.hpp"
+
+#include "CellularAutomataHelpers.hpp"
+#include "CellularAutomataRandom.hpp"
+#include "CellularAutomataGrainGrowth.hpp"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestGrainGrowth()
+{
+  const size_t lattices[][3] = { {24, 20, 16}, {40, 30, 1}, {9, 4, 6}, {3, 11, 2} };
+  for(size_t l = 0; l < sizeof(lattices) / sizeof(lattices[0]); l++)
+  {
+    //grains of 2 x 2 x 2 cells with random ids from a few grains and some unrecrystallized cells
+    CellularAutomata::Lattice lattice(lattices[l][0], lattices[l][1], lattices[l][2]);
+    std::vector<int32_t> ids(lattice.size());
+    CellularAutomata::VariateStream generator(l);
+    std::vector<int32_t> blocks(lattice.size());
+    for(size_t i = 0; i < blocks.size(); i++) { blocks[i] = static_cast<int32_t>(generator.below(12)); }
+    for(size_t i = 0; i < lattice.size(); i++)
+    {
+      size_t x, y, z;
+      lattice.ToTuple(i, x, y, z);
+      ids[i] = blocks[lattice.ToIndex(x / 2, y / 2, z / 2)];
+    }
+    std::vector<int32_t> initial = ids;
+
+    CellularAutomata::GrainGrowth growth(lattice, &ids[0]);
+    uint64_t energy = CellularAutomata::BoundaryEnergy(lattice, &ids[0]);
+    size_t flips = 0;
+    for(size_t step = 0; step < 20; step++)
+    {
+      flips += growth.step(CellularAutomata::StreamSeed(l, step));
+
+      //the energy never rises
+      uint64_t grown = CellularAutomata::BoundaryEnergy(lattice, &ids[0]);
+      DREAM3D_REQUIRE(grown <= energy)
+      energy = grown;
+
+      //the active list holds exactly the recrystallized cells with an unlike neighbor
+      std::vector<size_t> boundary;
+      size_t neighbors[26];
+      for(size_t i = 0; i < lattice.size(); i++)
+      {
+        if(ids[i] <= 0) { continue; }
+        size_t count = CellularAutomata::MooreNeighbors(lattice, i, neighbors);
+        for(size_t n = 0; n < count; n++)
+        {
+          if(ids[neighbors[n]] != ids[i])
+          {
+            boundary.push_back(i);
+            break;
+          }
+        }
+      }
+      DREAM3D_REQUIRE(boundary == growth.active())
+    }
+    DREAM3D_REQUIRE(flips > 0)
+
+    //unrecrystallized cells stay, no new grains appear
+    for(size_t i = 0; i < lattice.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(0 == ids[i], 0 == initial[i])
+      DREAM3D_REQUIRE(std::find(initial.begin(), initial.end(), ids[i]) != initial.end())
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("GrainGrowthTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( TestGrainGrowth() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,125 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+
+#include "UnitTestSupport.hpp"
+
+#include "CellularAutomataLaneMasks.hpp"
+
+namespace
+{
+  //columns each row slot of the 3 x 3 window can reach for the 6 face neighbors, the 18 face + edge neighbors (and the
+  //8 / 20 cell variants drawn from them) and all 26 Moore neighbors (and the 14 cell variants)
+  const size_t TestReach[3][9] = {
+    {0, 1, 0, 1, 3, 1, 0, 1, 0},
+    {1, 3, 1, 3, 3, 3, 1, 3, 1},
+    {3, 3, 3, 3, 3, 3, 3, 3, 3}
+  };
+
+  //fixed sequence of pseudo random numbers (the same on every platform)
+  class TestSequence
+  {
+    public:
+      TestSequence(uint64_t seed) : m_state(seed) {}
+      uint32_t below(uint32_t range)
+      {
+        m_state = m_state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<uint32_t>(m_state >> 33) % range;
+      }
+
+    private:
+      uint64_t m_state;
+  };
+}
+
+// -----------------------------------------------------------------------------
+// Lane masks of a reach pattern at x (lanes cells), checked against the window cell by cell
+// -----------------------------------------------------------------------------
+void RequireLaneMasks(const int32_t* const* window, const size_t* reach, size_t x, size_t lanes, size_t dimX, uint32_t own, uint32_t reachable)
+{
+  for(size_t lane = 0; lane < lanes; lane++)
+  {
+    size_t column = x + lane;
+    bool any = false;
+    for(size_t slot = 0; slot < 9; slot++)
+    {
+      for(size_t dx = 0; dx < 3; dx++)
+      {
+        if(3 == reach[slot] || (1 == reach[slot] && 1 == dx))
+        { any = any || 0 != window[slot][(column + dimX + dx - 1) % dimX]; }
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(0 != (own & (1u << lane)), 0 != window[4][column])
+    DREAM3D_REQUIRE_EQUAL(0 != (reachable & (1u << lane)), any)
+  }
+  DREAM3D_REQUIRE_EQUAL(own >> lanes, 0u)
+  DREAM3D_REQUIRE_EQUAL(reachable >> lanes, 0u)
+}
+
+// -----------------------------------------------------------------------------
+// The portable lane masks hold the state of each cell at every position of a row (including the wrapped row ends and
+// partial groups at the end), the AVX2 masks (compiled for AVX2 or picked at run time) equal them at every position they
+// can run at
+// -----------------------------------------------------------------------------
+void TestLaneMasks()
+{
+  const size_t dimX = 40;
+  TestSequence sequence(11);
+  for(uint32_t density = 2; density <= 128; density *= 4)
+  {
+    std::vector<int32_t> rows(9 * dimX, 0);
+    for(size_t i = 0; i < rows.size(); i++)
+    {
+      if(0 == sequence.below(density)) { rows[i] = static_cast<int32_t>(1 + sequence.below(1000)); }
+    }
+    const int32_t* window[9];
+    for(size_t slot = 0; slot < 9; slot++) { window[slot] = &rows[slot * dimX]; }
+
+    for(size_t r = 0; r < 3; r++)
+    {
+      const size_t* reach = TestReach[r];
+      for(size_t x = 0; x < dimX; x++)
+      {
+        size_t lanes = std::min(CellularAutomata::RowLanes, dimX - x);
+        uint32_t own, reachable;
+        CellularAutomata::LaneMasks(window, reach, x, lanes, dimX, own, reachable);
+        RequireLaneMasks(window, reach, x, lanes, dimX, own, reachable);
+
+#ifdef CELLULAR_AUTOMATA_AVX2
+        if(CellularAutomata::HasAVX2() && x >= 1 && x + CellularAutomata::RowLanes + 1 <= dimX)
+        {
+          uint32_t ownAVX2, reachableAVX2;
+          CellularAutomata::LaneMasksAVX2(window, reach, x, ownAVX2, reachableAVX2);
+          DREAM3D_REQUIRE_EQUAL(ownAVX2, own)
+          DREAM3D_REQUIRE_EQUAL(reachableAVX2, reachable)
+        }
+#endif
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("LaneMasksTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( TestLaneMasks() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,284 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+
+#include "UnitTestSupport.hpp"
+
+#include "CellularAutomataHelpers.hpp"
+#include "CellularAutomataDomain.hpp"
+
+#include "CelluarAutomataTestFileLocations.h"
+
+namespace
+{
+  //lattices with every pair of dimensions different, thin axes (where the 2 shell neighborhood wraps onto itself) and a single slice
+  const size_t TestDimensions[][3] = { {5, 7, 9}, {9, 4, 6}, {3, 11, 2}, {8, 6, 1}, {1, 5, 4}, {13, 2, 3} };
+  const size_t NumTestDimensions = sizeof(TestDimensions) / sizeof(TestDimensions[0]);
+
+  //Moore neighbor offsets in the order of Lattice::Moore (faces, edges, corners)
+  const int64_t MooreOffsets[26][3] = {
+    {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1},
+    {0, -1, -1}, {0, -1, 1}, {0, 1, -1}, {0, 1, 1},
+    {-1, 0, -1}, {-1, 0, 1}, {1, 0, -1}, {1, 0, 1},
+    {-1, -1, 0}, {-1, 1, 0}, {1, -1, 0}, {1, 1, 0},
+    {-1, -1, -1}, {-1, -1, 1}, {-1, 1, -1}, {-1, 1, 1},
+    {1, -1, -1}, {1, -1, 1}, {1, 1, -1}, {1, 1, 1}
+  };
+
+  //reference periodic wrap
+  size_t Wrap(size_t i, int64_t offset, size_t dim)
+  {
+    int64_t wrapped = (static_cast<int64_t>(i) + offset) % static_cast<int64_t>(dim);
+    return static_cast<size_t>(wrapped < 0 ? wrapped + static_cast<int64_t>(dim) : wrapped);
+  }
+
+  size_t ReferenceNeighbor(const size_t* dims, size_t x, size_t y, size_t z, int64_t dx, int64_t dy, int64_t dz)
+  {
+    return (Wrap(z, dz, dims[2]) * dims[1] + Wrap(y, dy, dims[1])) * dims[0] + Wrap(x, dx, dims[0]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestIndexing()
+{
+  for(size_t d = 0; d < NumTestDimensions; d++)
+  {
+    const size_t* dims = TestDimensions[d];
+    CellularAutomata::Lattice lattice(dims[0], dims[1], dims[2]);
+    DREAM3D_REQUIRE_EQUAL(lattice.size(), dims[0] * dims[1] * dims[2])
+    DREAM3D_REQUIRE_EQUAL(lattice.Is2D(), 1 == dims[2])
+    DREAM3D_REQUIRE(lattice.Fits32Bit())
+
+    size_t x, y, z;
+    for(size_t i = 0; i < lattice.size(); i++)
+    {
+      lattice.ToTuple(i, x, y, z);
+      DREAM3D_REQUIRE(x < dims[0] && y < dims[1] && z < dims[2])
+      DREAM3D_REQUIRE_EQUAL(lattice.ToIndex(x, y, z), i)
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestOffsets()
+{
+  //offsets of several periods in both directions
+  const int64_t offsets[] = { -27, -13, -5, -2, -1, 0, 1, 2, 5, 13, 27 };
+  const size_t numOffsets = sizeof(offsets) / sizeof(offsets[0]);
+  for(size_t d = 0; d < NumTestDimensions; d++)
+  {
+    const size_t* dims = TestDimensions[d];
+    CellularAutomata::Lattice lattice(dims[0], dims[1], dims[2]);
+    size_t x, y, z;
+    for(size_t i = 0; i < lattice.size(); i++)
+    {
+      lattice.ToTuple(i, x, y, z);
+      for(size_t a = 0; a < numOffsets; a++)
+      {
+        for(size_t b = 0; b < numOffsets; b++)
+        {
+          int64_t dx = offsets[a], dy = offsets[b], dz = offsets[(a + b) % numOffsets];
+          size_t expected = ReferenceNeighbor(dims, x, y, z, dx, dy, dz);
+          DREAM3D_REQUIRE_EQUAL(lattice(x, y, z, dx, dy, dz), expected)
+          DREAM3D_REQUIRE_EQUAL(lattice(i, dx, dy, dz), expected)
+        }
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestNeighborhoods()
+{
+  for(size_t d = 0; d < NumTestDimensions; d++)
+  {
+    const size_t* dims = TestDimensions[d];
+    CellularAutomata::Lattice lattice(dims[0], dims[1], dims[2]);
+    size_t x, y, z;
+    for(size_t i = 0; i < lattice.size(); i++)
+    {
+      lattice.ToTuple(i, x, y, z);
+      std::vector<size_t> expected(26);
+      for(size_t n = 0; n < 26; n++)
+      {
+        expected[n] = ReferenceNeighbor(dims, x, y, z, MooreOffsets[n][0], MooreOffsets[n][1], MooreOffsets[n][2]);
+      }
+
+      //vector versions are prefixes of the Moore order
+      std::vector<size_t> vonNeumann = lattice.VonNeumann(i);
+      std::vector<size_t> eighteen = lattice.EighteenCell(i);
+      std::vector<size_t> moore = lattice.Moore(i);
+      DREAM3D_REQUIRE(std::equal(vonNeumann.begin(), vonNeumann.end(), expected.begin()))
+      DREAM3D_REQUIRE(std::equal(eighteen.begin(), eighteen.end(), expected.begin()))
+      DREAM3D_REQUIRE(moore == expected)
+      DREAM3D_REQUIRE(lattice.Moore(x, y, z) == expected)
+
+      //32 and 64 bit tables
+      uint32_t narrow[26];
+      uint64_t wide[26];
+      lattice.Neighbors(i, 26, narrow);
+      lattice.Neighbors(i, 26, wide);
+      for(size_t n = 0; n < 26; n++)
+      {
+        DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(narrow[n]), expected[n])
+        DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(wide[n]), expected[n])
+      }
+
+      //variant neighborhoods contain the faces and stay within the Moore neighborhood
+      for(size_t variant = 0; variant < 6; variant++)
+      {
+        std::vector<size_t> eight = lattice.EightCell(i, variant);
+        DREAM3D_REQUIRE(std::equal(eight.begin(), eight.begin() + 6, expected.begin()))
+        for(size_t n = 6; n < eight.size(); n++) { DREAM3D_REQUIRE(std::find(expected.begin(), expected.end(), eight[n]) != expected.end()) }
+        if(variant >= 4) { continue; }
+        std::vector<size_t> fourteen = lattice.FourteenCell(i, variant);
+        std::vector<size_t> twenty = lattice.TwentyCell(i, variant);
+        DREAM3D_REQUIRE(std::equal(fourteen.begin(), fourteen.begin() + 6, expected.begin()))
+        DREAM3D_REQUIRE(std::equal(twenty.begin(), twenty.begin() + 18, expected.begin()))
+        for(size_t n = 6; n < fourteen.size(); n++) { DREAM3D_REQUIRE(std::find(expected.begin(), expected.end(), fourteen[n]) != expected.end()) }
+        for(size_t n = 18; n < twenty.size(); n++) { DREAM3D_REQUIRE(std::find(expected.begin(), expected.end(), twenty[n]) != expected.end()) }
+      }
+
+      //2 shell neighborhood covers exactly the cells within 2 steps along every axis (ignoring the cell itself, which thin axes wrap onto)
+      std::vector<size_t> extended = lattice.ExtendedMoore(i);
+      extended.erase(std::remove(extended.begin(), extended.end(), i), extended.end());
+      std::vector<size_t> reference;
+      for(int64_t dz = -2; dz <= 2; dz++)
+      {
+        for(int64_t dy = -2; dy <= 2; dy++)
+        {
+          for(int64_t dx = -2; dx <= 2; dx++)
+          {
+            size_t neighbor = ReferenceNeighbor(dims, x, y, z, dx, dy, dz);
+            if(neighbor != i) { reference.push_back(neighbor); }
+          }
+        }
+      }
+      std::sort(extended.begin(), extended.end());
+      extended.erase(std::unique(extended.begin(), extended.end()), extended.end());
+      std::sort(reference.begin(), reference.end());
+      reference.erase(std::unique(reference.begin(), reference.end()), reference.end());
+      DREAM3D_REQUIRE(extended == reference)
+      if(lattice.Is2D()) { DREAM3D_REQUIRE_EQUAL(lattice.ExtendedMoore(i).size(), static_cast<size_t>(24)) }
+      else { DREAM3D_REQUIRE_EQUAL(lattice.ExtendedMoore(i).size(), static_cast<size_t>(124)) }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestLargeIndices()
+{
+  //more than 2^32 cells (only indices are computed, nothing is allocated)
+  CellularAutomata::Lattice lattice(70000, 50000, 3);
+  DREAM3D_REQUIRE(!lattice.Fits32Bit())
+  const size_t dims[3] = { 70000, 50000, 3 };
+  const size_t cells[][3] = { {69999, 49999, 2}, {0, 0, 2}, {12345, 49000, 1}, {69999, 0, 0} };
+  for(size_t c = 0; c < sizeof(cells) / sizeof(cells[0]); c++)
+  {
+    size_t index = lattice.ToIndex(cells[c][0], cells[c][1], cells[c][2]);
+    size_t x, y, z;
+    lattice.ToTuple(index, x, y, z);
+    DREAM3D_REQUIRE(x == cells[c][0] && y == cells[c][1] && z == cells[c][2])
+
+    std::vector<size_t> moore = lattice.Moore(index);
+    uint64_t wide[26];
+    lattice.Neighbors(index, 26, wide);
+    for(size_t n = 0; n < 26; n++)
+    {
+      size_t expected = ReferenceNeighbor(dims, x, y, z, MooreOffsets[n][0], MooreOffsets[n][1], MooreOffsets[n][2]);
+      DREAM3D_REQUIRE_EQUAL(moore[n], expected)
+      DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(wide[n]), expected)
+      DREAM3D_REQUIRE_EQUAL(lattice(index, MooreOffsets[n][0], MooreOffsets[n][1], MooreOffsets[n][2]), expected)
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestDomain()
+{
+  for(size_t d = 0; d < NumTestDimensions; d++)
+  {
+    const size_t* dims = TestDimensions[d];
+    CellularAutomata::Lattice lattice(dims[0], dims[1], dims[2]);
+    std::vector<char> mask(lattice.size());
+    size_t x, y, z;
+    for(size_t i = 0; i < lattice.size(); i++)
+    {
+      lattice.ToTuple(i, x, y, z);
+      mask[i] = (x + 2 * y + 3 * z) % 4 != 0;
+    }
+    bool* maskPtr = new bool[lattice.size()];
+    std::copy(mask.begin(), mask.end(), maskPtr);
+    CellularAutomata::Domain domain(lattice, maskPtr, 26);
+    DREAM3D_REQUIRE(!domain.wide())
+    CellularAutomata::Domain wideDomain(lattice, maskPtr, 26, true);
+    DREAM3D_REQUIRE(wideDomain.wide())
+    DREAM3D_REQUIRE_EQUAL(wideDomain.size(), domain.size())
+
+    size_t active = 0;
+    for(size_t i = 0; i < lattice.size(); i++)
+    {
+      if(!mask[i])
+      {
+        DREAM3D_REQUIRE(!domain.contains(i))
+        continue;
+      }
+      DREAM3D_REQUIRE_EQUAL(domain.compactIndex(i), active)
+      DREAM3D_REQUIRE_EQUAL(domain.fullIndex(active), i)
+
+      //table entries are the compact index of each Moore neighbor, or the padding cell outside the mask
+      //(the forced 64 bit table holds the same entries)
+      std::vector<size_t> moore = lattice.Moore(i);
+      const uint32_t* neighbors = domain.neighbors(active);
+      const uint64_t* wideNeighbors = wideDomain.wideNeighbors(active);
+      for(size_t n = 0; n < 26; n++)
+      {
+        size_t expected = mask[moore[n]] ? domain.compactIndex(moore[n]) : domain.size();
+        DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(neighbors[n]), expected)
+        DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(wideNeighbors[n]), expected)
+      }
+      active++;
+    }
+    DREAM3D_REQUIRE_EQUAL(domain.size(), active)
+    delete[] maskPtr;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("LatticeTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( TestIndexing() )
+  DREAM3D_REGISTER_TEST( TestOffsets() )
+  DREAM3D_REGISTER_TEST( TestNeighborhoods() )
+  DREAM3D_REGISTER_TEST( TestLargeIndices() )
+  DREAM3D_REGISTER_TEST( TestDomain() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
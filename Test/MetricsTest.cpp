@@ -0,0 +1,90 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QElapsedTimer>
+
+#include "UnitTestSupport.hpp"
+
+#include "CellularAutomataMetrics.hpp"
+
+#include "CelluarAutomataTestFileLocations.h"
+
+// -----------------------------------------------------------------------------
+// Metrics are written in the Prometheus text format, the file holds the last metrics published
+// -----------------------------------------------------------------------------
+void TestMetrics()
+{
+  CellularAutomata::SimulationMetrics metrics;
+  metrics.iteration = 12;
+  metrics.timeStep = 10;
+  metrics.fraction = 0.25f;
+  metrics.grainCount = 7;
+  QByteArray text = CellularAutomata::FormatMetrics(metrics);
+  DREAM3D_REQUIRE(text.contains("\n# TYPE recrystallization_fraction gauge\nrecrystallization_fraction 0.25\n"))
+  DREAM3D_REQUIRE(text.contains("\nrecrystallization_grain_count 7\n"))
+  DREAM3D_REQUIRE(text.contains("\nrecrystallization_eta_seconds NaN\n"))
+  metrics.grainCount = -1;
+  DREAM3D_REQUIRE(!CellularAutomata::FormatMetrics(metrics).contains("recrystallization_grain_count"))
+
+  //the remaining time is unknown until the front has moved and 0 once the target is reached
+  CellularAutomata::ProgressEstimate progress(0.5f);
+  QElapsedTimer timer;
+  const float fractions[] = { 0.0f, 0.0f, 0.1f, 0.2f, 0.5f };
+  for(size_t s = 0; s < 5; s++)
+  {
+    timer.start();
+    while(timer.nsecsElapsed() < 1000000) {}
+    progress.step(1000, fractions[s], metrics);
+    DREAM3D_REQUIRE(metrics.cellsPerSecond > 0.0)
+    if(s < 2) { DREAM3D_REQUIRE(metrics.etaSeconds < 0.0) }
+    else if(s < 4) { DREAM3D_REQUIRE(metrics.etaSeconds > 0.0) }
+    else { DREAM3D_REQUIRE_EQUAL(metrics.etaSeconds, 0.0) }
+  }
+
+  QString path = UnitTest::TestTempDir + "/CellularAutomataMetrics.prom";
+  {
+    CellularAutomata::MetricsWriter writer(path);
+    for(uint64_t i = 1; i <= 100; i++)
+    {
+      metrics.iteration = i;
+      metrics.finished = 100 == i;
+      writer.publish(metrics);
+    }
+    DREAM3D_REQUIRE(writer.finish())
+  }
+  QFile file(path);
+  DREAM3D_REQUIRE(file.open(QIODevice::ReadOnly))
+  QByteArray written = file.readAll();
+  file.close();
+  DREAM3D_REQUIRE(written.contains("\nrecrystallization_steps_total 100\n"))
+  DREAM3D_REQUIRE(written.contains("\nrecrystallization_finished 1\n"))
+  DREAM3D_REQUIRE(CellularAutomata::ResidentMemory() > 0)
+  DREAM3D_REQUIRE(!written.contains("\nprocess_resident_memory_bytes 0\n"))
+#if REMOVE_TEST_FILES
+  QFile::remove(path);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("MetricsTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( TestMetrics() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
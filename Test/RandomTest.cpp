@@ -0,0 +1,79 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <cmath>
+
+#include <QtCore/QCoreApplication>
+
+#include "UnitTestSupport.hpp"
+
+#include "CellularAutomataRandom.hpp"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestVariateStream()
+{
+  DREAM3D_REQUIRE_EQUAL(CellularAutomata::ProbabilityThreshold(0.0), static_cast<uint64_t>(0))
+  DREAM3D_REQUIRE_EQUAL(CellularAutomata::ProbabilityThreshold(1.0), static_cast<uint64_t>(1) << 32)
+  DREAM3D_REQUIRE_EQUAL(CellularAutomata::ProbabilityThreshold(0.5), static_cast<uint64_t>(1) << 31)
+  DREAM3D_REQUIRE_EQUAL(CellularAutomata::ProbabilityThreshold(1.0e-12), static_cast<uint64_t>(1))
+
+  //streams are reproducible and differ between seeds (across buffer refills)
+  const size_t draws = 3 * CellularAutomata::VariateStream::BufferSize + 7;
+  CellularAutomata::VariateStream a(CellularAutomata::StreamSeed(1, 2, 3));
+  CellularAutomata::VariateStream b(CellularAutomata::StreamSeed(1, 2, 3));
+  CellularAutomata::VariateStream c(CellularAutomata::StreamSeed(1, 2, 4));
+  size_t equal = 0;
+  for(size_t i = 0; i < draws; i++)
+  {
+    uint32_t value = a();
+    DREAM3D_REQUIRE_EQUAL(value, b())
+    if(value == c()) { equal++; }
+  }
+  DREAM3D_REQUIRE(equal < 2)
+
+  //uniform choices and threshold probabilities stay within 5 standard errors
+  const size_t samples = 600000;
+  std::vector<size_t> counts(6, 0);
+  size_t passed = 0;
+  const uint64_t threshold = CellularAutomata::ProbabilityThreshold(0.01);
+  CellularAutomata::VariateStream stream(CellularAutomata::StreamSeed(5, 0));
+  for(size_t i = 0; i < samples; i++)
+  {
+    uint32_t choice = stream.below(6);
+    DREAM3D_REQUIRE(choice < 6)
+    counts[choice]++;
+    if(stream.passes(threshold)) { passed++; }
+    double u = stream.uniform();
+    DREAM3D_REQUIRE(u > 0.0 && u < 1.0)
+  }
+  for(size_t i = 0; i < 6; i++)
+  {
+    double expected = samples / 6.0;
+    DREAM3D_REQUIRE(std::fabs(counts[i] - expected) < 5.0 * std::sqrt(expected * (5.0 / 6.0)))
+  }
+  DREAM3D_REQUIRE(std::fabs(passed - samples * 0.01) < 5.0 * std::sqrt(samples * 0.01 * 0.99))
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("RandomTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( TestVariateStream() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
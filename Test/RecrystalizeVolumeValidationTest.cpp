@@ -0,0 +1,1648 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QVariant>
+#include <QtCore/QFile>
+#include <QtCore/QDir>
+
+#include "DREAM3DLib/DREAM3DLib.h"
+#include "DREAM3DLib/Common/FilterManager.h"
+#include "DREAM3DLib/Common/IFilterFactory.hpp"
+#include "DREAM3DLib/DataContainers/DataContainerArray.h"
+#include "DREAM3DLib/FilterParameters/FilterParameter.h"
+#include "DREAM3DLib/Geometry/ImageGeom.h"
+#include "DREAM3DLib/Plugin/DREAM3DPluginLoader.h"
+#include "DREAM3DLib/Utilities/QMetaObjectUtilities.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "CellularAutomataKinetics.hpp"
+#include "CellularAutomataDistributed.hpp"
+#include "CellularAutomataGrainGrowth.hpp"
+#include "CellularAutomataEngine.hpp"
+#include "CellularAutomataCompressedVolume.hpp"
+#include "CellularAutomataResultCache.hpp"
+#include "CellularAutomataFrames.hpp"
+
+#include "CelluarAutomataTestFileLocations.h"
+
+/*
+ * Runs RecrystalizeVolume on small lattices with a fixed seed.
+ *
+ * Differential validation of the optimized simulation paths of RecrystalizeVolume against the reference kernel (every
+ * cell of the lattice, 3D neighbor lists). Paths that consume the random streams in the same order (masked domain,
+ * planar slice kernel) have to reproduce the reference exactly for a fixed seed, the others (bit-sliced replicas,
+ * weighted nucleation sites, duplicate neighbors of 3D neighborhoods on a single slice) are compared statistically over
+ * many seeds: mean steps to completion and final grain counts within MaxStandardErrors combined standard errors, the
+ * mean recrystallization curve and the Avrami parameters of the pooled curves within fixed tolerances.
+ */
+namespace
+{
+  const QString InputDataContainerName("Input");
+  const QString InputAttributeMatrixName("CellData");
+  const QString MaskArrayName("Mask");
+  const QString WeightsArrayName("Weights");
+  const QString InitialFeatureIdsArrayName("InitialFeatureIds");
+  const QString InitialRecrystallizationTimeArrayName("InitialRecrystallizationTime");
+
+  //small lattices with every pair of dimensions different
+  const size_t VolumeDimensions[][3] = { {9, 7, 5}, {6, 11, 4}, {13, 5, 3}, {4, 4, 10} };
+  const size_t NumVolumeDimensions = sizeof(VolumeDimensions) / sizeof(VolumeDimensions[0]);
+
+  //single slices (hexagonal needs an even y dimension)
+  const size_t SliceDimensions[][3] = { {24, 18, 1}, {31, 12, 1}, {10, 40, 1} };
+  const size_t NumSliceDimensions = sizeof(SliceDimensions) / sizeof(SliceDimensions[0]);
+
+  //statistical tolerances (measured spread of the 20^3 comparisons is about 1/3 of each)
+  const double MaxStandardErrors = 5.0;
+  const double MaxCurveDifference = 0.08;
+  const double MaxRelativeAvramiN = 0.08;
+  const double MaxLogAvramiK = 0.5;
+
+  struct RunSettings
+  {
+    RunSettings() : nucleationRate(0.001f), neighborhood(0), seed(5489), kineticsOnly(false), checkpointInterval(0), checkpointFile(""), resumeFromCheckpoint(false),
+      initialFeatureIds(NULL), initialRecrystallizationTime(NULL), warmStartTimeStep(0),
+      resultCacheDirectory(""),
+      frameInterval(0), frameFile(""),
+      maxTimeStep(0), targetFraction(1.0f), wallClockLimit(0.0), avramiTolerance(0.0f), fillRemainder(false),
+      weights(NULL),
+      mask(NULL),
+      engine(0),
+      memoryLimit(0.0),
+      grainGrowthSteps(0),
+      maximumThreads(0), taskGrainSize(0),
+      metricsFile(""),
+      compressedVolumeFile("")
+    {
+      dims[0] = dims[1] = dims[2] = 1;
+    }
+
+    size_t dims[3];
+    float nucleationRate;
+    unsigned int neighborhood;
+    int seed;
+    bool kineticsOnly;
+    int checkpointInterval;//0 disables
+    QString checkpointFile;
+    bool resumeFromCheckpoint;
+    const std::vector<int32_t>* initialFeatureIds;//warm starts if not NULL
+    const std::vector<uint32_t>* initialRecrystallizationTime;
+    int warmStartTimeStep;
+    QString resultCacheDirectory;//empty disables
+    int frameInterval;//0 disables
+    QString frameFile;
+    int maxTimeStep;//0 runs to completion
+    float targetFraction;//1 disables
+    double wallClockLimit;//seconds (0 disables)
+    float avramiTolerance;//0 disables
+    bool fillRemainder;
+    const std::vector<float>* weights;
+    const std::vector<bool>* mask;
+    unsigned int engine;
+    double memoryLimit;//GB (0 uses the default)
+    int grainGrowthSteps;
+    int maximumThreads;//0 uses all
+    int taskGrainSize;//random blocks per task (0 picks one)
+    QString metricsFile;//empty disables
+    QString compressedVolumeFile;//empty disables
+  };
+
+  struct RunResult
+  {
+    std::vector<int32_t> featureIds;
+    std::vector<uint32_t> recrystallizationTime;
+    std::vector<float> history;
+    std::vector<int32_t> grainCounts;
+    std::vector<float> interfaceArea;
+    float avrami[2];
+  };
+
+  //running mean and standard error of a sample
+  class Sample
+  {
+      double m_sum;
+      double m_squares;
+      size_t m_count;
+
+    public:
+      Sample() : m_sum(0), m_squares(0), m_count(0) {}
+
+      void add(double value)
+      {
+        m_sum += value;
+        m_squares += value * value;
+        m_count++;
+      }
+
+      double mean() const
+      {
+        return m_sum / m_count;
+      }
+
+      double standardError() const
+      {
+        double variance = m_squares / m_count - mean() * mean();
+        return std::sqrt(std::max(0.0, variance) / m_count);
+      }
+  };
+
+  //statistics of the runs of one engine
+  struct Ensemble
+  {
+    Ensemble() : curve(500, 0.0), runs(0) {}
+
+    void add(const std::vector<float>& history, double grains)
+    {
+      for(size_t t = 0; t < history.size(); t++)
+      { regression.add(static_cast<double>(t), history[t]); }
+      for(size_t t = 0; t < curve.size(); t++)
+      { curve[t] += t < history.size() ? history[t] : 1.0; }
+      steps.add(static_cast<double>(history.size()));
+      grainCount.add(grains);
+      runs++;
+    }
+
+    double curveValue(size_t t) const
+    {
+      return curve[t] / runs;
+    }
+
+    CellularAutomata::AvramiRegression regression;
+    std::vector<double> curve;//sum of the recrystallized fraction at each step (1 after completion)
+    Sample steps;
+    Sample grainCount;
+    size_t runs;
+  };
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  DREAM3DPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template<typename T>
+typename T::Pointer GetOutputArray(DataContainerArray::Pointer dca, const QString& attributeMatrixName, const QString& arrayName)
+{
+  AttributeMatrix::Pointer attrMat = dca->getDataContainer(DREAM3D::Defaults::SyntheticVolumeDataContainerName)->getAttributeMatrix(attributeMatrixName);
+  DREAM3D_REQUIRE(NULL != attrMat.get())
+  typename T::Pointer array = boost::dynamic_pointer_cast<T>(attrMat->getAttributeArray(arrayName));
+  DREAM3D_REQUIRE(NULL != array.get())
+  return array;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SetProperty(AbstractFilter::Pointer filter, const char* name, const QVariant& value)
+{
+  bool propWasSet = filter->setProperty(name, value);
+  DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+}
+
+// -----------------------------------------------------------------------------
+// Creates RecrystalizeVolume with a fixed seed and the settings, and its input volume in dca
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer CreateFilter(const RunSettings& settings, DataContainerArray::Pointer dca)
+{
+  IFilterFactory::Pointer filterFactory = FilterManager::Instance()->getFactoryForFilter("RecrystalizeVolume");
+  DREAM3D_REQUIRE(NULL != filterFactory.get())
+  AbstractFilter::Pointer filter = filterFactory->create();
+
+  //masks, nucleation weights and warm start volumes are read from an input volume with the same dimensions
+  size_t numCells = settings.dims[0] * settings.dims[1] * settings.dims[2];
+  if(NULL != settings.mask || NULL != settings.weights || NULL != settings.initialFeatureIds)
+  {
+    DataContainer::Pointer input = DataContainer::New(InputDataContainerName);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+    image->setDimensions(settings.dims[0], settings.dims[1], settings.dims[2]);
+    input->setGeometry(image);
+    dca->addDataContainer(input);
+
+    QVector<size_t> tDims(3, 0);
+    for(size_t i = 0; i < 3; i++) { tDims[i] = settings.dims[i]; }
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, InputAttributeMatrixName, DREAM3D::AttributeMatrixType::Cell);
+    input->addAttributeMatrix(InputAttributeMatrixName, cellAttrMat);
+
+    QVector<size_t> cDims(1, 1);
+    QVariant var;
+    if(NULL != settings.mask)
+    {
+      BoolArrayType::Pointer mask = BoolArrayType::CreateArray(numCells, cDims, MaskArrayName);
+      std::copy(settings.mask->begin(), settings.mask->end(), mask->getPointer(0));
+      cellAttrMat->addAttributeArray(MaskArrayName, mask);
+      SetProperty(filter, "UseMask", true);
+      var.setValue(DataArrayPath(InputDataContainerName, InputAttributeMatrixName, MaskArrayName));
+      SetProperty(filter, "MaskArrayPath", var);
+    }
+    if(NULL != settings.weights)
+    {
+      FloatArrayType::Pointer weights = FloatArrayType::CreateArray(numCells, cDims, WeightsArrayName);
+      std::copy(settings.weights->begin(), settings.weights->end(), weights->getPointer(0));
+      cellAttrMat->addAttributeArray(WeightsArrayName, weights);
+      SetProperty(filter, "HeterogeneousNucleation", true);
+      var.setValue(DataArrayPath(InputDataContainerName, InputAttributeMatrixName, WeightsArrayName));
+      SetProperty(filter, "NucleationWeightsArrayPath", var);
+    }
+    if(NULL != settings.initialFeatureIds)
+    {
+      Int32ArrayType::Pointer ids = Int32ArrayType::CreateArray(numCells, cDims, InitialFeatureIdsArrayName);
+      std::copy(settings.initialFeatureIds->begin(), settings.initialFeatureIds->end(), ids->getPointer(0));
+      cellAttrMat->addAttributeArray(InitialFeatureIdsArrayName, ids);
+      UInt32ArrayType::Pointer times = UInt32ArrayType::CreateArray(numCells, cDims, InitialRecrystallizationTimeArrayName);
+      std::copy(settings.initialRecrystallizationTime->begin(), settings.initialRecrystallizationTime->end(), times->getPointer(0));
+      cellAttrMat->addAttributeArray(InitialRecrystallizationTimeArrayName, times);
+      SetProperty(filter, "WarmStart", true);
+      var.setValue(DataArrayPath(InputDataContainerName, InputAttributeMatrixName, InitialFeatureIdsArrayName));
+      SetProperty(filter, "InitialFeatureIdsArrayPath", var);
+      var.setValue(DataArrayPath(InputDataContainerName, InputAttributeMatrixName, InitialRecrystallizationTimeArrayName));
+      SetProperty(filter, "InitialRecrystallizationTimeArrayPath", var);
+      SetProperty(filter, "WarmStartTimeStep", settings.warmStartTimeStep);
+    }
+  }
+
+  IntVec3_t dimensions = { static_cast<int>(settings.dims[0]), static_cast<int>(settings.dims[1]), static_cast<int>(settings.dims[2]) };
+  FloatVec3_t resolution = { 1.0f, 1.0f, 1.0f };
+  QVariant var;
+  var.setValue(dimensions);
+  SetProperty(filter, "Dimensions", var);
+  var.setValue(resolution);
+  SetProperty(filter, "Resolution", var);
+  SetProperty(filter, "NucleationRate", settings.nucleationRate);
+  SetProperty(filter, "Neighborhood", settings.neighborhood);
+  SetProperty(filter, "Engine", settings.engine);
+  SetProperty(filter, "KineticsOnly", settings.kineticsOnly);
+  SetProperty(filter, "FixedSeed", true);
+  SetProperty(filter, "Seed", settings.seed);
+  SetProperty(filter, "MemoryLimit", settings.memoryLimit);
+  SetProperty(filter, "GrainGrowthSteps", settings.grainGrowthSteps);
+  SetProperty(filter, "MaximumThreads", settings.maximumThreads);
+  SetProperty(filter, "TaskGrainSize", settings.taskGrainSize);
+  SetProperty(filter, "MetricsFile", settings.metricsFile);
+  SetProperty(filter, "CompressedVolumeFile", settings.compressedVolumeFile);
+  SetProperty(filter, "CheckpointInterval", settings.checkpointInterval);
+  SetProperty(filter, "CheckpointFile", settings.checkpointFile);
+  SetProperty(filter, "ResumeFromCheckpoint", settings.resumeFromCheckpoint);
+  SetProperty(filter, "MaxTimeStep", settings.maxTimeStep);
+  SetProperty(filter, "TargetFraction", settings.targetFraction);
+  SetProperty(filter, "WallClockLimit", settings.wallClockLimit);
+  SetProperty(filter, "AvramiTolerance", settings.avramiTolerance);
+  SetProperty(filter, "FillRemainder", settings.fillRemainder);
+  SetProperty(filter, "UseResultCache", !settings.resultCacheDirectory.isEmpty());
+  SetProperty(filter, "ResultCacheDirectory", settings.resultCacheDirectory);
+  SetProperty(filter, "FrameInterval", settings.frameInterval);
+  SetProperty(filter, "FrameFile", settings.frameFile);
+  filter->setDataContainerArray(dca);
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+// Runs RecrystalizeVolume once with a fixed seed and collects its outputs
+// -----------------------------------------------------------------------------
+RunResult RunFilter(const RunSettings& settings)
+{
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  AbstractFilter::Pointer filter = CreateFilter(settings, dca);
+  filter->execute();
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  RunResult result;
+  if(!settings.kineticsOnly)
+  {
+    Int32ArrayType::Pointer ids = GetOutputArray<Int32ArrayType>(dca, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds);
+    UInt32ArrayType::Pointer times = GetOutputArray<UInt32ArrayType>(dca, DREAM3D::Defaults::CellAttributeMatrixName, "RecrystallizationTime");
+    Int32ArrayType::Pointer grainCounts = GetOutputArray<Int32ArrayType>(dca, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, "GrainCount");
+    FloatArrayType::Pointer interfaceArea = GetOutputArray<FloatArrayType>(dca, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, "InterfaceArea");
+    result.featureIds.assign(ids->getPointer(0), ids->getPointer(0) + ids->getSize());
+    result.recrystallizationTime.assign(times->getPointer(0), times->getPointer(0) + times->getSize());
+    result.grainCounts.assign(grainCounts->getPointer(0), grainCounts->getPointer(0) + grainCounts->getSize());
+    result.interfaceArea.assign(interfaceArea->getPointer(0), interfaceArea->getPointer(0) + interfaceArea->getSize());
+  }
+  FloatArrayType::Pointer history = GetOutputArray<FloatArrayType>(dca, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, "RecrystallizationHistory");
+  FloatArrayType::Pointer avrami = GetOutputArray<FloatArrayType>(dca, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, "AvaramiParameters");
+  result.history.assign(history->getPointer(0), history->getPointer(0) + history->getSize());
+  result.avrami[0] = avrami->getValue(0);
+  result.avrami[1] = avrami->getValue(1);
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+// Executes RecrystalizeVolume with settings it has to refuse with error
+// -----------------------------------------------------------------------------
+void RequireRejected(const RunSettings& settings, int error)
+{
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  AbstractFilter::Pointer filter = CreateFilter(settings, dca);
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), error)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RequireIdentical(const RunResult& reference, const RunResult& optimized)
+{
+  DREAM3D_REQUIRE(reference.featureIds == optimized.featureIds)
+  DREAM3D_REQUIRE(reference.recrystallizationTime == optimized.recrystallizationTime)
+  DREAM3D_REQUIRE(reference.history == optimized.history)
+  DREAM3D_REQUIRE(reference.grainCounts == optimized.grainCounts)
+  DREAM3D_REQUIRE(reference.interfaceArea == optimized.interfaceArea)
+  DREAM3D_REQUIRE_EQUAL(reference.avrami[0], optimized.avrami[0])
+  DREAM3D_REQUIRE_EQUAL(reference.avrami[1], optimized.avrami[1])
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RequireEquivalent(const Sample& reference, const Sample& optimized)
+{
+  double error = std::sqrt(reference.standardError() * reference.standardError() + optimized.standardError() * optimized.standardError());
+  DREAM3D_REQUIRE(std::fabs(reference.mean() - optimized.mean()) <= MaxStandardErrors * error + 1.0e-6 * reference.mean())
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RequireEquivalent(const Ensemble& reference, const Ensemble& optimized, bool grainCounts)
+{
+  RequireEquivalent(reference.steps, optimized.steps);
+  if(grainCounts)
+  { RequireEquivalent(reference.grainCount, optimized.grainCount); }
+
+  for(size_t t = 0; t < reference.curve.size(); t++)
+  { DREAM3D_REQUIRE(std::fabs(reference.curveValue(t) - optimized.curveValue(t)) <= MaxCurveDifference) }
+
+  double referenceK, referenceN, optimizedK, optimizedN;
+  DREAM3D_REQUIRE(reference.regression.fit(referenceK, referenceN))
+  DREAM3D_REQUIRE(optimized.regression.fit(optimizedK, optimizedN))
+  DREAM3D_REQUIRE(std::fabs(optimizedN - referenceN) <= MaxRelativeAvramiN * referenceN)
+  DREAM3D_REQUIRE(std::fabs(std::log(optimizedK / referenceK)) <= MaxLogAvramiK)
+}
+
+// -----------------------------------------------------------------------------
+// The same seed has to give the same volume (the random streams don't depend on the thread count or scheduling)
+// -----------------------------------------------------------------------------
+void TestReproducible()
+{
+  RunSettings settings;
+  std::copy(VolumeDimensions[0], VolumeDimensions[0] + 3, settings.dims);
+  for(unsigned int nb = 0; nb < 6; nb++)
+  {
+    settings.neighborhood = nb;
+    settings.seed = 100 + nb;
+    RequireIdentical(RunFilter(settings), RunFilter(settings));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Serial, parallel and automatically chosen (including timed) strategies have to give the same result
+// -----------------------------------------------------------------------------
+void TestEngines()
+{
+  const size_t dims[][3] = { {40, 30, 20}, {20, 24, 18}, {150, 120, 1} };
+  for(size_t d = 0; d < 3; d++)
+  {
+    RunSettings settings;
+    std::copy(dims[d], dims[d] + 3, settings.dims);
+    settings.nucleationRate = 0.0005f;
+    for(unsigned int nb = 0; nb < 6; nb += 5)
+    {
+      settings.neighborhood = nb;
+      settings.seed = static_cast<int>(50 + d);
+      settings.engine = 2;
+      RunResult reference = RunFilter(settings);
+      for(unsigned int engine = 0; engine < 2; engine++)
+      {
+        settings.engine = engine;
+        RequireIdentical(reference, RunFilter(settings));
+      }
+
+      settings.kineticsOnly = true;
+      settings.engine = 2;
+      RunResult serial = RunFilter(settings);
+      settings.engine = 0;
+      DREAM3D_REQUIRE(serial.history == RunFilter(settings).history)
+      settings.kineticsOnly = false;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// A mask selecting every cell runs the compacted domain kernel, which has to reproduce the full lattice exactly
+// -----------------------------------------------------------------------------
+void TestMaskedKernel()
+{
+  for(size_t d = 0; d < NumVolumeDimensions; d++)
+  {
+    RunSettings settings;
+    std::copy(VolumeDimensions[d], VolumeDimensions[d] + 3, settings.dims);
+    std::vector<bool> all(settings.dims[0] * settings.dims[1] * settings.dims[2], true);
+    settings.nucleationRate = 0.002f;
+    for(unsigned int nb = 0; nb < 6; nb++)
+    {
+      settings.neighborhood = nb;
+      settings.seed = static_cast<int>(17 * d + nb);
+      settings.mask = NULL;
+      RunResult reference = RunFilter(settings);
+      settings.mask = &all;
+      RequireIdentical(reference, RunFilter(settings));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Unmasked single slices run the planar kernel, the masked domain kernel with the same neighborhood is the reference
+// -----------------------------------------------------------------------------
+void TestPlanarKernel()
+{
+  const unsigned int neighborhoods[] = { 0, 6, 7, 8 };
+  for(size_t d = 0; d < NumSliceDimensions; d++)
+  {
+    RunSettings settings;
+    std::copy(SliceDimensions[d], SliceDimensions[d] + 3, settings.dims);
+    std::vector<bool> all(settings.dims[0] * settings.dims[1], true);
+    settings.nucleationRate = 0.002f;
+    for(size_t i = 0; i < 4; i++)
+    {
+      for(int seed = 0; seed < 3; seed++)
+      {
+        settings.neighborhood = neighborhoods[i];
+        settings.seed = static_cast<int>(31 * d + 7 * i + seed);
+        settings.mask = &all;
+        RunResult reference = RunFilter(settings);
+        settings.mask = NULL;
+        RequireIdentical(reference, RunFilter(settings));
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// The 26 cell neighborhood of a single slice (masked, so it isn't mapped to the planar kernel) lists the in plane
+// neighbors several times, which changes the random draws but not the kinetics of the 8 cell square neighborhood
+// -----------------------------------------------------------------------------
+void TestMooreSlice()
+{
+  RunSettings settings;
+  settings.dims[0] = 60;
+  settings.dims[1] = 48;
+  settings.nucleationRate = 0.0005f;
+  std::vector<bool> all(settings.dims[0] * settings.dims[1], true);
+
+  Ensemble moore, square;
+  for(int seed = 0; seed < 24; seed++)
+  {
+    settings.seed = 1000 + seed;
+    settings.neighborhood = 5;
+    settings.mask = &all;
+    RunResult result = RunFilter(settings);
+    moore.add(result.history, result.grainCounts.back());
+
+    settings.neighborhood = 7;
+    settings.mask = NULL;
+    result = RunFilter(settings);
+    square.add(result.history, result.grainCounts.back());
+  }
+  RequireEquivalent(moore, square, true);
+}
+
+// -----------------------------------------------------------------------------
+// Kinetics Only advances 64 bit-sliced replicas with their own random streams, its history (averaged over the
+// replicas) is compared to the pooled histories of reference runs for every neighborhood
+// -----------------------------------------------------------------------------
+void TestBitSliced()
+{
+  RunSettings settings;
+  settings.dims[0] = settings.dims[1] = settings.dims[2] = 20;
+  settings.nucleationRate = 0.0008f;
+  for(unsigned int nb = 0; nb < 6; nb++)
+  {
+    settings.neighborhood = nb;
+    settings.kineticsOnly = false;
+    Ensemble reference;
+    for(int seed = 0; seed < 32; seed++)
+    {
+      settings.seed = 2000 + seed;
+      RunResult result = RunFilter(settings);
+      reference.add(result.history, result.grainCounts.back());
+    }
+
+    settings.kineticsOnly = true;
+    settings.seed = 77 + nb;
+    Ensemble bitSliced;
+    bitSliced.add(RunFilter(settings).history, 0);
+
+    //a single (replica averaged) history has no spread of its own, only the curve and the avrami fit are compared
+    for(size_t t = 0; t < reference.curve.size(); t++)
+    { DREAM3D_REQUIRE(std::fabs(reference.curveValue(t) - bitSliced.curveValue(t)) <= MaxCurveDifference) }
+    double referenceK, referenceN, bitSlicedK, bitSlicedN;
+    DREAM3D_REQUIRE(reference.regression.fit(referenceK, referenceN))
+    DREAM3D_REQUIRE(bitSliced.regression.fit(bitSlicedK, bitSlicedN))
+    DREAM3D_REQUIRE(std::fabs(bitSlicedN - referenceN) <= MaxRelativeAvramiN * referenceN)
+    DREAM3D_REQUIRE(std::fabs(std::log(bitSlicedK / referenceK)) <= MaxLogAvramiK)
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Uniform nucleation weights draw sites from the alias table instead of testing every cell, with the same expected
+// number of nuclei per step
+// -----------------------------------------------------------------------------
+void TestHeterogeneousNucleation()
+{
+  RunSettings settings;
+  settings.dims[0] = 16;
+  settings.dims[1] = 20;
+  settings.dims[2] = 12;
+  settings.nucleationRate = 0.001f;
+  std::vector<float> uniform(settings.dims[0] * settings.dims[1] * settings.dims[2], 1.0f);
+  for(unsigned int nb = 0; nb < 6; nb += 5)
+  {
+    settings.neighborhood = nb;
+    Ensemble homogeneous, weighted;
+    for(int seed = 0; seed < 24; seed++)
+    {
+      settings.seed = 3000 + seed;
+      settings.weights = NULL;
+      RunResult result = RunFilter(settings);
+      homogeneous.add(result.history, result.grainCounts.back());
+
+      settings.weights = &uniform;
+      result = RunFilter(settings);
+      weighted.add(result.history, result.grainCounts.back());
+    }
+    RequireEquivalent(homogeneous, weighted, true);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Runs the distributed simulation (see CellularAutomataMPI) with the processes emulated in turn: halo transfers are
+// copies between the slabs and the reductions are sums over them.
+// -----------------------------------------------------------------------------
+RunResult RunDistributed(const RunSettings& settings, size_t processes)
+{
+  CellularAutomata::Lattice lattice(settings.dims[0], settings.dims[1], settings.dims[2]);
+  CellularAutomata::SlabPartition partition(lattice, processes);
+  std::vector<CellularAutomata::HaloTransfer> transfers = partition.transfers();
+  std::vector<CellularAutomata::Slab*> slabs;
+  for(size_t p = 0; p < processes; p++)
+  { slabs.push_back(new CellularAutomata::Slab(partition, p, settings.neighborhood)); }
+
+  RunResult result;
+  result.history.assign(1, 0.0f);
+  uint64_t seed = static_cast<uint64_t>(static_cast<uint32_t>(settings.seed));
+  uint64_t threshold = CellularAutomata::ProbabilityThreshold(settings.nucleationRate);
+  uint64_t iteration = 0;
+  uint32_t timeStep = 1;
+  int32_t grainCount = 0;
+  size_t unrecrystallized = lattice.size();
+  while(0 != unrecrystallized)
+  {
+    uint64_t stepSeed = CellularAutomata::StreamSeed(seed, iteration++);
+    unrecrystallized = 0;
+    for(size_t p = 0; p < processes; p++)
+    { unrecrystallized += slabs[p]->step(stepSeed, threshold, timeStep); }
+    for(size_t p = 0; p < processes; p++)
+    {
+      size_t nuclei = slabs[p]->nuclei();
+      slabs[p]->commit(grainCount + 1);
+      grainCount += static_cast<int32_t>(nuclei);
+    }
+    for(size_t t = 0; t < transfers.size(); t++)
+    {
+      CellularAutomata::Slab* from = slabs[transfers[t].from];
+      CellularAutomata::Slab* to = slabs[transfers[t].to];
+      std::copy(from->ids() + from->windowIndex(transfers[t].begin), from->ids() + from->windowIndex(transfers[t].begin) + (transfers[t].end - transfers[t].begin), to->ids() + to->windowIndex(transfers[t].begin));
+    }
+    float percent = 1 - (static_cast<float>(unrecrystallized) / lattice.size());
+    if(percent > 0)
+    {
+      timeStep++;
+      result.history.push_back(percent);
+    }
+  }
+
+  result.featureIds.resize(lattice.size());
+  result.recrystallizationTime.resize(lattice.size());
+  for(size_t p = 0; p < processes; p++)
+  {
+    std::copy(slabs[p]->ownIds(), slabs[p]->ownIds() + (slabs[p]->end() - slabs[p]->begin()), result.featureIds.begin() + slabs[p]->begin());
+    std::copy(slabs[p]->times(), slabs[p]->times() + (slabs[p]->end() - slabs[p]->begin()), result.recrystallizationTime.begin() + slabs[p]->begin());
+    delete slabs[p];
+  }
+  result.grainCounts.assign(1, grainCount);
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+// The distributed simulation has to reproduce the filter exactly, whatever the number of processes
+// -----------------------------------------------------------------------------
+void TestDistributed()
+{
+  RunSettings settings;
+  settings.dims[0] = 37;
+  settings.dims[1] = 29;
+  settings.dims[2] = 23;
+  settings.nucleationRate = 0.0002f;
+  const size_t processes[] = { 1, 3, 8 };
+  for(unsigned int nb = 0; nb < 6; nb++)
+  {
+    settings.neighborhood = nb;
+    settings.seed = 400 + nb;
+    RunResult reference = RunFilter(settings);
+    for(size_t p = 0; p < sizeof(processes) / sizeof(processes[0]); p++)
+    {
+      RunResult distributed = RunDistributed(settings, processes[p]);
+      DREAM3D_REQUIRE(reference.featureIds == distributed.featureIds)
+      DREAM3D_REQUIRE(reference.recrystallizationTime == distributed.recrystallizationTime)
+      DREAM3D_REQUIRE(reference.history == distributed.history)
+      DREAM3D_REQUIRE_EQUAL(reference.grainCounts.back(), distributed.grainCounts.back())
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// A memory limit below the lattice sized working array steps through a working window, which has to reproduce the
+// reference exactly. A limit below the outputs is refused up front.
+// -----------------------------------------------------------------------------
+void TestMemoryFallback()
+{
+  RunSettings settings;
+  settings.dims[0] = 64;
+  settings.dims[1] = 64;
+  settings.dims[2] = 40;
+  settings.nucleationRate = 0.0002f;
+  settings.engine = 2;
+  size_t numCells = settings.dims[0] * settings.dims[1] * settings.dims[2];
+  for(unsigned int nb = 0; nb < 6; nb++)
+  {
+    settings.neighborhood = nb;
+    settings.seed = 700 + nb;
+    settings.memoryLimit = 0.0;
+    RunResult reference = RunFilter(settings);
+    settings.memoryLimit = 10.0 * numCells / (1024.0 * 1024.0 * 1024.0);
+    RequireIdentical(reference, RunFilter(settings));
+  }
+
+  IFilterFactory::Pointer filterFactory = FilterManager::Instance()->getFactoryForFilter("RecrystalizeVolume");
+  AbstractFilter::Pointer filter = filterFactory->create();
+  IntVec3_t dimensions = { static_cast<int>(settings.dims[0]), static_cast<int>(settings.dims[1]), static_cast<int>(settings.dims[2]) };
+  QVariant var;
+  var.setValue(dimensions);
+  SetProperty(filter, "Dimensions", var);
+  SetProperty(filter, "MemoryLimit", 4.0 * numCells / (1024.0 * 1024.0 * 1024.0));
+  filter->setDataContainerArray(DataContainerArray::New());
+  filter->preflight();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), -5022)
+  DREAM3D_REQUIRE(!filter->property("EstimatedMemory").toString().isEmpty())
+  DREAM3D_REQUIRE(!filter->property("EstimatedRuntime").toString().isEmpty())
+
+  //non positive dimensions are refused before anything is estimated from them
+  filter = filterFactory->create();
+  dimensions.y = -64;
+  var.setValue(dimensions);
+  SetProperty(filter, "Dimensions", var);
+  filter->setDataContainerArray(DataContainerArray::New());
+  filter->preflight();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), -5001)
+  DREAM3D_REQUIRE(filter->property("EstimatedMemory").toString().isEmpty())
+  settings.dims[2] = 0;
+  RequireRejected(settings, -5002);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestGrainGrowth()
+{
+  const size_t lattices[][3] = { {48, 48, 32}, {128, 128, 1} };
+  for(size_t l = 0; l < 2; l++)
+  {
+    RunSettings settings;
+    std::copy(lattices[l], lattices[l] + 3, settings.dims);
+    settings.nucleationRate = 0.001f;
+    settings.neighborhood = 5;
+    settings.seed = 800 + l;
+    RunResult recrystallized = RunFilter(settings);
+    settings.grainGrowthSteps = 20;
+    RunResult grown = RunFilter(settings);
+
+    //the recrystallization outputs are unchanged
+    DREAM3D_REQUIRE(recrystallized.recrystallizationTime == grown.recrystallizationTime)
+    DREAM3D_REQUIRE(recrystallized.history == grown.history)
+    DREAM3D_REQUIRE(recrystallized.grainCounts == grown.grainCounts)
+
+    //the grains coarsen: less boundary and no new grains
+    CellularAutomata::Lattice lattice(settings.dims[0], settings.dims[1], settings.dims[2]);
+    DREAM3D_REQUIRE(CellularAutomata::BoundaryEnergy(lattice, &grown.featureIds[0]) < CellularAutomata::BoundaryEnergy(lattice, &recrystallized.featureIds[0]))
+    std::vector<int32_t> before = recrystallized.featureIds;
+    std::vector<int32_t> after = grown.featureIds;
+    std::sort(before.begin(), before.end());
+    before.erase(std::unique(before.begin(), before.end()), before.end());
+    std::sort(after.begin(), after.end());
+    after.erase(std::unique(after.begin(), after.end()), after.end());
+    DREAM3D_REQUIRE(std::includes(before.begin(), before.end(), after.begin(), after.end()))
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Neither the thread limit nor the blocks per task change the volume. The scaling study times 1, 2, 4 ... threads
+// before the simulation and leaves its outputs alone.
+// -----------------------------------------------------------------------------
+void TestThreads()
+{
+  RunSettings settings;
+  settings.dims[0] = 48;
+  settings.dims[1] = 40;
+  settings.dims[2] = 24;
+  settings.nucleationRate = 0.001f;
+  settings.neighborhood = 4;
+  settings.seed = 900;
+  RunResult reference = RunFilter(settings);
+  const int limits[][2] = { {1, 0}, {2, 0}, {0, 1}, {2, 3} };
+  for(size_t l = 0; l < 4; l++)
+  {
+    settings.maximumThreads = limits[l][0];
+    settings.taskGrainSize = limits[l][1];
+    RequireIdentical(reference, RunFilter(settings));
+  }
+
+  IFilterFactory::Pointer filterFactory = FilterManager::Instance()->getFactoryForFilter("RecrystalizeVolume");
+  AbstractFilter::Pointer filter = filterFactory->create();
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  IntVec3_t dimensions = { static_cast<int>(settings.dims[0]), static_cast<int>(settings.dims[1]), static_cast<int>(settings.dims[2]) };
+  FloatVec3_t resolution = { 1.0f, 1.0f, 1.0f };
+  QVariant var;
+  var.setValue(dimensions);
+  SetProperty(filter, "Dimensions", var);
+  var.setValue(resolution);
+  SetProperty(filter, "Resolution", var);
+  SetProperty(filter, "NucleationRate", settings.nucleationRate);
+  SetProperty(filter, "Neighborhood", settings.neighborhood);
+  SetProperty(filter, "FixedSeed", true);
+  SetProperty(filter, "Seed", settings.seed);
+  SetProperty(filter, "ScalingStudySteps", 5);
+  filter->setDataContainerArray(dca);
+  filter->execute();
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  FloatArrayType::Pointer study = GetOutputArray<FloatArrayType>(dca, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, "ScalingStudy");
+  DREAM3D_REQUIRE_EQUAL(study->getComponentDimensions().size(), 2)
+  DREAM3D_REQUIRE_EQUAL(study->getComponentDimensions()[1], CellularAutomata::ScalingColumns)
+  DREAM3D_REQUIRE_EQUAL(study->getValue(0), 1.0f)
+  DREAM3D_REQUIRE(study->getValue(1) > 0.0f)
+  DREAM3D_REQUIRE_EQUAL(study->getValue(2), 1.0f)
+  Int32ArrayType::Pointer ids = GetOutputArray<Int32ArrayType>(dca, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds);
+  DREAM3D_REQUIRE(reference.featureIds == std::vector<int32_t>(ids->getPointer(0), ids->getPointer(0) + ids->getSize()))
+}
+
+// -----------------------------------------------------------------------------
+// A metrics file doesn't change the result and ends with the metrics of the last step
+// -----------------------------------------------------------------------------
+void TestMetricsFile()
+{
+  RunSettings settings;
+  settings.dims[0] = 40;
+  settings.dims[1] = 32;
+  settings.dims[2] = 24;
+  settings.nucleationRate = 0.001f;
+  settings.seed = 950;
+  QString path = UnitTest::TestTempDir + "/RecrystalizeVolumeMetrics.prom";
+  for(int kineticsOnly = 0; kineticsOnly < 2; kineticsOnly++)
+  {
+    settings.kineticsOnly = 1 == kineticsOnly;
+    settings.metricsFile = "";
+    RunResult reference = RunFilter(settings);
+    settings.metricsFile = path;
+    RunResult measured = RunFilter(settings);
+    DREAM3D_REQUIRE(reference.featureIds == measured.featureIds)
+    DREAM3D_REQUIRE(reference.history == measured.history)
+
+    QFile file(path);
+    DREAM3D_REQUIRE(file.open(QIODevice::ReadOnly))
+    QByteArray written = file.readAll();
+    file.close();
+    DREAM3D_REQUIRE(written.contains("\nrecrystallization_fraction 1\n"))
+    DREAM3D_REQUIRE(written.contains("\nrecrystallization_finished 1\n"))
+    DREAM3D_REQUIRE(written.contains("\nrecrystallization_eta_seconds 0\n"))
+    DREAM3D_REQUIRE_EQUAL(written.contains("\nrecrystallization_grain_count "), !settings.kineticsOnly)
+#if REMOVE_TEST_FILES
+    QFile::remove(path);
+#endif
+  }
+}
+
+// -----------------------------------------------------------------------------
+// The compressed volume holds the final grain ids and recrystallization times
+// -----------------------------------------------------------------------------
+void TestCompressedVolumeFile()
+{
+  const size_t lattices[][3] = { {64, 48, 40}, {300, 200, 1} };
+  QString path = UnitTest::TestTempDir + "/RecrystalizeVolume.cavol";
+  for(size_t l = 0; l < 2; l++)
+  {
+    RunSettings settings;
+    std::copy(lattices[l], lattices[l] + 3, settings.dims);
+    settings.nucleationRate = 0.0005f;
+    settings.seed = 1000 + l;
+    settings.compressedVolumeFile = path;
+    RunResult result = RunFilter(settings);
+
+    CellularAutomata::CompressedVolumeReader reader(path);
+    DREAM3D_REQUIRE(reader.open().isEmpty())
+    std::vector<int32_t> ids(result.featureIds.size(), -1);
+    std::vector<uint32_t> times(result.recrystallizationTime.size(), 0);
+    DREAM3D_REQUIRE(reader.read(&ids[0], &times[0]))
+    DREAM3D_REQUIRE(ids == result.featureIds)
+    DREAM3D_REQUIRE(times == result.recrystallizationTime)
+#if REMOVE_TEST_FILES
+    QFile::remove(path);
+#endif
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Every sweep combination reproduces the Avrami parameters of a single run with its parameters and the same seed, also
+// when the memory limit only lets two lattices or one lattice run at once, with the serial engine and on a single slice
+// (planar kernel)
+// -----------------------------------------------------------------------------
+void TestParameterSweep()
+{
+  const float nucleationRates[] = { 0.0005f, 0.002f };
+  const unsigned int neighborhoods[2][3] = { { 0, 2, 5 }, { 0, 1, 6 } };
+  const size_t sliceDims[2][3] = { { 24, 20, 16 }, { 96, 80, 1 } };
+  RunSettings settings;
+  settings.seed = 1200;
+  for(int planar = 0; planar < 2; planar++)
+  {
+    std::copy(sliceDims[planar], sliceDims[planar] + 3, settings.dims);
+    size_t numCells = settings.dims[0] * settings.dims[1] * settings.dims[2];
+    for(int kineticsOnly = 0; kineticsOnly < 2; kineticsOnly++)
+    {
+      settings.kineticsOnly = (1 == kineticsOnly);
+      if(settings.kineticsOnly && 1 == planar) { continue; }
+      size_t bytesPerLattice = numCells * (settings.kineticsOnly ? 2 * sizeof(uint64_t) : 2 * sizeof(int32_t) + sizeof(uint32_t));
+      const double memoryLimits[] = { 0.0, 2.5 * bytesPerLattice / (1024.0 * 1024.0 * 1024.0), 1.5 * bytesPerLattice / (1024.0 * 1024.0 * 1024.0), 0.0 };
+      const unsigned int engines[] = { 0, 0, 1, 2 };
+      for(size_t m = 0; m < 4; m++)
+      {
+        IFilterFactory::Pointer filterFactory = FilterManager::Instance()->getFactoryForFilter("RecrystalizeVolume");
+        AbstractFilter::Pointer filter = filterFactory->create();
+        DataContainerArray::Pointer dca = DataContainerArray::New();
+        IntVec3_t dimensions = { static_cast<int>(settings.dims[0]), static_cast<int>(settings.dims[1]), static_cast<int>(settings.dims[2]) };
+        FloatVec3_t resolution = { 1.0f, 1.0f, 1.0f };
+        QVariant var;
+        var.setValue(dimensions);
+        SetProperty(filter, "Dimensions", var);
+        var.setValue(resolution);
+        SetProperty(filter, "Resolution", var);
+        SetProperty(filter, "ParameterSweep", true);
+        SetProperty(filter, "SweepNucleationRates", QString("0.0005, 0.002"));
+        SetProperty(filter, "SweepNeighborhoods", 1 == planar ? QString("0 1 6") : QString("0 2 5"));
+        SetProperty(filter, "KineticsOnly", settings.kineticsOnly);
+        SetProperty(filter, "FixedSeed", true);
+        SetProperty(filter, "Seed", settings.seed);
+        SetProperty(filter, "MemoryLimit", memoryLimits[m]);
+        SetProperty(filter, "Engine", engines[m]);
+        filter->setDataContainerArray(dca);
+        filter->execute();
+        DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+        FloatArrayType::Pointer avrami = GetOutputArray<FloatArrayType>(dca, "SweepResults", "AvaramiParameters");
+        DREAM3D_REQUIRE_EQUAL(avrami->getNumberOfTuples(), 6)
+        for(size_t c = 0; c < 6; c++)
+        {
+          settings.nucleationRate = nucleationRates[c / 3];
+          settings.neighborhood = neighborhoods[planar][c % 3];
+          RunResult single = RunFilter(settings);
+          DREAM3D_REQUIRE_EQUAL(avrami->getValue(2 * c), single.avrami[0])
+          DREAM3D_REQUIRE_EQUAL(avrami->getValue(2 * c + 1), single.avrami[1])
+        }
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// A run stopped at a time step and resumed from its checkpoint is identical to an uninterrupted run, checkpoints
+// are only resumed with the seed, mask and nucleation weights they were written with
+// -----------------------------------------------------------------------------
+void TestCheckpointResume()
+{
+  RunSettings settings;
+  settings.dims[0] = settings.dims[1] = settings.dims[2] = 32;
+  settings.nucleationRate = 0.001f;
+  size_t numCells = settings.dims[0] * settings.dims[1] * settings.dims[2];
+  std::vector<bool> mask(numCells, false);
+  std::vector<float> weights(numCells, 1.0f);
+  for(size_t i = 0; i < numCells; i++)
+  {
+    size_t x = i % settings.dims[0];
+    mask[i] = x < 30;
+    weights[i] = 1.0f + (x % 4);
+  }
+  std::vector<bool> otherMask(mask);
+  otherMask[0] = false;
+
+  QString path = UnitTest::TestTempDir + "/RecrystalizeVolume.ckpt";
+  for(int masked = 0; masked < 2; masked++)
+  {
+    settings.seed = 1300 + masked;
+    settings.mask = (1 == masked) ? &mask : NULL;
+    settings.weights = (1 == masked) ? &weights : NULL;
+    settings.checkpointInterval = 0;
+    settings.checkpointFile = "";
+    settings.resumeFromCheckpoint = false;
+    settings.maxTimeStep = 0;
+    RunResult reference = RunFilter(settings);
+
+    //stop part way, the checkpoint of the stop is resumed to the end
+    settings.checkpointInterval = 3;
+    settings.checkpointFile = path;
+    settings.maxTimeStep = 8;
+    RunResult stopped = RunFilter(settings);
+    DREAM3D_REQUIRE(stopped.history.size() < reference.history.size())
+    DREAM3D_REQUIRE(stopped.history.back() < 1.0f)
+    settings.checkpointInterval = 0;
+    settings.resumeFromCheckpoint = true;
+    settings.maxTimeStep = 0;
+    RequireIdentical(reference, RunFilter(settings));
+
+    //the checkpoint now holds the completed run
+    RunSettings mismatched(settings);
+    mismatched.seed = settings.seed + 1;
+    RequireRejected(mismatched, -4);
+    mismatched = settings;
+    mismatched.mask = (1 == masked) ? &otherMask : &mask;
+    RequireRejected(mismatched, -4);
+    mismatched = settings;
+    mismatched.weights = (1 == masked) ? NULL : &weights;
+    RequireRejected(mismatched, -4);
+#if REMOVE_TEST_FILES
+    QFile::remove(path);
+#endif
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Warm starting from a run cut back to a time step keeps the cells recrystallized by then and the history up to there.
+// The steps of the original run before its first nucleation aren't recorded, so the continuation only reproduces that
+// run when its first step nucleated; otherwise it is a different (but reproducible) continuation of the same state.
+// -----------------------------------------------------------------------------
+void TestWarmStart()
+{
+  RunSettings settings;
+  settings.dims[0] = settings.dims[1] = settings.dims[2] = 40;
+
+  //about 64 nuclei are expected in the first step
+  settings.nucleationRate = 0.001f;
+  for(unsigned int nb = 0; nb < 6; nb += 5)
+  {
+    settings.neighborhood = nb;
+    settings.seed = 1400 + nb;
+    settings.initialFeatureIds = NULL;
+    settings.initialRecrystallizationTime = NULL;
+    RunResult reference = RunFilter(settings);
+
+    settings.initialFeatureIds = &reference.featureIds;
+    settings.initialRecrystallizationTime = &reference.recrystallizationTime;
+    const int timeSteps[] = { 1, 4, static_cast<int>(reference.history.size()) / 2 };
+    for(size_t t = 0; t < 3; t++)
+    {
+      settings.warmStartTimeStep = timeSteps[t];
+      RequireIdentical(reference, RunFilter(settings));
+    }
+
+    //a completed volume has nothing left to continue
+    settings.warmStartTimeStep = 0;
+    RequireRejected(settings, -5);
+  }
+
+  //about 0.1 nuclei are expected per step, the first nucleus is preceded by empty steps
+  settings.nucleationRate = 2.0e-6f;
+  settings.neighborhood = 0;
+  settings.seed = 1410;
+  settings.initialFeatureIds = NULL;
+  settings.initialRecrystallizationTime = NULL;
+  RunResult reference = RunFilter(settings);
+  uint32_t cut = static_cast<uint32_t>(reference.history.size()) / 2;
+  settings.initialFeatureIds = &reference.featureIds;
+  settings.initialRecrystallizationTime = &reference.recrystallizationTime;
+  settings.warmStartTimeStep = static_cast<int>(cut);
+  RunResult continued = RunFilter(settings);
+  RequireIdentical(continued, RunFilter(settings));
+
+  DREAM3D_REQUIRE(continued.history.size() > cut + 1)
+  DREAM3D_REQUIRE(std::equal(reference.history.begin(), reference.history.begin() + cut + 1, continued.history.begin()))
+  DREAM3D_REQUIRE_EQUAL(continued.history.back(), 1.0f)
+  int32_t maxKept = 0;
+  std::vector<bool> kept(reference.featureIds.size() + 1, false);
+  for(size_t i = 0; i < reference.featureIds.size(); i++)
+  {
+    if(reference.recrystallizationTime[i] <= cut)
+    {
+      maxKept = std::max(maxKept, reference.featureIds[i]);
+      kept[reference.featureIds[i]] = true;
+    }
+  }
+  for(size_t i = 0; i < reference.featureIds.size(); i++)
+  {
+    if(reference.recrystallizationTime[i] <= cut)
+    {
+      DREAM3D_REQUIRE_EQUAL(continued.featureIds[i], reference.featureIds[i])
+      DREAM3D_REQUIRE_EQUAL(continued.recrystallizationTime[i], reference.recrystallizationTime[i])
+    }
+    else
+    {
+      //grown from a kept grain or a new grain numbered after them
+      int32_t id = continued.featureIds[i];
+      DREAM3D_REQUIRE(id > maxKept || (id > 0 && kept[id]))
+      DREAM3D_REQUIRE(continued.recrystallizationTime[i] > cut)
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// The first run stores its result in the cache and an identical run loads it from there, combinations the cache can't
+// reproduce are refused
+// -----------------------------------------------------------------------------
+void TestResultCache()
+{
+  RunSettings settings;
+  settings.dims[0] = settings.dims[1] = settings.dims[2] = 32;
+  settings.nucleationRate = 0.001f;
+  settings.seed = 1500;
+  RunResult reference = RunFilter(settings);
+
+  QString directory = UnitTest::TestTempDir + "/RecrystalizeVolumeCache";
+  const float resolution[3] = { 1.0f, 1.0f, 1.0f };
+  const float origin[3] = { 0.0f, 0.0f, 0.0f };
+  QString path = CellularAutomata::ResultCachePath(directory, settings.dims, resolution, origin, settings.nucleationRate, settings.neighborhood, settings.seed);
+  QFile::remove(path);
+  settings.resultCacheDirectory = directory;
+  RequireIdentical(reference, RunFilter(settings));
+  DREAM3D_REQUIRE(QFile::exists(path))
+  RequireIdentical(reference, RunFilter(settings));
+
+  //a hit really comes from the cache: the id of the first cell is changed in the stored result
+  {
+    QFile file(path);
+    DREAM3D_REQUIRE(file.open(QIODevice::ReadWrite))
+    CellularAutomata::CheckpointHeader header;
+    DREAM3D_REQUIRE_EQUAL(file.read(reinterpret_cast<char*>(&header), sizeof(header)), static_cast<qint64>(sizeof(header)))
+    const int32_t tampered = reference.featureIds[0] + 1;
+    DREAM3D_REQUIRE(file.seek(sizeof(header) + header.historyLength * sizeof(float) + CellularAutomata::CheckpointPadding(header.historyLength)))
+    DREAM3D_REQUIRE_EQUAL(file.write(reinterpret_cast<const char*>(&tampered), sizeof(tampered)), static_cast<qint64>(sizeof(tampered)))
+    file.close();
+    RunResult cached = RunFilter(settings);
+    DREAM3D_REQUIRE_EQUAL(cached.featureIds[0], tampered)
+    DREAM3D_REQUIRE(std::equal(reference.featureIds.begin() + 1, reference.featureIds.end(), cached.featureIds.begin() + 1))
+  }
+
+  //a different seed is a different entry
+  settings.seed = 1501;
+  RunResult other = RunFilter(settings);
+  DREAM3D_REQUIRE(reference.featureIds != other.featureIds)
+  QString otherPath = CellularAutomata::ResultCachePath(directory, settings.dims, resolution, origin, settings.nucleationRate, settings.neighborhood, settings.seed);
+  DREAM3D_REQUIRE(QFile::exists(otherPath))
+
+  //the cache only holds complete single simulations of a fixed seed from an empty volume
+  std::vector<bool> mask(reference.featureIds.size(), true);
+  std::vector<float> weights(reference.featureIds.size(), 1.0f);
+  RunSettings rejected(settings);
+  rejected.kineticsOnly = true;
+  RequireRejected(rejected, -5012);
+  rejected = settings;
+  rejected.maxTimeStep = 5;
+  RequireRejected(rejected, -5012);
+  rejected = settings;
+  rejected.initialFeatureIds = &reference.featureIds;
+  rejected.initialRecrystallizationTime = &reference.recrystallizationTime;
+  rejected.warmStartTimeStep = 4;
+  RequireRejected(rejected, -5012);
+  rejected = settings;
+  rejected.resumeFromCheckpoint = true;
+  rejected.checkpointFile = path;
+  RequireRejected(rejected, -5012);
+  rejected = settings;
+  rejected.weights = &weights;
+  RequireRejected(rejected, -5015);
+  rejected = settings;
+  rejected.mask = &mask;
+  RequireRejected(rejected, -5017);
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  AbstractFilter::Pointer filter = CreateFilter(settings, dca);
+  SetProperty(filter, "FixedSeed", false);
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), -5012)
+  filter = CreateFilter(settings, dca);
+  SetProperty(filter, "ResultCacheDirectory", QString(""));
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), -5012)
+
+#if REMOVE_TEST_FILES
+  QFile::remove(path);
+  QFile::remove(otherPath);
+  QDir().rmdir(directory);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// Replaying the frame file reconstructs the volume at every recorded step: the cells recrystallized up to the time step
+// of the frame with their final grain ids
+// -----------------------------------------------------------------------------
+void TestFrameReplay()
+{
+  RunSettings settings;
+  settings.dims[0] = settings.dims[1] = settings.dims[2] = 32;
+  settings.nucleationRate = 0.0005f;
+  size_t numCells = settings.dims[0] * settings.dims[1] * settings.dims[2];
+  std::vector<bool> mask(numCells, false);
+  for(size_t i = 0; i < numCells; i++)
+  { mask[i] = (i / settings.dims[0]) % settings.dims[1] < 24; }
+
+  QString path = UnitTest::TestTempDir + "/RecrystalizeVolume.frames";
+  const int frameIntervals[] = { 1, 3 };
+  for(int masked = 0; masked < 2; masked++)
+  {
+    for(size_t f = 0; f < 2; f++)
+    {
+      settings.seed = 1600 + 2 * masked + static_cast<int>(f);
+      settings.mask = (1 == masked) ? &mask : NULL;
+      settings.frameInterval = 0;
+      settings.frameFile = "";
+      RunResult reference = RunFilter(settings);
+      settings.frameInterval = frameIntervals[f];
+      settings.frameFile = path;
+      RunResult recorded = RunFilter(settings);
+      RequireIdentical(reference, recorded);
+
+      CellularAutomata::FrameReader reader(path);
+      DREAM3D_REQUIRE(reader.open().isEmpty())
+      DREAM3D_REQUIRE_EQUAL(reader.numberOfCells(), numCells)
+      std::vector<int32_t> ids(numCells, 0);
+      CellularAutomata::FrameHeader header;
+      uint64_t lastIteration = 0;
+      uint32_t lastTimeStep = 0;
+      size_t frames = 0;
+      while(reader.next(&ids[0], header))
+      {
+        DREAM3D_REQUIRE(header.iteration > lastIteration)
+        DREAM3D_REQUIRE(header.timeStep >= lastTimeStep)
+        //every time step is recorded when every step is
+        if(1 == settings.frameInterval)
+        { DREAM3D_REQUIRE(header.timeStep <= lastTimeStep + 1) }
+        for(size_t i = 0; i < numCells; i++)
+        {
+          int32_t expected = reference.recrystallizationTime[i] <= header.timeStep ? reference.featureIds[i] : 0;
+          DREAM3D_REQUIRE_EQUAL(ids[i], expected)
+        }
+        lastIteration = header.iteration;
+        lastTimeStep = header.timeStep;
+        frames++;
+      }
+      DREAM3D_REQUIRE(frames > 1)
+      DREAM3D_REQUIRE_EQUAL(lastTimeStep + 1, reference.history.size())
+      DREAM3D_REQUIRE(ids == reference.featureIds)
+#if REMOVE_TEST_FILES
+      QFile::remove(path);
+#endif
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Feature statistics of a hand-built volume (three box shaped grains, warm started with one unrecrystallized cell inside
+// the first) are the exact cell counts, volumes and centroids in physical coordinates, and those of a simulated volume
+// match the statistics of its FeatureIds
+// -----------------------------------------------------------------------------
+void TestFeatureStatistics()
+{
+  RunSettings settings;
+  settings.dims[0] = 8;
+  settings.dims[1] = 6;
+  settings.dims[2] = 4;
+  settings.nucleationRate = 1.0e-6f;//the hole is filled by growth long before anything nucleates
+  settings.seed = 1700;
+  size_t numCells = settings.dims[0] * settings.dims[1] * settings.dims[2];
+  std::vector<int32_t> ids(numCells, 0);
+  std::vector<uint32_t> times(numCells, 1);
+  for(size_t i = 0; i < numCells; i++)
+  {
+    size_t x = i % settings.dims[0];
+    size_t y = (i / settings.dims[0]) % settings.dims[1];
+    ids[i] = x < 4 ? 1 : (y < 3 ? 2 : 3);
+  }
+  size_t hole = (2 * settings.dims[1] + 2) * settings.dims[0] + 1;
+  ids[hole] = 0;
+  times[hole] = 0;
+  settings.initialFeatureIds = &ids;
+  settings.initialRecrystallizationTime = &times;
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  AbstractFilter::Pointer filter = CreateFilter(settings, dca);
+  FloatVec3_t resolution = { 0.5f, 1.0f, 2.0f };
+  FloatVec3_t origin = { 10.0f, 20.0f, 30.0f };
+  QVariant var;
+  var.setValue(resolution);
+  SetProperty(filter, "Resolution", var);
+  var.setValue(origin);
+  SetProperty(filter, "Origin", var);
+  SetProperty(filter, "FeatureStatistics", true);
+  filter->execute();
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  Int32ArrayType::Pointer featureIds = GetOutputArray<Int32ArrayType>(dca, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds);
+  DREAM3D_REQUIRE_EQUAL(featureIds->getValue(hole), 1)
+  Int32ArrayType::Pointer cellCounts = GetOutputArray<Int32ArrayType>(dca, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::NumCells);
+  FloatArrayType::Pointer volumes = GetOutputArray<FloatArrayType>(dca, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::Volumes);
+  FloatArrayType::Pointer centroids = GetOutputArray<FloatArrayType>(dca, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::Centroids);
+  DREAM3D_REQUIRE_EQUAL(cellCounts->getNumberOfTuples(), 4)
+  const int32_t expectedCells[] = { 0, 96, 48, 48 };
+  const float expectedCentroids[][3] = { {0.0f, 0.0f, 0.0f}, {11.0f, 23.0f, 34.0f}, {13.0f, 21.5f, 34.0f}, {13.0f, 24.5f, 34.0f} };
+  for(size_t f = 0; f < 4; f++)
+  {
+    DREAM3D_REQUIRE_EQUAL(cellCounts->getValue(f), expectedCells[f])
+    DREAM3D_REQUIRE_EQUAL(volumes->getValue(f), expectedCells[f] * 1.0f)
+    for(size_t j = 0; j < 3; j++)
+    { DREAM3D_REQUIRE(std::fabs(centroids->getValue(3 * f + j) - expectedCentroids[f][j]) <= 1.0e-5f) }
+  }
+
+  //a simulated volume (grains are assigned by several threads)
+  RunSettings simulated;
+  simulated.dims[0] = simulated.dims[1] = simulated.dims[2] = 32;
+  simulated.nucleationRate = 0.001f;
+  simulated.seed = 1701;
+  dca = DataContainerArray::New();
+  filter = CreateFilter(simulated, dca);
+  SetProperty(filter, "FeatureStatistics", true);
+  filter->execute();
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+  featureIds = GetOutputArray<Int32ArrayType>(dca, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds);
+  cellCounts = GetOutputArray<Int32ArrayType>(dca, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::NumCells);
+  volumes = GetOutputArray<FloatArrayType>(dca, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::Volumes);
+  centroids = GetOutputArray<FloatArrayType>(dca, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::Centroids);
+  size_t numFeatures = cellCounts->getNumberOfTuples();
+  std::vector<size_t> counts(numFeatures, 0);
+  std::vector<double> sums(3 * numFeatures, 0.0);
+  numCells = simulated.dims[0] * simulated.dims[1] * simulated.dims[2];
+  for(size_t i = 0; i < numCells; i++)
+  {
+    int32_t id = featureIds->getValue(i);
+    DREAM3D_REQUIRE(id > 0 && static_cast<size_t>(id) < numFeatures)
+    counts[id]++;
+    sums[3 * id] += i % simulated.dims[0];
+    sums[3 * id + 1] += (i / simulated.dims[0]) % simulated.dims[1];
+    sums[3 * id + 2] += i / (simulated.dims[0] * simulated.dims[1]);
+  }
+  for(size_t f = 1; f < numFeatures; f++)
+  {
+    DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(cellCounts->getValue(f)), counts[f])
+    DREAM3D_REQUIRE_EQUAL(volumes->getValue(f), static_cast<float>(counts[f]))
+    for(size_t j = 0; j < 3; j++)
+    { DREAM3D_REQUIRE(std::fabs(centroids->getValue(3 * f + j) - (sums[3 * f + j] / counts[f] + 0.5)) <= 1.0e-4) }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// InterfaceArea and GrainCount of a hand-built volume (warm started): grain 1 fills the planes x = 0, 1 at step 1 and
+// grain 2 nucleates in the plane x = 4 at step 2, the growth of every 3D neighborhood then fills all planes but x = 6 in
+// step 3 and the last plane in step 4
+// -----------------------------------------------------------------------------
+void TestInterfaceArea()
+{
+  RunSettings settings;
+  settings.dims[0] = 8;
+  settings.dims[1] = 6;
+  settings.dims[2] = 4;
+  settings.nucleationRate = 1.0e-6f;
+  size_t numCells = settings.dims[0] * settings.dims[1] * settings.dims[2];
+  std::vector<int32_t> ids(numCells, 0);
+  std::vector<uint32_t> times(numCells, 0);
+  for(size_t i = 0; i < numCells; i++)
+  {
+    size_t x = i % settings.dims[0];
+    if(x < 2) { ids[i] = 1; times[i] = 1; }
+    else if(4 == x) { ids[i] = 2; times[i] = 2; }
+  }
+  settings.initialFeatureIds = &ids;
+  settings.initialRecrystallizationTime = &times;
+
+  //faces normal to x are 1 x 2 with this resolution, each boundary plane has 6 x 4 of them
+  const float expectedHistory[] = { 0.0f, 0.25f, 0.375f, 0.875f, 1.0f };
+  const float expectedArea[] = { 0.0f, 96.0f, 192.0f, 96.0f, 0.0f };
+  const int32_t expectedGrains[] = { 0, 1, 2, 2, 2 };
+  for(unsigned int nb = 0; nb < 6; nb++)
+  {
+    settings.neighborhood = nb;
+    settings.seed = 1800 + nb;
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    AbstractFilter::Pointer filter = CreateFilter(settings, dca);
+    FloatVec3_t resolution = { 0.5f, 1.0f, 2.0f };
+    QVariant var;
+    var.setValue(resolution);
+    SetProperty(filter, "Resolution", var);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+    FloatArrayType::Pointer history = GetOutputArray<FloatArrayType>(dca, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, "RecrystallizationHistory");
+    FloatArrayType::Pointer area = GetOutputArray<FloatArrayType>(dca, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, "InterfaceArea");
+    Int32ArrayType::Pointer grains = GetOutputArray<Int32ArrayType>(dca, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, "GrainCount");
+    DREAM3D_REQUIRE_EQUAL(history->getSize(), 5)
+    DREAM3D_REQUIRE_EQUAL(area->getSize(), 5)
+    DREAM3D_REQUIRE_EQUAL(grains->getSize(), 5)
+    for(size_t t = 0; t < 5; t++)
+    {
+      DREAM3D_REQUIRE_EQUAL(history->getValue(t), expectedHistory[t])
+      DREAM3D_REQUIRE_EQUAL(area->getValue(t), expectedArea[t])
+      DREAM3D_REQUIRE_EQUAL(grains->getValue(t), expectedGrains[t])
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// A run that stopped after state is the reference run up to that state: the same history and grain counts and the cells
+// recrystallized by then
+// -----------------------------------------------------------------------------
+void RequireStoppedAt(const RunResult& reference, const RunResult& stopped, size_t state)
+{
+  DREAM3D_REQUIRE(state + 1 < reference.history.size())
+  DREAM3D_REQUIRE_EQUAL(stopped.history.size(), state + 1)
+  DREAM3D_REQUIRE(std::equal(stopped.history.begin(), stopped.history.end(), reference.history.begin()))
+  DREAM3D_REQUIRE_EQUAL(stopped.grainCounts.size(), state + 1)
+  DREAM3D_REQUIRE(std::equal(stopped.grainCounts.begin(), stopped.grainCounts.end(), reference.grainCounts.begin()))
+  for(size_t i = 0; i < reference.featureIds.size(); i++)
+  {
+    bool recrystallized = reference.recrystallizationTime[i] <= state;
+    DREAM3D_REQUIRE_EQUAL(stopped.featureIds[i], recrystallized ? reference.featureIds[i] : 0)
+    DREAM3D_REQUIRE_EQUAL(stopped.recrystallizationTime[i], recrystallized ? reference.recrystallizationTime[i] : 0)
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Every stop criterion halts the run after the state it is expected to: the first state at the target fraction, the
+// Maximum Time Steps state, the state where the Avrami fit of the reference history has been stable for 3 steps (and
+// some state before completion for the wall clock limit); Fill Remainder then completes the volume in one more step
+// -----------------------------------------------------------------------------
+void TestStopCriteria()
+{
+  RunSettings settings;
+  settings.dims[0] = settings.dims[1] = settings.dims[2] = 40;
+  settings.nucleationRate = 0.0002f;
+  settings.seed = 1900;
+  RunResult reference = RunFilter(settings);
+
+  settings.targetFraction = 0.5f;
+  size_t expected = 0;
+  while(reference.history[expected] < settings.targetFraction) { expected++; }
+  RequireStoppedAt(reference, RunFilter(settings), expected);
+
+  //the remainder takes the ids of the nearest grains in one more step
+  settings.fillRemainder = true;
+  RunResult filled = RunFilter(settings);
+  DREAM3D_REQUIRE_EQUAL(filled.history.size(), expected + 2)
+  DREAM3D_REQUIRE_EQUAL(filled.history.back(), 1.0f)
+  for(size_t i = 0; i < reference.featureIds.size(); i++)
+  {
+    if(reference.recrystallizationTime[i] <= expected)
+    { DREAM3D_REQUIRE_EQUAL(filled.featureIds[i], reference.featureIds[i]) }
+    else
+    {
+      DREAM3D_REQUIRE(filled.featureIds[i] > 0)
+      DREAM3D_REQUIRE_EQUAL(filled.recrystallizationTime[i], expected + 1)
+    }
+  }
+
+  //each filled cell has the grain of a face neighbor one step closer to the grains, measured across the periodic boundaries
+  CellularAutomata::Lattice lattice(settings.dims[0], settings.dims[1], settings.dims[2]);
+  std::vector<size_t> distance(reference.featureIds.size(), std::numeric_limits<size_t>::max());
+  std::vector<size_t> queue;
+  for(size_t i = 0; i < reference.featureIds.size(); i++)
+  {
+    if(reference.recrystallizationTime[i] <= expected)
+    {
+      distance[i] = 0;
+      queue.push_back(i);
+    }
+  }
+  size_t neighbors[6];
+  for(size_t head = 0; head < queue.size(); head++)
+  {
+    lattice.Neighbors<size_t>(queue[head], 6, neighbors);
+    for(size_t n = 0; n < 6; n++)
+    {
+      if(std::numeric_limits<size_t>::max() != distance[neighbors[n]]) { continue; }
+      distance[neighbors[n]] = distance[queue[head]] + 1;
+      queue.push_back(neighbors[n]);
+    }
+  }
+  for(size_t i = 0; i < reference.featureIds.size(); i++)
+  {
+    if(0 == distance[i]) { continue; }
+    lattice.Neighbors<size_t>(i, 6, neighbors);
+    bool closer = false;
+    for(size_t n = 0; n < 6; n++)
+    { closer = closer || (distance[neighbors[n]] + 1 == distance[i] && filled.featureIds[neighbors[n]] == filled.featureIds[i]); }
+    DREAM3D_REQUIRE(closer)
+  }
+  settings.fillRemainder = false;
+  settings.targetFraction = 1.0f;
+
+  settings.maxTimeStep = 5;
+  RequireStoppedAt(reference, RunFilter(settings), 5);
+  settings.maxTimeStep = 0;
+
+  //replay the reference history through a monitor that only checks convergence
+  settings.avramiTolerance = 0.05f;
+  CellularAutomata::StopCriteria criteria;
+  criteria.avramiTolerance = settings.avramiTolerance;
+  CellularAutomata::AvramiRegression regression;
+  CellularAutomata::StopMonitor monitor(criteria, regression);
+  CellularAutomata::StopReason reason = CellularAutomata::NotStopped;
+  for(expected = 1; expected < reference.history.size() && CellularAutomata::NotStopped == reason; expected++)
+  { reason = monitor.update(std::vector<float>(reference.history.begin(), reference.history.begin() + expected + 1)); }
+  DREAM3D_REQUIRE_EQUAL(reason, CellularAutomata::AvramiConverged)
+  RequireStoppedAt(reference, RunFilter(settings), expected - 1);
+  settings.avramiTolerance = 0.0f;
+
+  //where the wall clock stops a run depends on the machine, it has to be a consistent state before completion
+  RunSettings large(settings);
+  large.dims[0] = large.dims[1] = large.dims[2] = 96;
+  large.nucleationRate = 0.00002f;
+  RunResult unlimited = RunFilter(large);
+  large.wallClockLimit = 0.001;
+  RunResult limited = RunFilter(large);
+  RequireStoppedAt(unlimited, limited, limited.history.size() - 1);
+}
+
+// -----------------------------------------------------------------------------
+// Fill Remainder only reaches the cells connected to a grain through the mask: of a mask with two separate parts, the
+// part where nothing can nucleate (its nucleation weights are 0) is left unrecrystallized
+// -----------------------------------------------------------------------------
+void TestMaskedFill()
+{
+  RunSettings settings;
+  settings.dims[0] = 32;
+  settings.dims[1] = 24;
+  settings.dims[2] = 16;
+  settings.nucleationRate = 0.001f;
+  settings.seed = 2000;
+  size_t numCells = settings.dims[0] * settings.dims[1] * settings.dims[2];
+  std::vector<bool> mask(numCells, false);
+  std::vector<float> weights(numCells, 0.0f);
+  size_t grainless = 0;
+  size_t masked = 0;
+  for(size_t i = 0; i < numCells; i++)
+  {
+    //the parts are separated by planes outside the mask on both sides (the lattice is periodic)
+    size_t x = i % settings.dims[0];
+    mask[i] = (x >= 2 && x < 16) || (x >= 20 && x < 30);
+    weights[i] = x < 16 ? 1.0f : 0.0f;
+    if(mask[i]) { masked++; }
+    if(x >= 20 && x < 30) { grainless++; }
+  }
+  settings.mask = &mask;
+  settings.weights = &weights;
+  settings.targetFraction = 0.3f;
+  settings.fillRemainder = true;
+  RunResult result = RunFilter(settings);
+
+  size_t stop = result.history.size() - 2;
+  DREAM3D_REQUIRE(result.history[stop] >= settings.targetFraction)
+  DREAM3D_REQUIRE_EQUAL(result.history.back(), 1 - static_cast<float>(grainless) / masked)
+  for(size_t i = 0; i < numCells; i++)
+  {
+    size_t x = i % settings.dims[0];
+    if(mask[i] && x < 16)
+    {
+      DREAM3D_REQUIRE(result.featureIds[i] > 0)
+      DREAM3D_REQUIRE(result.recrystallizationTime[i] > 0 && result.recrystallizationTime[i] <= stop + 1)
+    }
+    else
+    {
+      DREAM3D_REQUIRE_EQUAL(result.featureIds[i], 0)
+      DREAM3D_REQUIRE_EQUAL(result.recrystallizationTime[i], 0)
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// The interface area of a slice counts the edges of the square cells whatever the neighborhood: for the three planar
+// neighborhoods it is the number of edges between recrystallized and unrecrystallized cells of each state, and a square
+// grain warm started on the slice has the same interface (its perimeter) for all of them
+// -----------------------------------------------------------------------------
+void TestSliceInterfaceArea()
+{
+  RunSettings settings;
+  settings.dims[0] = 60;
+  settings.dims[1] = 48;
+  settings.dims[2] = 1;
+  settings.nucleationRate = 0.002f;
+  size_t numCells = settings.dims[0] * settings.dims[1];
+  for(unsigned int nb = 6; nb < 9; nb++)
+  {
+    settings.neighborhood = nb;
+    settings.seed = 2100 + nb;
+    RunResult result = RunFilter(settings);
+    DREAM3D_REQUIRE_EQUAL(result.interfaceArea.size(), result.history.size())
+    for(size_t t = 0; t < result.history.size(); t++)
+    {
+      size_t edges = 0;
+      for(size_t i = 0; i < numCells; i++)
+      {
+        size_t x = i % settings.dims[0];
+        size_t y = i / settings.dims[0];
+        size_t neighbors[2] = { y * settings.dims[0] + (x + 1) % settings.dims[0], ((y + 1) % settings.dims[1]) * settings.dims[0] + x };
+        for(size_t d = 0; d < 2; d++)
+        {
+          bool recrystallized = 0 != result.featureIds[i] && result.recrystallizationTime[i] <= t;
+          bool neighborRecrystallized = 0 != result.featureIds[neighbors[d]] && result.recrystallizationTime[neighbors[d]] <= t;
+          if(recrystallized != neighborRecrystallized) { edges++; }
+        }
+      }
+      DREAM3D_REQUIRE_EQUAL(result.interfaceArea[t], static_cast<float>(edges))
+    }
+  }
+
+  //a 4 x 3 grain recrystallized at step 1, the last state of a warm start is counted by the kernel's first step
+  settings.nucleationRate = 1.0e-6f;
+  std::vector<int32_t> ids(numCells, 0);
+  std::vector<uint32_t> times(numCells, 0);
+  for(size_t i = 0; i < numCells; i++)
+  {
+    size_t x = i % settings.dims[0];
+    size_t y = i / settings.dims[0];
+    if(x >= 10 && x < 14 && y >= 20 && y < 23) { ids[i] = 1; times[i] = 1; }
+  }
+  settings.initialFeatureIds = &ids;
+  settings.initialRecrystallizationTime = &times;
+  for(unsigned int nb = 6; nb < 9; nb++)
+  {
+    settings.neighborhood = nb;
+    settings.seed = 2110 + nb;
+    RunResult result = RunFilter(settings);
+    DREAM3D_REQUIRE_EQUAL(result.interfaceArea[0], 0.0f)
+    DREAM3D_REQUIRE_EQUAL(result.interfaceArea[1], 14.0f)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("RecrystalizeVolumeValidationTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() )
+  DREAM3D_REGISTER_TEST( TestReproducible() )
+  DREAM3D_REGISTER_TEST( TestEngines() )
+  DREAM3D_REGISTER_TEST( TestMaskedKernel() )
+  DREAM3D_REGISTER_TEST( TestPlanarKernel() )
+  DREAM3D_REGISTER_TEST( TestMooreSlice() )
+  DREAM3D_REGISTER_TEST( TestBitSliced() )
+  DREAM3D_REGISTER_TEST( TestHeterogeneousNucleation() )
+  DREAM3D_REGISTER_TEST( TestDistributed() )
+  DREAM3D_REGISTER_TEST( TestMemoryFallback() )
+  DREAM3D_REGISTER_TEST( TestGrainGrowth() )
+  DREAM3D_REGISTER_TEST( TestThreads() )
+  DREAM3D_REGISTER_TEST( TestMetricsFile() )
+  DREAM3D_REGISTER_TEST( TestCompressedVolumeFile() )
+  DREAM3D_REGISTER_TEST( TestParameterSweep() )
+  DREAM3D_REGISTER_TEST( TestCheckpointResume() )
+  DREAM3D_REGISTER_TEST( TestWarmStart() )
+  DREAM3D_REGISTER_TEST( TestResultCache() )
+  DREAM3D_REGISTER_TEST( TestFrameReplay() )
+  DREAM3D_REGISTER_TEST( TestFeatureStatistics() )
+  DREAM3D_REGISTER_TEST( TestInterfaceArea() )
+  DREAM3D_REGISTER_TEST( TestStopCriteria() )
+  DREAM3D_REGISTER_TEST( TestMaskedFill() )
+  DREAM3D_REGISTER_TEST( TestSliceInterfaceArea() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,105 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+
+#include "UnitTestSupport.hpp"
+
+#include "CellularAutomataEngine.hpp"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+class CountCells
+{
+  public:
+    void count(std::vector<size_t>& cells)
+    {
+      for(size_t i = 0; i < cells.size(); i++) { cells[i] = i; }
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Scaling studies time 1, 2, 4 ... threads up to the limit inside arenas of that many threads
+// -----------------------------------------------------------------------------
+void TestScaling()
+{
+  const size_t limits[] = { 0, 1, 2, 6, 8 };
+  const size_t expected[][5] = { {1}, {1}, {1, 2}, {1, 2, 4, 6}, {1, 2, 4, 8} };
+  const size_t sizes[] = { 1, 1, 2, 4, 4 };
+  for(size_t l = 0; l < 5; l++)
+  {
+    std::vector<size_t> counts = CellularAutomata::ScalingThreadCounts(limits[l]);
+    DREAM3D_REQUIRE_EQUAL(counts.size(), sizes[l])
+    DREAM3D_REQUIRE(std::equal(counts.begin(), counts.end(), expected[l]))
+  }
+
+  CellularAutomata::ThreadArena arena(0);
+  DREAM3D_REQUIRE_EQUAL(arena.threads(), 1)
+  CountCells counter;
+  std::vector<size_t> cells(100, 0);
+  arena.execute(counter, &CountCells::count, cells);
+  DREAM3D_REQUIRE_EQUAL(cells[99], 99)
+
+  CellularAutomata::ScalingPoint base, point;
+  base.seconds = 8.0;
+  base.weakSeconds = 2.0;
+  point.threads = 4;
+  point.seconds = 4.0;
+  point.weakSeconds = 2.5;
+  DREAM3D_REQUIRE_EQUAL(point.speedup(base), 2.0)
+  DREAM3D_REQUIRE_EQUAL(point.efficiency(base), 0.5)
+  DREAM3D_REQUIRE_EQUAL(point.weakEfficiency(base), 0.8)
+  point.weakSeconds = -1.0;
+  DREAM3D_REQUIRE_EQUAL(point.weakEfficiency(base), 0.0)
+}
+
+// -----------------------------------------------------------------------------
+// A probing plan alternates parallel and serial steps for ProbeStepsPerStrategy steps each before it decides, unknown
+// neighborhood types are planned as the largest
+// -----------------------------------------------------------------------------
+void TestEngineProbe()
+{
+  CellularAutomata::EnginePlan plan = CellularAutomata::PlanEngine(CellularAutomata::AutoEngine, "3D", 200000, false, 4096, 0, 0.001f, 4);
+  DREAM3D_REQUIRE(plan.probe)
+  CellularAutomata::EngineProbe probe(plan);
+  for(size_t step = 0; step < 2 * CellularAutomata::ProbeStepsPerStrategy; step++)
+  {
+    DREAM3D_REQUIRE(plan.probe)
+    DREAM3D_REQUIRE_EQUAL(plan.parallel, 0 == step % 2)
+    probe.start();
+    DREAM3D_REQUIRE_EQUAL(probe.stop(), step + 1 == 2 * CellularAutomata::ProbeStepsPerStrategy)
+  }
+  DREAM3D_REQUIRE(!plan.probe)
+  DREAM3D_REQUIRE(!probe.stop())
+
+  DREAM3D_REQUIRE_EQUAL(CellularAutomata::EngineNeighborCount(5), 26)
+  DREAM3D_REQUIRE_EQUAL(CellularAutomata::EngineNeighborCount(6), 4)
+  DREAM3D_REQUIRE_EQUAL(CellularAutomata::EngineNeighborCount(-1), 26)
+  DREAM3D_REQUIRE_EQUAL(CellularAutomata::EngineNeighborCount(9), 26)
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("ScalingTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( TestScaling() )
+  DREAM3D_REGISTER_TEST( TestEngineProbe() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,174 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+
+#include "UnitTestSupport.hpp"
+
+#include "CellularAutomataHelpers.hpp"
+#include "CellularAutomataDomain.hpp"
+#include "CellularAutomataRandom.hpp"
+#include "CellularAutomataStepper.hpp"
+
+// -----------------------------------------------------------------------------
+//  rule of the stepper test: parent cells take the lowest id among their neighbors
+// -----------------------------------------------------------------------------
+struct LowestNeighborRule
+{
+  struct Reduction
+  {
+    Reduction() : parents(0), listed(0) {}
+    void merge(const Reduction& other) { parents += other.parents; listed += other.listed; }
+    size_t parents;
+    size_t listed;
+  };
+
+  const int32_t* current;
+  int32_t* next;
+
+  const int32_t* states() const { return current; }
+  void transformed(size_t index, CellularAutomata::VariateStream&, Reduction&) const { next[index] = current[index]; }
+
+  void isolated(size_t index, CellularAutomata::VariateStream&, Reduction& reduction) const
+  {
+    next[index] = 0;
+    reduction.parents++;
+  }
+
+  void update(size_t index, const size_t* neighbors, size_t count, CellularAutomata::VariateStream&, Reduction& reduction) const
+  {
+    int32_t id = 0;
+    for(size_t n = 0; n < count; n++)
+    {
+      int32_t neighbor = current[neighbors[n]];
+      if(0 != neighbor && (0 == id || neighbor < id)) { id = neighbor; }
+    }
+    next[index] = id;
+    reduction.listed += count;
+    if(0 == id) { reduction.parents++; }
+  }
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestStepper()
+{
+  const size_t lattices[][3] = { {20, 18, 12}, {37, 22, 1}, {9, 4, 6}, {16, 3, 1} };
+  for(size_t l = 0; l < sizeof(lattices) / sizeof(lattices[0]); l++)
+  {
+    CellularAutomata::Lattice lattice(lattices[l][0], lattices[l][1], lattices[l][2]);
+    size_t numCells = lattice.size();
+    std::vector<int32_t> states(numCells, 0);
+    CellularAutomata::VariateStream generator(l);
+    size_t transformed = 0;
+    for(size_t i = 0; i < numCells; i++)
+    {
+      if(0 == generator.below(30))
+      {
+        states[i] = static_cast<int32_t>(1 + generator.below(50));
+        transformed++;
+      }
+    }
+    bool* maskArray = new bool[numCells];
+    std::fill(maskArray, maskArray + numCells, true);
+    CellularAutomata::Domain domain(lattice, maskArray, 26);
+    CellularAutomata::Domain wideDomain(lattice, maskArray, 26, true);
+
+    for(int neighborhood = 0; neighborhood < 9; neighborhood++)
+    {
+      //the slice neighborhoods only run on single slices
+      if(neighborhood >= 6 && !lattice.Is2D()) { continue; }
+
+      //serial, parallel (1 block per task) and the 32 and 64 bit neighbor tables of a full mask give the same states
+      std::vector<int32_t> results[4];
+      for(size_t run = 0; run < 4; run++)
+      {
+        CellularAutomata::EnginePlan plan;
+        plan.parallel = 1 == run;
+        results[run].assign(numCells, -1);
+        LowestNeighborRule rule = { &states[0], &results[run][0] };
+        CellularAutomata::StepperBase<LowestNeighborRule>* stepper = CellularAutomata::NewStepper<LowestNeighborRule>(neighborhood, lattice, 2 == run ? &domain : 3 == run ? &wideDomain : NULL, plan);
+        DREAM3D_REQUIRE(NULL != stepper)
+        LowestNeighborRule::Reduction reduction = stepper->run(rule, CellularAutomata::StreamSeed(l, neighborhood), 0, numCells);
+        size_t remaining = std::count(results[run].begin(), results[run].end(), 0);
+        DREAM3D_REQUIRE_EQUAL(reduction.parents, remaining)
+
+        //every cell is visited once, cells out of reach are only skipped on unmasked lattices
+        const CellularAutomata::StepCounters& counters = stepper->last();
+        DREAM3D_REQUIRE_EQUAL(counters.cells(), numCells)
+        DREAM3D_REQUIRE_EQUAL(counters.transformed, transformed)
+        DREAM3D_REQUIRE(run < 2 || 0 == counters.isolated)
+        DREAM3D_REQUIRE_EQUAL(stepper->total().cells(), numCells)
+        delete stepper;
+      }
+      DREAM3D_REQUIRE(results[0] == results[1])
+      DREAM3D_REQUIRE(results[0] == results[2])
+      DREAM3D_REQUIRE(results[0] == results[3])
+
+      //neighborhoods without random variants match their neighbors from the lattice
+      if(1 == neighborhood || 2 == neighborhood || 4 == neighborhood) { continue; }
+      size_t moore[26];
+      size_t neighbors[26];
+      for(size_t i = 0; i < numCells; i++)
+      {
+        size_t count = 0;
+        lattice.Neighbors(i, 26, moore);
+        if(0 == neighborhood || 3 == neighborhood || 5 == neighborhood)
+        {
+          count = 0 == neighborhood ? 6 : (3 == neighborhood ? 18 : 26);
+          std::copy(moore, moore + count, neighbors);
+        }
+        else if(6 == neighborhood)
+        {
+          count = 4;
+          std::copy(moore, moore + count, neighbors);
+        }
+        else if(7 == neighborhood)
+        {
+          count = 8;
+          for(size_t n = 0; n < count; n++) { neighbors[n] = moore[CellularAutomata::SquareEightNeighbors[n]]; }
+        }
+        else
+        {
+          size_t x, y, z;
+          lattice.ToTuple(i, x, y, z);
+          count = 6;
+          for(size_t n = 0; n < count; n++) { neighbors[n] = moore[CellularAutomata::HexagonalNeighbors[y % 2][n]]; }
+        }
+        int32_t expected = states[i];
+        for(size_t n = 0; n < count && 0 == states[i]; n++)
+        {
+          int32_t neighbor = states[neighbors[n]];
+          if(0 != neighbor && (0 == expected || neighbor < expected)) { expected = neighbor; }
+        }
+        DREAM3D_REQUIRE_EQUAL(results[0][i], expected)
+      }
+    }
+    delete[] maskArray;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("StepperTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( TestStepper() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
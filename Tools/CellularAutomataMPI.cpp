@@ -0,0 +1,419 @@
+/*
+ * Your License or Copyright Information can go here
+ */
+
+/*
+ * Distributed recrystallization simulation for lattices that don't fit a single node. The lattice is split into
+ * contiguous slabs of cells (see CellularAutomata::SlabPartition), each process keeps its slab plus 2 planes of halo on
+ * each side and exchanges the halo with the processes owning those cells after every step. The unrecrystallized count
+ * and the ids of new grains come from collective reductions, so the result is identical to RecrystalizeVolume's for the
+ * same parameters and seed, whatever the number of processes.
+ *
+ * The result is written in parallel (MPI-IO) as a checkpoint file of RecrystalizeVolume, which the filter can resume
+ * (if the run stopped early) or load as a cached result (--cache-dir).
+ *
+ *   mpirun -np 4 CellularAutomataMPI --dimensions 512 512 512 --rate 0.0001 --neighborhood 5 --seed 42 --output rx.ckpt
+ */
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#include <mpi.h>
+
+#include <QtCore/QString>
+#include <QtCore/QFile>
+
+#include "CellularAutomataHelpers.hpp"
+#include "CellularAutomataRandom.hpp"
+#include "CellularAutomataCheckpoint.hpp"
+#include "CellularAutomataResultCache.hpp"
+#include "CellularAutomataKinetics.hpp"
+#include "CellularAutomataDistributed.hpp"
+
+namespace
+{
+  struct Options
+  {
+    Options() : rate(0.001f), neighborhood(0), seed(0), checkpointInterval(0)
+    {
+      for(size_t i = 0; i < 3; i++)
+      {
+        dims[i] = 0;
+        resolution[i] = 1.0f;
+        origin[i] = 0.0f;
+      }
+    }
+
+    size_t dims[3];
+    float resolution[3];
+    float origin[3];
+    float rate;
+    int neighborhood;
+    uint64_t seed;
+    QString output;
+    QString cacheDirectory;
+    QString resume;
+    uint64_t checkpointInterval;
+    CellularAutomata::StopCriteria stop;
+  };
+
+  //bytes per MPI-IO call (counts are ints)
+  const size_t MaxIOBytes = static_cast<size_t>(1) << 30;
+
+  void PrintUsage()
+  {
+    std::printf("usage: CellularAutomataMPI --dimensions X Y Z [--resolution X Y Z] [--origin X Y Z] [--rate R] [--neighborhood 0-5]\n"
+                "                          [--seed S] (--output FILE | --cache-dir DIRECTORY) [--resume FILE]\n"
+                "                          [--checkpoint-interval STEPS] [--target-fraction F] [--max-steps N] [--wall-clock SECONDS]\n");
+  }
+
+  //parses the command line, returns an error message (empty on success)
+  QString ParseOptions(int argc, char** argv, Options& options)
+  {
+    for(int i = 1; i < argc; i++)
+    {
+      QString arg = QString::fromLocal8Bit(argv[i]);
+      int values = ("--dimensions" == arg || "--resolution" == arg || "--origin" == arg) ? 3 : 1;
+      if(i + values >= argc)
+        return QString("Missing value for %1").arg(arg);
+      bool ok = true;
+      if("--dimensions" == arg)
+      {
+        for(int j = 0; j < 3 && ok; j++)
+          options.dims[j] = QString(argv[++i]).toULongLong(&ok);
+      }
+      else if("--resolution" == arg)
+      {
+        for(int j = 0; j < 3 && ok; j++)
+          options.resolution[j] = QString(argv[++i]).toFloat(&ok);
+      }
+      else if("--origin" == arg)
+      {
+        for(int j = 0; j < 3 && ok; j++)
+          options.origin[j] = QString(argv[++i]).toFloat(&ok);
+      }
+      else if("--rate" == arg)
+        options.rate = QString(argv[++i]).toFloat(&ok);
+      else if("--neighborhood" == arg)
+        options.neighborhood = QString(argv[++i]).toInt(&ok);
+      else if("--seed" == arg)
+        options.seed = static_cast<uint64_t>(QString(argv[++i]).toUInt(&ok));
+      else if("--output" == arg)
+        options.output = QString::fromLocal8Bit(argv[++i]);
+      else if("--cache-dir" == arg)
+        options.cacheDirectory = QString::fromLocal8Bit(argv[++i]);
+      else if("--resume" == arg)
+        options.resume = QString::fromLocal8Bit(argv[++i]);
+      else if("--checkpoint-interval" == arg)
+        options.checkpointInterval = QString(argv[++i]).toULongLong(&ok);
+      else if("--target-fraction" == arg)
+        options.stop.targetFraction = QString(argv[++i]).toFloat(&ok);
+      else if("--max-steps" == arg)
+        options.stop.maxTimeStep = QString(argv[++i]).toUInt(&ok);
+      else if("--wall-clock" == arg)
+        options.stop.wallClockLimit = QString(argv[++i]).toDouble(&ok);
+      else
+        return QString("Unknown option %1").arg(arg);
+      if(!ok)
+        return QString("Invalid value for %1").arg(arg);
+    }
+
+    if(0 == options.dims[0] || 0 == options.dims[1] || 0 == options.dims[2])
+      return QString("The dimensions must be > 0");
+    if(1 == options.dims[2])
+      return QString("Single slices are simulated by the RecrystalizeVolume filter (the z dimension must be > 1)");
+    if(options.neighborhood < 0 || options.neighborhood > 5)
+      return QString("The neighborhood must be one of the 3D neighborhoods (0 - 5)");
+    if(options.rate < 0.0f)
+      return QString("The nucleation rate must be >= 0");
+    if(options.output.isEmpty() && options.cacheDirectory.isEmpty())
+      return QString("Either --output or --cache-dir is required");
+    if(options.dims[0] * options.dims[1] > static_cast<size_t>(0x7FFFFFFF))
+      return QString("A z plane must have fewer than 2^31 cells");
+    return QString();
+  }
+
+  //sends the halo cells this process owns and receives the halo it keeps
+  void ExchangeHalos(CellularAutomata::Slab& slab, const std::vector<CellularAutomata::HaloTransfer>& transfers, size_t rank)
+  {
+    std::vector<MPI_Request> requests;
+    for(std::vector<CellularAutomata::HaloTransfer>::const_iterator iter = transfers.begin(); iter != transfers.end(); ++iter)
+    {
+      int count = static_cast<int>(iter->end - iter->begin);
+      int32_t* cells = slab.ids() + (rank == iter->to || rank == iter->from ? slab.windowIndex(iter->begin) : 0);
+      MPI_Request request;
+      if(rank == iter->to)
+        MPI_Irecv(cells, count, MPI_INT, static_cast<int>(iter->from), 0, MPI_COMM_WORLD, &request);
+      else if(rank == iter->from)
+        MPI_Isend(cells, count, MPI_INT, static_cast<int>(iter->to), 0, MPI_COMM_WORLD, &request);
+      else
+        continue;
+      requests.push_back(request);
+    }
+    if(!requests.empty())
+      MPI_Waitall(static_cast<int>(requests.size()), &requests[0], MPI_STATUSES_IGNORE);
+  }
+
+  bool WriteAt(MPI_File file, MPI_Offset offset, const void* data, size_t bytes)
+  {
+    const char* buffer = static_cast<const char*>(data);
+    for(size_t done = 0; done < bytes; done += MaxIOBytes)
+    {
+      int count = static_cast<int>(std::min(MaxIOBytes, bytes - done));
+      if(MPI_SUCCESS != MPI_File_write_at(file, offset + static_cast<MPI_Offset>(done), buffer + done, count, MPI_BYTE, MPI_STATUS_IGNORE))
+        return false;
+    }
+    return true;
+  }
+
+  bool ReadAt(MPI_File file, MPI_Offset offset, void* data, size_t bytes)
+  {
+    char* buffer = static_cast<char*>(data);
+    for(size_t done = 0; done < bytes; done += MaxIOBytes)
+    {
+      int count = static_cast<int>(std::min(MaxIOBytes, bytes - done));
+      if(MPI_SUCCESS != MPI_File_read_at(file, offset + static_cast<MPI_Offset>(done), buffer + done, count, MPI_BYTE, MPI_STATUS_IGNORE))
+        return false;
+    }
+    return true;
+  }
+
+  //true on every process if ok is true on all of them
+  bool AllSucceeded(bool ok)
+  {
+    int local = ok ? 1 : 0;
+    int all = 0;
+    MPI_Allreduce(&local, &all, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    return 1 == all;
+  }
+
+  /*
+   * Writes the state as a checkpoint file (see CellularAutomata::CheckpointHeader): the first process writes the header
+   * and history, every process its own cells. The file is written next to path and renamed once complete.
+   */
+  bool WriteCheckpoint(const QString& path, const CellularAutomata::CheckpointHeader& header, const CellularAutomata::SimulationState& state,
+                       CellularAutomata::Slab& slab, size_t numCells, size_t rank)
+  {
+    QString temporary = path + ".partial";
+    QByteArray name = temporary.toLocal8Bit();
+    MPI_File file;
+    if(!AllSucceeded(MPI_SUCCESS == MPI_File_open(MPI_COMM_WORLD, name.data(), MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &file)))
+      return false;
+
+    size_t cellOffset = sizeof(header) + state.history.size() * sizeof(float) + CellularAutomata::CheckpointPadding(state.history.size());
+    bool ok = MPI_SUCCESS == MPI_File_set_size(file, static_cast<MPI_Offset>(cellOffset + numCells * 8));
+    if(0 == rank)
+    {
+      CellularAutomata::CheckpointHeader stateHeader = header;
+      stateHeader.timeStep = state.timeStep;
+      stateHeader.seed = state.seed;
+      stateHeader.iteration = state.iteration;
+      stateHeader.grainCount = state.grainCount;
+      stateHeader.historyLength = state.history.size();
+      const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+      ok = ok && WriteAt(file, 0, &stateHeader, sizeof(stateHeader))
+           && WriteAt(file, sizeof(stateHeader), state.history.data(), state.history.size() * sizeof(float))
+           && WriteAt(file, sizeof(stateHeader) + state.history.size() * sizeof(float), padding, CellularAutomata::CheckpointPadding(state.history.size()));
+    }
+    size_t ownCells = slab.end() - slab.begin();
+    ok = ok && WriteAt(file, static_cast<MPI_Offset>(cellOffset + slab.begin() * 4), slab.ownIds(), ownCells * 4)
+         && WriteAt(file, static_cast<MPI_Offset>(cellOffset + (numCells + slab.begin()) * 4), slab.times(), ownCells * 4);
+    MPI_File_close(&file);
+    if(!AllSucceeded(ok))
+      return false;
+
+    //replace the previous file only once every process has written its part
+    if(0 == rank)
+    {
+      QFile::remove(path);
+      ok = QFile::rename(temporary, path);
+    }
+    return AllSucceeded(ok);
+  }
+
+  //reads a checkpoint: header + history on every process, the window's planes and own times on each, returns an error message (empty on success)
+  QString ReadCheckpoint(const QString& path, const CellularAutomata::CheckpointKey& key, CellularAutomata::SimulationState& state,
+                         CellularAutomata::Slab& slab, size_t numCells, size_t rank)
+  {
+    QByteArray name = path.toLocal8Bit();
+    MPI_File file;
+    if(!AllSucceeded(MPI_SUCCESS == MPI_File_open(MPI_COMM_WORLD, name.data(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file)))
+      return QString("Unable to open checkpoint file '%1'").arg(path);
+
+    CellularAutomata::CheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    QString error;
+    if(0 == rank)
+    {
+      if(!ReadAt(file, 0, &header, sizeof(header)))
+        error = QString("'%1' is not a checkpoint file").arg(path);
+      else
+        error = CellularAutomata::CheckCheckpointHeader(header, path, key);
+    }
+    if(!AllSucceeded(error.isEmpty()))
+    {
+      MPI_File_close(&file);
+      return error.isEmpty() ? QString("Unable to read checkpoint file '%1'").arg(path) : error;
+    }
+    MPI_Bcast(&header, sizeof(header), MPI_BYTE, 0, MPI_COMM_WORLD);
+
+    state.seed = header.seed;
+    state.iteration = header.iteration;
+    state.timeStep = header.timeStep;
+    state.grainCount = static_cast<int32_t>(header.grainCount);
+    state.history.resize(header.historyLength);
+    bool ok = ReadAt(file, sizeof(header), state.history.data(), state.history.size() * sizeof(float));
+
+    //the window's planes (wrapping around z) and the own recrystallization times
+    size_t cellOffset = sizeof(header) + state.history.size() * sizeof(float) + CellularAutomata::CheckpointPadding(state.history.size());
+    size_t planeSize = key.dims[0] * key.dims[1];
+    for(size_t k = 0; k < slab.planeCount() && ok; k++)
+    {
+      size_t plane = (slab.firstPlane() + k) % key.dims[2];
+      ok = ReadAt(file, static_cast<MPI_Offset>(cellOffset + plane * planeSize * 4), slab.ids() + k * planeSize, planeSize * 4);
+    }
+    ok = ok && ReadAt(file, static_cast<MPI_Offset>(cellOffset + (numCells + slab.begin()) * 4), slab.times(), (slab.end() - slab.begin()) * 4);
+    MPI_File_close(&file);
+    if(!AllSucceeded(ok))
+      return QString("Checkpoint file '%1' is truncated").arg(path);
+    return QString();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  MPI_Init(&argc, &argv);
+  int rankValue, sizeValue;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rankValue);
+  MPI_Comm_size(MPI_COMM_WORLD, &sizeValue);
+  const size_t rank = static_cast<size_t>(rankValue);
+  const size_t processes = static_cast<size_t>(sizeValue);
+
+  Options options;
+  QString error = ParseOptions(argc, argv, options);
+  if(!error.isEmpty())
+  {
+    if(0 == rank)
+    {
+      std::fprintf(stderr, "%s\n", error.toLocal8Bit().constData());
+      PrintUsage();
+    }
+    MPI_Finalize();
+    return EXIT_FAILURE;
+  }
+
+  //same probability (in float) as RecrystalizeVolume
+  float pNuc = options.rate * options.resolution[0] * options.resolution[1] * options.resolution[2];
+  CellularAutomata::Lattice lattice(options.dims[0], options.dims[1], options.dims[2]);
+  size_t numCells = lattice.size();
+  CellularAutomata::SlabPartition partition(lattice, processes);
+  CellularAutomata::Slab slab(partition, rank, options.neighborhood);
+  std::vector<CellularAutomata::HaloTransfer> transfers = partition.transfers();
+  //the seed is always given (0 by default), checkpoints are only resumed with the same one
+  CellularAutomata::CheckpointKey key(options.dims, options.neighborhood, pNuc);
+  key.fixedSeed = true;
+  key.seed = options.seed;
+  CellularAutomata::CheckpointHeader header = CellularAutomata::MakeCheckpointHeader(key);
+
+  //start from scratch or continue from a checkpoint (of this tool or the filter)
+  CellularAutomata::SimulationState state;
+  state.seed = options.seed;
+  state.history.assign(1, 0.0f);
+  if(!options.resume.isEmpty())
+  {
+    error = ReadCheckpoint(options.resume, key, state, slab, numCells, rank);
+    if(!error.isEmpty())
+    {
+      if(0 == rank)
+        std::fprintf(stderr, "%s\n", error.toLocal8Bit().constData());
+      MPI_Finalize();
+      return EXIT_FAILURE;
+    }
+    if(0 == rank)
+      std::printf("Resuming from step %llu\n", static_cast<unsigned long long>(state.iteration));
+  }
+  if(0 == rank)
+  {
+    std::printf("%llu x %llu x %llu cells on %llu processes (%llu planes + halo on the first)\n", static_cast<unsigned long long>(options.dims[0]),
+                static_cast<unsigned long long>(options.dims[1]), static_cast<unsigned long long>(options.dims[2]), static_cast<unsigned long long>(processes),
+                static_cast<unsigned long long>(slab.planeCount()));
+  }
+
+  //continue time stepping until all cells are recrystallized (or a stop criterion is met)
+  uint64_t threshold = CellularAutomata::ProbabilityThreshold(pNuc);
+  CellularAutomata::AvramiRegression regression;
+  CellularAutomata::StopMonitor monitor(options.stop, regression);
+  int reason = CellularAutomata::NotStopped;
+  while(CellularAutomata::NotStopped == reason)
+  {
+    uint64_t stepSeed = CellularAutomata::StreamSeed(state.seed, state.iteration);
+    unsigned long long local[2] = { slab.step(stepSeed, threshold, state.timeStep), 0 };
+    local[1] = slab.nuclei();
+
+    //grains are numbered in index order: the nuclei of lower ranks come first
+    unsigned long long before[2] = { 0, 0 };
+    unsigned long long total[2] = { 0, 0 };
+    MPI_Exscan(local, before, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(local, total, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+    if(0 == rank)
+      before[1] = 0;
+    slab.commit(state.grainCount + 1 + static_cast<int32_t>(before[1]));
+    state.grainCount += static_cast<int32_t>(total[1]);
+    state.iteration++;
+    ExchangeHalos(slab, transfers, rank);
+
+    float percent = 1 - (static_cast<float>(total[0]) / numCells);
+    if(percent > 0)
+    {
+      state.timeStep++;
+      state.history.push_back(percent);
+    }
+
+    //every process sees the same history, only the wall clock limit could differ so the first process decides
+    reason = 0 == total[0] ? CellularAutomata::Completed : monitor.update(state.history);
+    MPI_Bcast(&reason, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+    if(0 == rank)
+    {
+      double k, n;
+      if(regression.fit(k, n))
+        std::printf("step %llu: %g%% recrystallized, %d grains (K = %g, n = %g)\n", static_cast<unsigned long long>(state.iteration), 100.0 * percent, state.grainCount, k, n);
+      else
+        std::printf("step %llu: %g%% recrystallized, %d grains\n", static_cast<unsigned long long>(state.iteration), 100.0 * percent, state.grainCount);
+      std::fflush(stdout);
+    }
+
+    if(!options.output.isEmpty() && 0 != options.checkpointInterval && CellularAutomata::NotStopped == reason && 0 == state.iteration % options.checkpointInterval)
+    {
+      if(!WriteCheckpoint(options.output, header, state, slab, numCells, rank) && 0 == rank)
+        std::fprintf(stderr, "Unable to write checkpoint file '%s'\n", options.output.toLocal8Bit().constData());
+    }
+  }
+
+  //the final state (a completed run can also be stored as the filter's cached result)
+  bool ok = true;
+  if(!options.output.isEmpty())
+    ok = WriteCheckpoint(options.output, header, state, slab, numCells, rank);
+  if(!options.cacheDirectory.isEmpty())
+  {
+    if(CellularAutomata::Completed == reason)
+    {
+      QString path = CellularAutomata::ResultCachePath(options.cacheDirectory, options.dims, options.resolution, options.origin, options.rate, options.neighborhood, state.seed);
+      ok = WriteCheckpoint(path, header, state, slab, numCells, rank) && ok;
+    }
+    else if(0 == rank)
+      std::fprintf(stderr, "Only completed simulations are stored in the result cache\n");
+  }
+  if(!ok && 0 == rank)
+    std::fprintf(stderr, "Unable to write the result\n");
+
+  MPI_Finalize();
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}